@@ -20,6 +20,10 @@ if (NOT BUILD_ALLOCATOR)
     add_definitions(-DCUSTOM_ALLOCATOR_DISABLED)
 endif()
 
+if (BUILD_MEMORY_ACCOUNTING)
+    add_definitions(-DMEMORY_ACCOUNTING_ENABLED)
+endif()
+
 if (CC_IS_GCC)
     message(STATUS "Using Compiler GCC ${CMAKE_CXX_COMPILER_VERSION}")
 
@@ -37,6 +37,9 @@
 #include "view/dockwindow/docksetup.h"
 
 #include "modularity/ioc.h"
+#include "io/file.h"
+#include "memoryaccounting.h"
+#include "editlatencyprobe.h"
 #include "ui/internal/uiengine.h"
 #include "version.h"
 
@@ -152,6 +155,22 @@ int AppShell::run(int argc, char** argv)
         m->onPreInit(runMode);
     }
 
+    //! NOTE After onPreInit, because the global module sets up the profiler there
+    const QString timelinePath = commandLine.diagnostic().timelinePath;
+    if (!timelinePath.isEmpty()) {
+        haw::profiler::Profiler::instance()->setTimelineEnabled(true);
+    }
+
+    const QString memoryReportPath = commandLine.diagnostic().memoryReportPath;
+    if (!memoryReportPath.isEmpty() && !MemoryAccounting::enabled()) {
+        LOGW() << "memory accounting is disabled, build with BUILD_MEMORY_ACCOUNTING to get a memory report";
+    }
+
+    const QString editLatencyPath = commandLine.diagnostic().editLatencyPath;
+    if (!editLatencyPath.isEmpty()) {
+        EditLatencyProbe::instance()->setEnabled(true);
+    }
+
     SplashScreen* splashScreen = nullptr;
     if (runMode == framework::IApplication::RunMode::Editor) {
         splashScreen = new SplashScreen();
@@ -289,6 +308,25 @@ int AppShell::run(int argc, char** argv)
 
     PROFILER_PRINT;
 
+    if (!timelinePath.isEmpty()) {
+        PROFILER_SAVE_TIMELINE(timelinePath.toStdString());
+    }
+
+    if (!memoryReportPath.isEmpty()) {
+        MemoryAccounting::Snapshot memorySnapshot = MemoryAccounting::snapshot();
+        LOGI() << MemoryAccounting::printableReport(memorySnapshot);
+
+        Ret ret = io::File::writeFile(memoryReportPath, MemoryAccounting::jsonReport(memorySnapshot));
+        if (!ret) {
+            LOGE() << "failed save memory report: " << memoryReportPath << ", err: " << ret.toString();
+        }
+    }
+
+    if (!editLatencyPath.isEmpty()) {
+        LOGI() << EditLatencyProbe::instance()->printableReport();
+        EditLatencyProbe::instance()->saveReport(editLatencyPath);
+    }
+
     // Wait Thread Poll
 #ifndef Q_OS_WASM
     QThreadPool* globalThreadPool = QThreadPool::globalInstance();
@@ -358,6 +396,9 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
     case CommandLineController::ConvertType::ExportScoreVideo: {
         ret = converter()->exportScoreVideo(task.inputFile, task.outputFile);
     } break;
+    case CommandLineController::ConvertType::ExportThumbnails:
+        ret = converter()->exportThumbnails(task.inputFile, task.outputFile, stylePath, forceMode);
+        break;
     case CommandLineController::ConvertType::SourceUpdate: {
         std::string scoreSource = task.params[CommandLineController::ParamKey::ScoreSource].toString().toStdString();
         ret = converter()->updateSource(task.inputFile, scoreSource, forceMode);
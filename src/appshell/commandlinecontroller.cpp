@@ -73,6 +73,7 @@ void CommandLineController::parse(const QStringList& args)
                                           "Transpose the given score and export the data to a single JSON file, print it to stdout",
                                           "options"));
     m_parser.addOption(QCommandLineOption("source-update", "Update the source in the given score"));
+    m_parser.addOption(QCommandLineOption("thumbnails", "Generate png thumbnails for all scores in the given directory, keeping its sub-directories", "out-dir"));
 
     m_parser.addOption(QCommandLineOption({ "S", "style" }, "Load style file", "style"));
 
@@ -99,6 +100,12 @@ void CommandLineController::parse(const QStringList& args)
     // Diagnostic
     m_parser.addOption(QCommandLineOption("diagnostic-output", "Diagnostic output", "output"));
     m_parser.addOption(QCommandLineOption("diagnostic-gendrawdata", "Generate engraving draw data", "scores-dir"));
+    m_parser.addOption(QCommandLineOption("diagnostic-timeline",
+                                          "Record a timeline of the traced functions and save it on exit in Chrome trace format", "file"));
+    m_parser.addOption(QCommandLineOption("diagnostic-memory",
+                                          "Save the memory accounting report on exit (requires BUILD_MEMORY_ACCOUNTING)", "file"));
+    m_parser.addOption(QCommandLineOption("diagnostic-edit-latency",
+                                          "Measure the latency of edits and save the report on exit", "file"));
 
     m_parser.process(args);
 }
@@ -254,6 +261,13 @@ void CommandLineController::apply()
         m_converterTask.params[CommandLineController::ParamKey::ScoreTransposeOptions] = m_parser.value("score-transpose");
     }
 
+    if (m_parser.isSet("thumbnails")) {
+        application()->setRunMode(IApplication::RunMode::Converter);
+        m_converterTask.type = ConvertType::ExportThumbnails;
+        m_converterTask.inputFile = scorefiles[0];
+        m_converterTask.outputFile = m_parser.value("thumbnails");
+    }
+
     if (m_parser.isSet("source-update")) {
         QStringList args = m_parser.positionalArguments();
 
@@ -385,6 +399,18 @@ void CommandLineController::apply()
         m_diagnostic.input = m_parser.value("diagnostic-gendrawdata");
     }
 
+    if (m_parser.isSet("diagnostic-timeline")) {
+        m_diagnostic.timelinePath = m_parser.value("diagnostic-timeline");
+    }
+
+    if (m_parser.isSet("diagnostic-memory")) {
+        m_diagnostic.memoryReportPath = m_parser.value("diagnostic-memory");
+    }
+
+    if (m_parser.isSet("diagnostic-edit-latency")) {
+        m_diagnostic.editLatencyPath = m_parser.value("diagnostic-edit-latency");
+    }
+
     // Startup
     if (application()->runMode() == IApplication::RunMode::Editor) {
         startupScenario()->setModeType(modeType);
@@ -66,7 +66,8 @@ public:
         ExportScorePartsPdf,
         ExportScoreTranspose,
         SourceUpdate,
-        ExportScoreVideo
+        ExportScoreVideo,
+        ExportThumbnails
     };
 
     enum class ParamKey {
@@ -97,6 +98,9 @@ public:
         DiagnosticType type = DiagnosticType::Undefined;
         QString input;
         QString output;
+        QString timelinePath;
+        QString memoryReportPath;
+        QString editLatencyPath;
     };
 
     void parse(const QStringList& args);
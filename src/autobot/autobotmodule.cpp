@@ -48,6 +48,7 @@
 #include "internal/api/interactiveapi.h"
 #include "internal/api/keyboardapi.h"
 #include "internal/api/accessibilityapi.h"
+#include "internal/api/diagnosticsapi.h"
 
 #include "diagnostics/idiagnosticspathsregister.h"
 
@@ -103,6 +104,7 @@ void AutobotModule::resolveImports()
         api->regApiCreator("global", "api.interactive", new ApiCreator<InteractiveApi>());
         api->regApiCreator("ui", "api.keyboard", new ApiCreator<KeyboardApi>());
         api->regApiCreator("accessibility", "api.accessibility", new ApiCreator<AccessibilityApi>());
+        api->regApiCreator("global", "api.diagnostics", new ApiCreator<DiagnosticsApi>());
     }
 }
 
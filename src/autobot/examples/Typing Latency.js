@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+function main()
+{
+    api.log.info("----------- begin script typing latency ---------------")
+
+    api.autobot.setInterval(100)
+
+    api.autobot.openProject("simple1.mscz");
+    api.autobot.sleep(1000)
+
+    api.diagnostics.startEditLatency()
+
+    api.dispatcher.dispatch("note-input")
+    api.dispatcher.dispatch("pad-note-8")
+
+    var notes = ["note-c", "note-d", "note-e", "note-f", "note-g", "note-a", "note-b"]
+    for (var i = 0; i < 100; ++i) {
+        api.dispatcher.dispatch(notes[i % notes.length])
+        // let the notation be repainted
+        api.autobot.sleep()
+    }
+
+    var latency = api.diagnostics.editLatency()
+    api.log.info("typing latency, ms: p50: " + latency["all"].total.p50
+                 + ", p95: " + latency["all"].total.p95
+                 + ", p99: " + latency["all"].total.p99)
+
+    api.diagnostics.saveEditLatency("typing_latency.json")
+    api.diagnostics.stopEditLatency()
+
+    api.log.info("----------- end script typing latency ---------------")
+}
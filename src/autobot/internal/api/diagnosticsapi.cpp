@@ -0,0 +1,97 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "diagnosticsapi.h"
+
+#include <QDir>
+#include <QFileInfo>
+
+#include "editlatencyprobe.h"
+
+#include "log.h"
+
+using namespace mu::api;
+
+DiagnosticsApi::DiagnosticsApi(IApiEngine* e)
+    : ApiObject(e)
+{
+}
+
+void DiagnosticsApi::startEditLatency(int windowSize)
+{
+    EditLatencyProbe* probe = EditLatencyProbe::instance();
+    if (windowSize > 0) {
+        probe->setWindowSize(static_cast<size_t>(windowSize));
+    }
+
+    probe->setEnabled(true);
+}
+
+void DiagnosticsApi::stopEditLatency()
+{
+    EditLatencyProbe::instance()->setEnabled(false);
+}
+
+void DiagnosticsApi::clearEditLatency()
+{
+    EditLatencyProbe::instance()->clear();
+}
+
+static QVariantMap percentilesToMap(const EditLatencyProbe::Percentiles& p)
+{
+    QVariantMap map;
+    map["count"] = static_cast<int>(p.count);
+    map["p50"] = p.p50;
+    map["p95"] = p.p95;
+    map["p99"] = p.p99;
+    map["max"] = p.max;
+    return map;
+}
+
+//! NOTE Returns { "<action>": { "total": { "count", "p50", "p95", "p99", "max" }, "<phase>": {...}, ... }, ... },
+//! the "all" action is the summary over all actions, times are in ms
+QVariantMap DiagnosticsApi::editLatency() const
+{
+    QVariantMap result;
+    for (const EditLatencyProbe::ActionStats& s : EditLatencyProbe::instance()->stats()) {
+        QVariantMap action;
+        action["total"] = percentilesToMap(s.total);
+        for (size_t i = 0; i < EditLatencyProbe::PHASE_COUNT; ++i) {
+            action[EditLatencyProbe::phaseName(static_cast<EditLatencyProbe::Phase>(i))] = percentilesToMap(s.phases[i]);
+        }
+
+        result[QString::fromStdString(s.action)] = action;
+    }
+
+    return result;
+}
+
+//! NOTE The report is saved next to the projects saved by autobot
+bool DiagnosticsApi::saveEditLatency(const QString& name) const
+{
+    io::path_t dir = autobotConfiguration()->savingFilesPath();
+    if (!QFileInfo::exists(dir.toQString())) {
+        QDir().mkpath(dir.toQString());
+    }
+
+    LOGI() << EditLatencyProbe::instance()->printableReport();
+    return EditLatencyProbe::instance()->saveReport(dir + "/" + name);
+}
@@ -0,0 +1,51 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_API_DIAGNOSTICSAPI_H
+#define MU_API_DIAGNOSTICSAPI_H
+
+#include <QVariantMap>
+
+#include "apiobject.h"
+
+#include "modularity/ioc.h"
+#include "autobot/iautobotconfiguration.h"
+
+namespace mu::api {
+class DiagnosticsApi : public ApiObject
+{
+    Q_OBJECT
+
+    INJECT(api, autobot::IAutobotConfiguration, autobotConfiguration)
+
+public:
+    explicit DiagnosticsApi(IApiEngine* e);
+
+    // Edit latency
+    Q_INVOKABLE void startEditLatency(int windowSize = 0);
+    Q_INVOKABLE void stopEditLatency();
+    Q_INVOKABLE void clearEditLatency();
+    Q_INVOKABLE QVariantMap editLatency() const;
+    Q_INVOKABLE bool saveEditLatency(const QString& name) const;
+};
+}
+
+#endif // MU_API_DIAGNOSTICSAPI_H
@@ -53,6 +53,9 @@ public:
 
     virtual Ret exportScoreVideo(const io::path_t& in, const io::path_t& out) = 0;
 
+    virtual Ret exportThumbnails(const io::path_t& scoresDir, const io::path_t& outDir,
+                                 const io::path_t& stylePath = io::path_t(), bool forceMode = false) = 0;
+
     virtual Ret updateSource(const io::path_t& in, const std::string& newSource, bool forceMode = false) = 0;
 };
 }
@@ -21,6 +21,8 @@
  */
 #include "convertercontroller.h"
 
+#include <future>
+
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -30,6 +32,9 @@
 #include "convertercodes.h"
 #include "stringutils.h"
 #include "compat/backendapi.h"
+#include "concurrency/taskscheduler.h"
+
+#include "engraving/libmscore/masterscore.h"
 
 #include "log.h"
 
@@ -353,6 +358,90 @@ mu::Ret ConverterController::exportScoreVideo(const io::path_t& in, const io::pa
     return make_ret(Ret::Code::Ok);
 }
 
+io::path_t ConverterController::thumbnailOutPath(const io::path_t& in, const io::path_t& scoresDir, const io::path_t& outDir,
+                                                 std::set<std::string>& usedOutPaths) const
+{
+    //! NOTE Keep the directories of the scores, so that the scores with the same name don't overwrite each other
+    std::string baseDir = scoresDir.toStdString();
+    while (!baseDir.empty() && baseDir.back() == '/') {
+        baseDir.pop_back();
+    }
+
+    io::path_t dir = outDir;
+    std::string inDir = io::dirpath(in).toStdString();
+    if (inDir.size() > baseDir.size() && inDir.compare(0, baseDir.size(), baseDir) == 0 && inDir[baseDir.size()] == '/') {
+        dir = outDir + inDir.substr(baseDir.size()).c_str();
+        fileSystem()->makePath(dir);
+    }
+
+    //! NOTE For example, score.mscz and score.mscx in the same directory
+    io::path_t out = dir + "/" + io::basename(in) + ".png";
+    for (int n = 1; usedOutPaths.find(out.toStdString()) != usedOutPaths.end(); ++n) {
+        out = dir + "/" + io::basename(in) + "-" + std::to_string(n).c_str() + ".png";
+    }
+
+    usedOutPaths.insert(out.toStdString());
+    return out;
+}
+
+mu::Ret ConverterController::exportThumbnails(const io::path_t& scoresDir, const io::path_t& outDir, const io::path_t& stylePath,
+                                              bool forceMode)
+{
+    TRACEFUNC;
+
+    RetVal<io::paths_t> files = fileSystem()->scanFiles(scoresDir, { "*.mscz", "*.mscx" });
+    if (!files.ret) {
+        LOGE() << "failed scan files, err: " << files.ret.toString() << ", dir: " << scoresDir;
+        return make_ret(Err::InFileFailedLoad);
+    }
+
+    Ret ret = fileSystem()->makePath(outDir);
+    if (!ret) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+
+    //! NOTE Scores are loaded and laid out one by one in this thread,
+    //! and only the recorded first pages are rendered and saved in parallel
+    std::shared_ptr<draw::IImageProvider> provider = imageProvider();
+    std::shared_ptr<io::IFileSystem> fs = fileSystem();
+    std::vector<std::future<Ret> > jobs;
+    std::set<std::string> usedOutPaths;
+    for (const io::path_t& in : files.val) {
+        auto notationProject = notationCreator()->newProject();
+        IF_ASSERT_FAILED(notationProject) {
+            return make_ret(Err::UnknownError);
+        }
+
+        ret = notationProject->load(in, stylePath, forceMode);
+        if (!ret) {
+            LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << in;
+            continue;
+        }
+
+        mu::engraving::MasterScore* score = notationProject->masterNotation()->notation()->elements()->msScore()->masterScore();
+        if (score->pages().empty()) {
+            continue;
+        }
+
+        io::path_t out = thumbnailOutPath(in, scoresDir, outDir, usedOutPaths);
+        jobs.push_back(TaskScheduler::instance()->submit([provider, fs, out](const engraving::Score::ThumbnailDrawing& drawing) {
+            std::shared_ptr<draw::Pixmap> pixmap = engraving::Score::renderThumbnail(provider, drawing);
+            return fs->writeFile(out, pixmap->data());
+        }, score->createThumbnailDrawing()));
+    }
+
+    ret = make_ret(Ret::Code::Ok);
+    for (std::future<Ret>& job : jobs) {
+        Ret jobRet = job.get();
+        if (!jobRet) {
+            LOGE() << "failed write thumbnail, err: " << jobRet.toString();
+            ret = make_ret(Err::OutFileFailedWrite);
+        }
+    }
+
+    return ret;
+}
+
 mu::Ret ConverterController::updateSource(const io::path_t& in, const std::string& newSource, bool forceMode)
 {
     TRACEFUNC;
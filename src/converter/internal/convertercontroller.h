@@ -23,6 +23,7 @@
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
 #include <list>
+#include <set>
 
 #include "../iconvertercontroller.h"
 
@@ -31,6 +32,8 @@
 #include "project/inotationwritersregister.h"
 #include "project/iprojectrwregister.h"
 #include "context/iglobalcontext.h"
+#include "io/ifilesystem.h"
+#include "draw/iimageprovider.h"
 
 #include "types/retval.h"
 
@@ -41,6 +44,8 @@ class ConverterController : public IConverterController
     INJECT(converter, project::INotationWritersRegister, writers)
     INJECT(converter, project::IProjectRWRegister, projectRW)
     INJECT(converter, context::IGlobalContext, globalContext)
+    INJECT(converter, io::IFileSystem, fileSystem)
+    INJECT(converter, draw::IImageProvider, imageProvider)
 
 public:
     ConverterController() = default;
@@ -65,6 +70,9 @@ public:
 
     Ret exportScoreVideo(const io::path_t& in, const io::path_t& out) override;
 
+    Ret exportThumbnails(const io::path_t& scoresDir, const io::path_t& outDir,
+                         const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
+
     Ret updateSource(const io::path_t& in, const std::string& newSource, bool forceMode = false) override;
 
 private:
@@ -86,6 +94,9 @@ private:
                                const io::path_t& out) const;
     Ret convertScorePartsToPngs(project::INotationWriterPtr writer, notation::IMasterNotationPtr masterNotation,
                                 const io::path_t& out) const;
+
+    io::path_t thumbnailOutPath(const io::path_t& in, const io::path_t& scoresDir, const io::path_t& outDir,
+                                std::set<std::string>& usedOutPaths) const;
 };
 }
 
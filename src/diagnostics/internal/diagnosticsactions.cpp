@@ -39,6 +39,11 @@ const UiActionList DiagnosticsActions::m_actions = {
              mu::context::CTX_ANY,
              TranslatableString("action", "Show pr&ofiler…")
              ),
+    UiAction("diagnostic-memory-accounting-dump",
+             mu::context::UiCtxAny,
+             mu::context::CTX_ANY,
+             TranslatableString::untranslatable("&Memory accounting dump")
+             ),
     UiAction("diagnostic-show-navigation-tree",
              mu::context::UiCtxAny,
              mu::context::CTX_ANY,
@@ -25,6 +25,8 @@
 
 #include "view/diagnosticaccessiblemodel.h"
 
+#include "log.h"
+
 using namespace mu::diagnostics;
 using namespace mu::accessibility;
 
@@ -38,12 +40,21 @@ void DiagnosticsActionsController::init()
 {
     dispatcher()->reg(this, "diagnostic-show-paths", [this]() { openUri(SYSTEM_PATHS_URI); });
     dispatcher()->reg(this, "diagnostic-show-profiler", [this]() { openUri(PROFILER_URI); });
+    dispatcher()->reg(this, "diagnostic-memory-accounting-dump", this, &DiagnosticsActionsController::dumpMemoryAccounting);
     dispatcher()->reg(this, "diagnostic-show-navigation-tree", [this]() { openUri(NAVIGATION_TREE_URI); });
     dispatcher()->reg(this, "diagnostic-show-accessible-tree", [this]() { openUri(ACCESSIBLE_TREE_URI); });
     dispatcher()->reg(this, "diagnostic-accessible-tree-dump", []() { DiagnosticAccessibleModel::dumpTree(); });
     dispatcher()->reg(this, "diagnostic-show-engraving-elements", [this]() { openUri(ENGRAVING_ELEMENTS_URI, false); });
 }
 
+void DiagnosticsActionsController::dumpMemoryAccounting()
+{
+    //! NOTE Rates are since the previous dump
+    MemoryAccounting::Snapshot snapshot = MemoryAccounting::snapshot();
+    LOGI() << MemoryAccounting::printableReport(snapshot, m_lastMemorySnapshot);
+    m_lastMemorySnapshot = snapshot;
+}
+
 void DiagnosticsActionsController::openUri(const mu::UriQuery& uri, bool isSingle)
 {
     if (isSingle && interactive()->isOpened(uri.uri()).val) {
@@ -27,6 +27,7 @@
 #include "actions/actionable.h"
 #include "iinteractive.h"
 #include "accessibility/iaccessibilitycontroller.h"
+#include "memoryaccounting.h"
 
 namespace mu::diagnostics {
 class DiagnosticsActionsController : public actions::Actionable
@@ -41,6 +42,9 @@ public:
 
 private:
     void openUri(const mu::UriQuery& uri, bool isSingle = true);
+    void dumpMemoryAccounting();
+
+    MemoryAccounting::Snapshot m_lastMemorySnapshot;
 };
 }
 
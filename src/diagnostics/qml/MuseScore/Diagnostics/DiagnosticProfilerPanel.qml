@@ -86,6 +86,18 @@ Rectangle {
                 text: "Print"
                 onClicked: profModel.print()
             }
+
+            FlatButton {
+                anchors.verticalCenter: parent.verticalCenter
+                text: profModel.isTimelineRecording ? "Stop timeline" : "Record timeline"
+                onClicked: profModel.toggleTimelineRecording()
+            }
+
+            FlatButton {
+                anchors.verticalCenter: parent.verticalCenter
+                text: "Save timeline"
+                onClicked: profModel.saveTimeline()
+            }
         }
     }
 
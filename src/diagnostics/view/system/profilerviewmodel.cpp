@@ -121,3 +121,27 @@ void ProfilerViewModel::print()
 {
     PROFILER_PRINT;
 }
+
+bool ProfilerViewModel::isTimelineRecording() const
+{
+    return Profiler::options().timelineEnabled;
+}
+
+void ProfilerViewModel::toggleTimelineRecording()
+{
+    Profiler::instance()->setTimelineEnabled(!isTimelineRecording());
+    emit isTimelineRecordingChanged();
+}
+
+void ProfilerViewModel::saveTimeline()
+{
+    std::vector<std::string> filter = { "Chrome trace (*.json)" };
+    io::path_t path = interactive()->selectSavingFile("Save timeline", "timeline.json", filter);
+    if (path.empty()) {
+        return;
+    }
+
+    if (!Profiler::instance()->saveTimeline(path.toStdString())) {
+        LOGE() << "failed save timeline to: " << path;
+    }
+}
@@ -181,6 +181,15 @@ public:
             _highestChannel = c;
         }
     }
+
+    //! NOTE Events with equal ticks are appended after the existing ones
+    void merge(const EventMap& other)
+    {
+        for (const auto& event : other) {
+            insert(event);
+        }
+        registerChannel(other._highestChannel);
+    }
 };
 
 typedef EventList::iterator iEvent;
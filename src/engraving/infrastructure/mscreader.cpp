@@ -22,6 +22,7 @@
 #include "mscreader.h"
 
 #include "io/file.h"
+#include "io/mappedfile.h"
 #include "io/fileinfo.h"
 #include "io/dir.h"
 #include "serialization/zipreader.h"
@@ -67,6 +68,8 @@ const MscReader::Params& MscReader::params() const
 
 bool MscReader::open()
 {
+    TRACEFUNC;
+
     return reader()->open(m_params.device, m_params.filePath);
 }
 
@@ -138,6 +141,8 @@ String MscReader::mainFileName() const
 
 ByteArray MscReader::readScoreFile() const
 {
+    TRACEFUNC;
+
     String mscxFileName = mainFileName();
     ByteArray data = fileData(mscxFileName);
     if (data.empty() && reader()->isContainer()) {
@@ -246,7 +251,8 @@ bool MscReader::ZipFileReader::open(IODevice* device, const path_t& filePath)
 {
     m_device = device;
     if (!m_device) {
-        m_device = new File(filePath);
+        //! NOTE The archive is mapped, so entries are read in place without copying the whole file
+        m_device = new MappedFile(filePath);
         m_selfDeviceOwner = true;
     }
 
@@ -69,11 +69,15 @@ const MscWriter::Params& MscWriter::params() const
 
 bool MscWriter::open()
 {
+    TRACEFUNC;
+
     return writer()->open(m_params.device, m_params.filePath);
 }
 
 void MscWriter::close()
 {
+    TRACEFUNC;
+
     if (m_writer) {
         writeMeta();
 
@@ -73,6 +73,9 @@ void Paint::paintScore(draw::Painter* painter, Score* score, const Options& opt)
     int fromPage = opt.fromPage >= 0 ? opt.fromPage : 0;
     int toPage = (opt.toPage >= 0 && opt.toPage < int(pages.size())) ? opt.toPage : (int(pages.size()) - 1);
 
+    //! NOTE Reused for all pages, so that the page items are not reallocated
+    std::vector<EngravingItem*> elements;
+
     for (int copy = 0; copy < opt.copyCount; ++copy) {
         bool firstPage = true;
         for (int pi = fromPage; pi <= toPage; ++pi) {
@@ -127,7 +130,8 @@ void Paint::paintScore(draw::Painter* painter, Score* score, const Options& opt)
             // Draw page elements
             painter->setClipping(true);
             painter->setClipRect(pageRect);
-            std::vector<EngravingItem*> elements = page->items(drawRect.translated(-pagePos));
+            elements.clear();
+            page->items(drawRect.translated(-pagePos), elements);
             paintElements(*painter, elements, opt.isPrinting);
             painter->setClipping(false);
 
@@ -22,6 +22,8 @@
 #include "layout.h"
 
 #include "containers.h"
+#include "editlatencyprobe.h"
+#include "memoryaccounting.h"
 
 #include "libmscore/barline.h"
 #include "libmscore/beam.h"
@@ -73,6 +75,10 @@ Layout::Layout(Score* score)
 
 void Layout::doLayoutRange(const LayoutOptions& options, const Fraction& st, const Fraction& et)
 {
+    TRACEFUNC;
+    MEMORY_TAG_SCOPE(Layout);
+    EDIT_LATENCY_PHASE(Layout);
+
     CmdStateLocker cmdStateLocker(m_score);
     LayoutContext ctx(m_score);
 
@@ -332,6 +338,8 @@ void Layout::resetSystems(bool layoutAll, const LayoutOptions& options, LayoutCo
 
 void Layout::collectLinearSystem(const LayoutOptions& options, LayoutContext& ctx)
 {
+    TRACEFUNC;
+
     std::vector<int> visibleParts;
     for (size_t partIdx = 0; partIdx < m_score->parts().size(); partIdx++) {
         if (m_score->parts().at(partIdx)->show()) {
@@ -360,6 +360,8 @@ void LayoutPage::collectPage(const LayoutOptions& options, LayoutContext& ctx)
 
 void LayoutPage::layoutPage(const LayoutContext& ctx, Page* page, double restHeight, double footerPadding)
 {
+    TRACEFUNC;
+
     if (restHeight < 0.0) {
         LOGN("restHeight < 0.0: %f\n", restHeight);
         restHeight = 0;
@@ -670,6 +670,8 @@ void LayoutSystem::hideEmptyStaves(Score* score, System* system, bool isFirstSys
 
 void LayoutSystem::layoutSystemElements(const LayoutOptions& options, LayoutContext& lc, Score* score, System* system)
 {
+    TRACEFUNC;
+
     if (score->noStaves()) {
         return;
     }
@@ -20,6 +20,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "bsp.h"
@@ -29,156 +30,151 @@ using namespace mu;
 
 namespace mu::engraving {
 //---------------------------------------------------------
-//   InsertItemBspTreeVisitor
+//   intmaxlog
 //---------------------------------------------------------
 
-class InsertItemBspTreeVisitor : public BspTreeVisitor
+static inline int intmaxlog(size_t n)
 {
-    OBJECT_ALLOCATOR(engraving, InsertItemBspTreeVisitor)
-public:
-    EngravingItem* item;
-
-    inline void visit(std::list<EngravingItem*>* items) { items->push_front(item); }
-};
+    return n > 0 ? std::max(int(::ceil(::log(double(n)) / ::log(double(2)))), 5) : 0;
+}
 
 //---------------------------------------------------------
-//   RemoveItemBspTreeVisitor
+//   build
+//    replaces the content of the tree,
+//    the leaves are filled at once
 //---------------------------------------------------------
 
-class RemoveItemBspTreeVisitor : public BspTreeVisitor
+void BspTree::build(const RectF& rect, const std::vector<EngravingItem*>& items)
 {
-    OBJECT_ALLOCATOR(engraving, RemoveItemBspTreeVisitor)
-public:
-    EngravingItem* item;
-
-    inline void visit(std::list<EngravingItem*>* items) { items->remove(item); }
-};
-
-//---------------------------------------------------------
-//   FindItemBspTreeVisitor
-//---------------------------------------------------------
+    m_rect = rect;
 
-class FindItemBspTreeVisitor : public BspTreeVisitor
-{
-    OBJECT_ALLOCATOR(engraving, FindItemBspTreeVisitor)
-public:
-    std::list<EngravingItem*> foundItems;
-
-    void visit(std::list<EngravingItem*>* items)
-    {
-        for (auto it = items->begin(); it != items->end(); ++it) {
-            EngravingItem* item = *it;
-            if (!item->itemDiscovered) {
-                item->itemDiscovered = true;
-                foundItems.push_front(item);
-            }
-        }
+    m_entries.clear();
+    m_entries.reserve(items.size());
+    for (EngravingItem* item : items) {
+        m_entries.push_back({ item, item->pageBoundingRect() });
     }
-};
 
-//---------------------------------------------------------
-//   BspTree
-//---------------------------------------------------------
+    m_removedCount = 0;
+    m_lookup.clear();
+    m_lookupValid = false;
 
-BspTree::BspTree()
-    : leafCnt(0)
-{
-    depth = 0;
+    rebuildLeaves();
 }
 
 //---------------------------------------------------------
-//   intmaxlog
+//   clear
 //---------------------------------------------------------
 
-static inline int intmaxlog(int n)
+void BspTree::clear()
 {
-    return n > 0 ? std::max(int(::ceil(::log(double(n)) / ::log(double(2)))), 5) : 0;
+    m_cols = 0;
+    m_rows = 0;
+    m_entries.clear();
+    m_leafStart.clear();
+    m_leafItems.clear();
+    m_unsorted.clear();
+    m_removedCount = 0;
+    m_lookup.clear();
+    m_lookupValid = false;
+    m_visited.clear();
+    m_visitMark = 0;
 }
 
 //---------------------------------------------------------
-//   initialize
+//   insert
 //---------------------------------------------------------
 
-void BspTree::initialize(const RectF& rec, int n)
+void BspTree::insert(EngravingItem* item)
 {
-    depth      = intmaxlog(n);
-    this->rect = rec;
-    leafCnt    = 0;
-
-    nodes.resize((1 << (depth + 1)) - 1);
-    leaves.resize(1LL << depth);
-    std::fill(leaves.begin(), leaves.end(), std::list<EngravingItem*>());
-    initialize(rec, depth, 0);
+    if (leafCount() == 0) {
+        return;
+    }
+
+    uint32_t idx = static_cast<uint32_t>(m_entries.size());
+    m_entries.push_back({ item, item->pageBoundingRect() });
+    m_unsorted.push_back(idx);
+    m_visited.push_back(0);
+
+    if (m_lookupValid) {
+        auto value = std::make_pair(static_cast<const EngravingItem*>(item), idx);
+        m_lookup.insert(std::lower_bound(m_lookup.begin(), m_lookup.end(), value), value);
+    }
 }
 
 //---------------------------------------------------------
-//   clear
+//   remove
+//    the entry is only marked as removed,
+//    it is dropped when the leaves are rebuilt
 //---------------------------------------------------------
 
-void BspTree::clear()
+void BspTree::remove(EngravingItem* item)
 {
-    leafCnt = 0;
-    nodes.clear();
-    leaves.clear();
+    int idx = entryIndex(item);
+    if (idx < 0) {
+        return;
+    }
+
+    m_entries[idx].item = nullptr;
+    ++m_removedCount;
+
+    auto it = std::lower_bound(m_lookup.begin(), m_lookup.end(), std::make_pair(static_cast<const EngravingItem*>(item), uint32_t(0)));
+    m_lookup.erase(it);
 }
 
 //---------------------------------------------------------
-//   insert
+//   update
 //---------------------------------------------------------
 
-void BspTree::insert(EngravingItem* element)
+void BspTree::update(EngravingItem* item)
 {
-    InsertItemBspTreeVisitor insertVisitor;
-    insertVisitor.item = element;
-    climbTree(&insertVisitor, element->pageBoundingRect());
+    remove(item);
+    insert(item);
 }
 
 //---------------------------------------------------------
-//   remove
+//   items
 //---------------------------------------------------------
 
-void BspTree::remove(EngravingItem* element)
+std::vector<EngravingItem*> BspTree::items(const RectF& rect)
 {
-    RemoveItemBspTreeVisitor removeVisitor;
-    removeVisitor.item = element;
-    climbTree(&removeVisitor, element->pageBoundingRect());
+    std::vector<EngravingItem*> result;
+    items(rect, result);
+    return result;
 }
 
-//---------------------------------------------------------
-//   items
-//---------------------------------------------------------
+std::vector<EngravingItem*> BspTree::items(const PointF& pos)
+{
+    std::vector<EngravingItem*> result;
+    items(pos, result);
+    return result;
+}
 
-std::vector<EngravingItem*> BspTree::items(const RectF& rec)
+void BspTree::items(const RectF& rect, std::vector<EngravingItem*>& result)
 {
-    FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, rec);
-    std::vector<EngravingItem*> l;
-    for (EngravingItem* e : findVisitor.foundItems) {
-        e->itemDiscovered = false;
-        if (e->pageBoundingRect().intersects(rec)) {
-            l.push_back(e);
-        }
+    if (leafCount() == 0) {
+        return;
     }
-    return l;
-}
 
-//---------------------------------------------------------
-//   items
-//---------------------------------------------------------
+    compactIfNeeded();
 
-std::vector<EngravingItem*> BspTree::items(const PointF& pos)
+    LeafRange range = leafRange(rect.left(), rect.top(), rect.right(), rect.bottom());
+    findItems(range, result, [&rect](const EngravingItem* item) {
+        return item->pageBoundingRect().intersects(rect);
+    });
+}
+
+void BspTree::items(const PointF& pos, std::vector<EngravingItem*>& result)
 {
-    FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, pos);
-
-    std::vector<EngravingItem*> l;
-    for (EngravingItem* e : findVisitor.foundItems) {
-        e->itemDiscovered = false;
-        if (e->contains(pos)) {
-            l.push_back(e);
-        }
+    if (leafCount() == 0) {
+        return;
     }
-    return l;
+
+    compactIfNeeded();
+
+    LeafRange range = leafRange(pos.x(), pos.y(), pos.x(), pos.y());
+    findItems(range, result, [&pos](const EngravingItem* item) {
+        return item->contains(pos);
+    });
 }
 
 #ifndef NDEBUG
@@ -186,182 +182,195 @@ std::vector<EngravingItem*> BspTree::items(const PointF& pos)
 //   debug
 //---------------------------------------------------------
 
-String BspTree::debug(int index) const
+String BspTree::debug() const
 {
-    const Node* node = &nodes.at(index);
-
     String tmp;
-    if (node->type == Node::Type::LEAF) {
-        RectF rec = rectForIndex(index);
-        if (!leaves[node->leafIndex].empty()) {
+    for (int row = 0; row < m_rows; ++row) {
+        for (int col = 0; col < m_cols; ++col) {
+            size_t leaf = size_t(row) * m_cols + col;
+            size_t count = m_leafStart[leaf + 1] - m_leafStart[leaf];
+            if (count == 0) {
+                continue;
+            }
+
             tmp += String(u"[%1, %2, %3, %4] contains %5 items\n")
-                   .arg(rec.left()).arg(rec.top())
-                   .arg(rec.width()).arg(rec.height())
-                   .arg(leaves[node->leafIndex].size());
-        }
-    } else {
-        if (node->type == Node::Type::HORIZONTAL) {
-            tmp += debug(firstChildIndex(index));
-            tmp += debug(firstChildIndex(index) + 1);
-        } else {
-            tmp += debug(firstChildIndex(index));
-            tmp += debug(firstChildIndex(index) + 1);
+                   .arg(m_rect.left() + col * m_leafWidth).arg(m_rect.top() + row * m_leafHeight)
+                   .arg(m_leafWidth).arg(m_leafHeight)
+                   .arg(count);
         }
     }
+
+    if (!m_unsorted.empty()) {
+        tmp += String(u"%1 items not sorted into leaves\n").arg(m_unsorted.size());
+    }
     return tmp;
 }
 
 #endif
 
 //---------------------------------------------------------
-//   initialize
+//   leafRange
+//    items outside of the tree rect belong to the border leaves
 //---------------------------------------------------------
 
-void BspTree::initialize(const RectF& rec, int dep, int index)
+BspTree::LeafRange BspTree::leafRange(double left, double top, double right, double bottom) const
 {
-    Node* node = &nodes[index];
-    if (index == 0) {
-        node->type = Node::Type::HORIZONTAL;
-        node->offset = rec.center().x();
-    }
-
-    if (dep) {
-        Node::Type type;
-        RectF rect1, rect2;
-        double offset1, offset2;
-
-        if (node->type == Node::Type::HORIZONTAL) {
-            type = Node::Type::VERTICAL;
-            rect1.setRect(rec.left(), rec.top(), rec.width(), rec.height() * .5);
-            rect2.setRect(rect1.left(), rect1.bottom(), rect1.width(), rec.height() - rect1.height());
-            offset1 = rect1.center().x();
-            offset2 = rect2.center().x();
-        } else {
-            type = Node::Type::HORIZONTAL;
-            rect1.setRect(rec.left(), rec.top(), rec.width() * .5, rec.height());
-            rect2.setRect(rect1.right(), rect1.top(), rec.width() - rect1.width(), rect1.height());
-            offset1 = rect1.center().y();
-            offset2 = rect2.center().y();
-        }
+    auto column = [this](double x) {
+        return int(std::clamp(std::floor((x - m_rect.left()) / m_leafWidth), 0.0, double(m_cols - 1)));
+    };
 
-        int childIndex = firstChildIndex(index);
+    auto row = [this](double y) {
+        return int(std::clamp(std::floor((y - m_rect.top()) / m_leafHeight), 0.0, double(m_rows - 1)));
+    };
 
-        Node* child   = &nodes[childIndex];
-        child->offset = offset1;
-        child->type   = type;
+    LeafRange range;
+    range.firstCol = column(left);
+    range.lastCol = column(right);
+    range.firstRow = row(top);
+    range.lastRow = row(bottom);
 
-        child = &nodes[childIndex + 1];
-        child->offset = offset2;
-        child->type   = type;
-
-        initialize(rect1, dep - 1, childIndex);
-        initialize(rect2, dep - 1, childIndex + 1);
-    } else {
-        node->type      = Node::Type::LEAF;
-        node->leafIndex = leafCnt++;
-    }
+    return range;
 }
 
 //---------------------------------------------------------
-//   climbTree
+//   entryIndex
 //---------------------------------------------------------
 
-void BspTree::climbTree(BspTreeVisitor* visitor, const mu::PointF& pos, int index)
+int BspTree::entryIndex(const EngravingItem* item)
 {
-    if (nodes.empty()) {
-        return;
+    if (!m_lookupValid) {
+        m_lookup.clear();
+        m_lookup.reserve(m_entries.size() - m_removedCount);
+        for (uint32_t idx = 0; idx < m_entries.size(); ++idx) {
+            if (m_entries[idx].item) {
+                m_lookup.emplace_back(m_entries[idx].item, idx);
+            }
+        }
+        std::sort(m_lookup.begin(), m_lookup.end());
+        m_lookupValid = true;
     }
 
-    Node* node = &nodes[index];
-    int childIndex = firstChildIndex(index);
-
-    switch (node->type) {
-    case Node::Type::LEAF:
-        visitor->visit(&leaves[node->leafIndex]);
-        break;
-    case Node::Type::VERTICAL:
-        if (pos.x() < node->offset) {
-            climbTree(visitor, pos, childIndex);
-        } else {
-            climbTree(visitor, pos, childIndex + 1);
-        }
-        break;
-    case Node::Type::HORIZONTAL:
-        if (pos.y() < node->offset) {
-            climbTree(visitor, pos, childIndex);
-        } else {
-            climbTree(visitor, pos, childIndex + 1);
-        }
-        break;
+    auto it = std::lower_bound(m_lookup.begin(), m_lookup.end(), std::make_pair(item, uint32_t(0)));
+    if (it == m_lookup.end() || it->first != item) {
+        return -1;
     }
+
+    return static_cast<int>(it->second);
 }
 
 //---------------------------------------------------------
-//   climbTree
+//   rebuildLeaves
+//    drops the removed entries and sorts all entries into
+//    the leaves with a counting sort
 //---------------------------------------------------------
 
-void BspTree::climbTree(BspTreeVisitor* visitor, const mu::RectF& rec, int index)
+void BspTree::rebuildLeaves()
 {
-    if (nodes.empty()) {
-        return;
+    if (m_removedCount > 0) {
+        m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [](const Entry& entry) {
+            return entry.item == nullptr;
+        }), m_entries.end());
+
+        m_removedCount = 0;
+        m_lookup.clear();
+        m_lookupValid = false;
     }
 
-    Node* node = &nodes[index];
-    int childIndex = firstChildIndex(index);
-
-    switch (node->type) {
-    case Node::Type::LEAF:
-        visitor->visit(&leaves[node->leafIndex]);
-        break;
-    case Node::Type::VERTICAL:
-        if (rec.left() < node->offset) {
-            climbTree(visitor, rec, childIndex);
-            if (rec.right() >= node->offset) {
-                climbTree(visitor, rec, childIndex + 1);
+    m_unsorted.clear();
+
+    int depth = intmaxlog(m_entries.size());
+    m_cols = 1 << ((depth + 1) / 2);
+    m_rows = 1 << (depth / 2);
+    m_leafWidth = m_rect.width() > 0.0 ? m_rect.width() / m_cols : 1.0;
+    m_leafHeight = m_rect.height() > 0.0 ? m_rect.height() / m_rows : 1.0;
+
+    size_t leafCount = size_t(m_cols) * m_rows;
+    m_leafStart.assign(leafCount + 1, 0);
+
+    std::vector<LeafRange> ranges;
+    ranges.reserve(m_entries.size());
+
+    for (const Entry& entry : m_entries) {
+        const RectF& r = entry.rect;
+        LeafRange range = leafRange(r.left(), r.top(), r.right(), r.bottom());
+        for (int row = range.firstRow; row <= range.lastRow; ++row) {
+            for (int col = range.firstCol; col <= range.lastCol; ++col) {
+                ++m_leafStart[size_t(row) * m_cols + col + 1];
             }
-        } else {
-            climbTree(visitor, rec, childIndex + 1);
         }
-        break;
-    case Node::Type::HORIZONTAL:
-        if (rec.top() < node->offset) {
-            climbTree(visitor, rec, childIndex);
-            if (rec.bottom() >= node->offset) {
-                climbTree(visitor, rec, childIndex + 1);
+        ranges.push_back(range);
+    }
+
+    for (size_t leaf = 0; leaf < leafCount; ++leaf) {
+        m_leafStart[leaf + 1] += m_leafStart[leaf];
+    }
+
+    m_leafItems.resize(m_leafStart.back());
+
+    std::vector<uint32_t> fill(m_leafStart.begin(), m_leafStart.end() - 1);
+    for (uint32_t idx = 0; idx < m_entries.size(); ++idx) {
+        const LeafRange& range = ranges[idx];
+        for (int row = range.firstRow; row <= range.lastRow; ++row) {
+            for (int col = range.firstCol; col <= range.lastCol; ++col) {
+                m_leafItems[fill[size_t(row) * m_cols + col]++] = idx;
             }
-        } else {
-            climbTree(visitor, rec, childIndex + 1);
         }
     }
+
+    m_visited.assign(m_entries.size(), 0);
+    m_visitMark = 0;
 }
 
 //---------------------------------------------------------
-//   rectForIndex
+//   compactIfNeeded
+//    too many entries out of the leaves make the queries slow
 //---------------------------------------------------------
 
-mu::RectF BspTree::rectForIndex(int index) const
+void BspTree::compactIfNeeded()
 {
-    if (index <= 0) {
-        return rect;
+    size_t count = m_entries.size();
+    if (m_unsorted.size() > std::max(size_t(32), count / 8) || m_removedCount > count / 2) {
+        rebuildLeaves();
     }
+}
 
-    int parentIdx = parentIndex(index);
-    RectF rec   = rectForIndex(parentIdx);
-    const Node* parent = &nodes.at(parentIdx);
+//---------------------------------------------------------
+//   findItems
+//---------------------------------------------------------
+
+template<typename Accept>
+void BspTree::findItems(const LeafRange& range, std::vector<EngravingItem*>& result, Accept accept)
+{
+    if (++m_visitMark == 0) {
+        std::fill(m_visited.begin(), m_visited.end(), 0);
+        m_visitMark = 1;
+    }
 
-    if (parent->type == Node::Type::HORIZONTAL) {
-        if (index & 1) {
-            rec.setRight(parent->offset);
-        } else {
-            rec.setLeft(parent->offset);
+    auto visit = [&](uint32_t idx) {
+        EngravingItem* item = m_entries[idx].item;
+        if (!item || m_visited[idx] == m_visitMark) {
+            return;
         }
-    } else {
-        if (index & 1) {
-            rec.setBottom(parent->offset);
-        } else {
-            rec.setTop(parent->offset);
+
+        m_visited[idx] = m_visitMark;
+        if (accept(item)) {
+            result.push_back(item);
         }
+    };
+
+    for (int row = range.firstRow; row <= range.lastRow; ++row) {
+        size_t leaf = size_t(row) * m_cols + range.firstCol;
+        const uint32_t* begin = m_leafItems.data() + m_leafStart[leaf];
+        const uint32_t* end = m_leafItems.data() + m_leafStart[leaf + range.lastCol - range.firstCol + 1];
+
+        //! NOTE The leaves of one row are adjacent in memory
+        for (const uint32_t* it = begin; it != end; ++it) {
+            visit(*it);
+        }
+    }
+
+    for (uint32_t idx : m_unsorted) {
+        visit(idx);
     }
-    return rec;
 }
 }
@@ -23,88 +23,96 @@
 #ifndef __BSP_H__
 #define __BSP_H__
 
-#include <list>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
-#include "global/allocator.h"
 #include "types/string.h"
 #include "draw/types/geometry.h"
 
 namespace mu::engraving {
-class BspTreeVisitor;
-class InsertItemBspTreeVisitor;
-class RemoveItemBspTreeVisitor;
-class FindItemBspTreeVisitor;
-
 class EngravingItem;
 
 //---------------------------------------------------------
 //   BspTree
 //    binary space partitioning
+//
+//    The page rect is split in halves, alternately by width and height,
+//    so the leaves form a regular grid and are addressed directly.
+//    The items of all leaves are stored in one contiguous array
+//    (leaf i owns m_leafItems[m_leafStart[i] .. m_leafStart[i + 1])),
+//    which is built at once by `build`.
+//    Items inserted, moved or removed afterwards are kept aside
+//    until there are enough of them to rebuild the leaves.
 //---------------------------------------------------------
 
 class BspTree
 {
 public:
-    struct Node {
-        enum class Type : char {
-            HORIZONTAL, VERTICAL, LEAF
-        };
-        union {
-            double offset;
-            int leafIndex;
-        };
-        Type type;
-    };
-private:
-    unsigned int depth;
-    void initialize(const mu::RectF& rect, int depth, int index);
-    void climbTree(BspTreeVisitor* visitor, const mu::PointF& pos, int index = 0);
-    void climbTree(BspTreeVisitor* visitor, const mu::RectF& rect, int index = 0);
+    BspTree() = default;
 
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::RectF& rect, int index);
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::PointF& pos, int index);
-    mu::RectF rectForIndex(int index) const;
-
-    std::vector<Node> nodes;
-    std::vector<std::list<EngravingItem*> > leaves;
-    int leafCnt;
-    mu::RectF rect;
-
-public:
-    BspTree();
-
-    void initialize(const mu::RectF& rect, int depth);
+    void build(const mu::RectF& rect, const std::vector<EngravingItem*>& items);
     void clear();
 
     void insert(EngravingItem* item);
     void remove(EngravingItem* item);
+    void update(EngravingItem* item); // the item has been moved
 
     std::vector<EngravingItem*> items(const mu::RectF& rect);
     std::vector<EngravingItem*> items(const mu::PointF& pos);
 
-    int leafCount() const { return leafCnt; }
-    inline int firstChildIndex(int index) const { return index * 2 + 1; }
+    //! NOTE Don't allocate if the buffer is big enough, found items are appended to it
+    void items(const mu::RectF& rect, std::vector<EngravingItem*>& result);
+    void items(const mu::PointF& pos, std::vector<EngravingItem*>& result);
 
-    inline int parentIndex(int index) const
-    {
-        return index > 0 ? ((index & 1) ? ((index - 1) / 2) : ((index - 2) / 2)) : -1;
-    }
+    size_t leafCount() const { return m_leafStart.empty() ? 0 : m_leafStart.size() - 1; }
+    size_t itemCount() const { return m_entries.size() - m_removedCount; }
 
 #ifndef NDEBUG
-    String debug(int index) const;
+    String debug() const;
 #endif
-};
 
-//---------------------------------------------------------
-//   BspTreeVisitor
-//---------------------------------------------------------
+private:
+    struct Entry {
+        EngravingItem* item = nullptr; // nullptr if removed
+        mu::RectF rect;                // page bounding rect when inserted
+    };
 
-class BspTreeVisitor
-{
-    OBJECT_ALLOCATOR(engraving, BspTreeVisitor)
-public:
-    virtual ~BspTreeVisitor() {}
-    virtual void visit(std::list<EngravingItem*>* items) = 0;
+    struct LeafRange {
+        int firstCol = 0;
+        int lastCol = -1;
+        int firstRow = 0;
+        int lastRow = -1;
+    };
+
+    LeafRange leafRange(double left, double top, double right, double bottom) const;
+    int entryIndex(const EngravingItem* item);
+
+    void rebuildLeaves();
+    void compactIfNeeded();
+
+    template<typename Accept>
+    void findItems(const LeafRange& range, std::vector<EngravingItem*>& result, Accept accept);
+
+    mu::RectF m_rect;
+    int m_cols = 0;
+    int m_rows = 0;
+    double m_leafWidth = 1.0;
+    double m_leafHeight = 1.0;
+
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_leafStart;
+    std::vector<uint32_t> m_leafItems;
+    std::vector<uint32_t> m_unsorted;   // entries inserted after the leaves were built
+    size_t m_removedCount = 0;
+
+    //! NOTE Sorted by item, used to find the entry of an item; built on the first removal
+    std::vector<std::pair<const EngravingItem*, uint32_t> > m_lookup;
+    bool m_lookupValid = false;
+
+    //! NOTE An item can be in several leaves, so the entries found by the current query are marked
+    std::vector<uint32_t> m_visited;
+    uint32_t m_visitMark = 0;
 };
 } // namespace mu::engraving
 #endif
@@ -76,6 +76,7 @@
 #include "undo.h"
 #include "utils.h"
 
+#include "editlatencyprobe.h"
 #include "log.h"
 
 using namespace mu;
@@ -297,6 +298,8 @@ void Score::undoRedo(bool undo, EditData* ed)
         return;
     }
 
+    EDIT_LATENCY_PHASE(EndCmd);
+
     //! NOTE: the order of operations is very important here
     //! 1. for the undo operation, the list of changed elements is available before undo()
     //! 2. for the redo operation, the list of changed elements will be available after redo()
@@ -349,6 +352,8 @@ void Score::endCmd(bool rollback, bool layoutAllParts)
         return;
     }
 
+    EDIT_LATENCY_PHASE(EndCmd);
+
     if (readOnly() || MScore::_error != MsError::MS_NO_ERROR) {
         rollback = true;
     }
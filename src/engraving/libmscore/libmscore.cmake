@@ -327,6 +327,8 @@ set(LIBMSCORE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/textline.h
     ${CMAKE_CURRENT_LIST_DIR}/textlinebase.cpp
     ${CMAKE_CURRENT_LIST_DIR}/textlinebase.h
+    ${CMAKE_CURRENT_LIST_DIR}/tickindex.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/tickindex.h
     ${CMAKE_CURRENT_LIST_DIR}/tie.cpp
     ${CMAKE_CURRENT_LIST_DIR}/tie.h
     ${CMAKE_CURRENT_LIST_DIR}/tiemap.h
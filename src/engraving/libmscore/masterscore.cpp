@@ -21,8 +21,11 @@
  */
 #include "masterscore.h"
 
+#include <future>
+
 #include "types/datetime.h"
 #include "io/buffer.h"
+#include "concurrency/taskscheduler.h"
 
 #include "compat/writescorehook.h"
 #include "infrastructure/mscwriter.h"
@@ -225,6 +228,13 @@ bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCre
         return false;
     }
 
+    //! NOTE The first page is recorded here, and rendered to the thumbnail
+    //! in a worker thread while the score is being written
+    std::future<std::shared_ptr<mu::draw::Pixmap> > thumbnail;
+    if (doCreateThumbnail && !pages().empty()) {
+        thumbnail = TaskScheduler::instance()->submit(&Score::renderThumbnail, imageProvider(), createThumbnailDrawing());
+    }
+
     // Write style of MasterScore
     {
         //! NOTE The style is writing to a separate file only for the master score.
@@ -307,8 +317,8 @@ bool MasterScore::writeMscz(MscWriter& mscWriter, bool onlySelection, bool doCre
 
     // Write thumbnail
     {
-        if (doCreateThumbnail && !pages().empty()) {
-            auto pixmap = createThumbnail();
+        if (thumbnail.valid()) {
+            auto pixmap = thumbnail.get();
 
             ByteArray ba;
             Buffer b(&ba);
@@ -74,6 +74,44 @@ std::vector<EngravingItem*> Page::items(const mu::PointF& point)
     return bspTree.items(point);
 }
 
+void Page::items(const RectF& rect, std::vector<EngravingItem*>& result)
+{
+    if (!bspTreeValid) {
+        doRebuildBspTree();
+    }
+    bspTree.items(rect, result);
+}
+
+void Page::items(const mu::PointF& point, std::vector<EngravingItem*>& result)
+{
+    if (!bspTreeValid) {
+        doRebuildBspTree();
+    }
+    bspTree.items(point, result);
+}
+
+//---------------------------------------------------------
+//   bspUpdate
+//---------------------------------------------------------
+
+static void bspUpdate(void* bspTree, EngravingItem* e)
+{
+    static_cast<BspTree*>(bspTree)->update(e);
+}
+
+//---------------------------------------------------------
+//   updateBspTree
+//    cheaper than invalidating the tree if only a few items have been moved
+//---------------------------------------------------------
+
+void Page::updateBspTree(EngravingItem* item)
+{
+    if (!bspTreeValid) {
+        return;
+    }
+    item->scanElements(&bspTree, &bspUpdate, false);
+}
+
 //---------------------------------------------------------
 //   appendSystem
 //---------------------------------------------------------
@@ -319,17 +357,12 @@ void Page::scanElements(void* data, void (* func)(void*, EngravingItem*), bool a
 }
 
 //---------------------------------------------------------
-//   bspInsert
+//   collectElements
 //---------------------------------------------------------
 
-static void bspInsert(void* bspTree, EngravingItem* e)
-{
-    ((BspTree*)bspTree)->insert(e);
-}
-
-static void countElements(void* data, EngravingItem* /*e*/)
+static void collectElements(void* data, EngravingItem* e)
 {
-    ++(*(int*)data);
+    static_cast<std::vector<EngravingItem*>*>(data)->push_back(e);
 }
 
 //---------------------------------------------------------
@@ -338,8 +371,8 @@ static void countElements(void* data, EngravingItem* /*e*/)
 
 void Page::doRebuildBspTree()
 {
-    int n = 0;
-    scanElements(&n, countElements, false);
+    std::vector<EngravingItem*> elements;
+    scanElements(&elements, collectElements, false);
 
     RectF r;
     if (score()->linearMode()) {
@@ -357,8 +390,7 @@ void Page::doRebuildBspTree()
         r = abbox();
     }
 
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
+    bspTree.build(r, elements);
     bspTreeValid = true;
 }
 
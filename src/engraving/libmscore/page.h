@@ -92,7 +92,10 @@ public:
 
     std::vector<EngravingItem*> items(const mu::RectF& r);
     std::vector<EngravingItem*> items(const mu::PointF& p);
+    void items(const mu::RectF& r, std::vector<EngravingItem*>& result);
+    void items(const mu::PointF& p, std::vector<EngravingItem*>& result);
     void invalidateBspTree() { bspTreeValid = false; }
+    void updateBspTree(EngravingItem* item);     ///< item and its children have been moved
     mu::PointF pagePos() const override { return mu::PointF(); }       ///< position in page coordinates
     std::vector<EngravingItem*> elements() const;              ///< list of visible elements
     mu::RectF tbbox();                             // tight bounding box, excluding white space
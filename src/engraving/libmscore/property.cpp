@@ -22,6 +22,8 @@
 
 #include "property.h"
 
+#include <unordered_map>
+
 #include "translation.h"
 
 #include "rw/xml.h"
@@ -397,10 +399,18 @@ static constexpr PropertyMetaData propertyList[] = {
 
 Pid propertyId(const AsciiStringView& s)
 {
-    for (const PropertyMetaData& pd : propertyList) {
-        if (s == pd.name) {
-            return pd.id;
+    static const std::unordered_map<std::string_view, Pid> index = []() {
+        std::unordered_map<std::string_view, Pid> idx;
+        idx.reserve(sizeof(propertyList) / sizeof(propertyList[0]));
+        for (const PropertyMetaData& pd : propertyList) {
+            idx.emplace(std::string_view(pd.name), pd.id);
         }
+        return idx;
+    }();
+
+    auto it = index.find(std::string_view(s.ascii(), s.size()));
+    if (it != index.end()) {
+        return it->second;
     }
     return Pid::END;
 }
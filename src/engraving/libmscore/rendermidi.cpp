@@ -29,8 +29,10 @@
 
 #include <set>
 #include <cmath>
+#include <thread>
 
 #include "compat/midi/event.h"
+#include "concurrency/taskscheduler.h"
 #include "style/style.h"
 #include "types/constants.h"
 
@@ -2272,8 +2274,63 @@ void Score::renderMidi(EventMap* events, bool metronome, bool expandRepeats, con
 void MidiRenderer::renderScore(EventMap* events, const Context& ctx)
 {
     updateState();
+
+    //! NOTE Preparing play events, channels and velocities changes the score,
+    //! so it is done once for all chunks before they are rendered
     for (const Chunk& chunk : chunks) {
-        renderChunk(chunk, events, ctx);
+        score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
+    }
+
+    score->updateChannel();
+    score->updateVelo();
+
+    const std::vector<StaffContext> contexts = staffContexts(ctx);
+
+    TaskScheduler* scheduler = TaskScheduler::instance();
+    bool renderInParallel = ctx.renderInParallel
+                            && contexts.size() > 1
+                            && scheduler->threadPoolSize() > 1
+                            && !scheduler->containsThread(std::this_thread::get_id());
+
+    if (!renderInParallel) {
+        for (const Chunk& chunk : chunks) {
+            for (const StaffContext& sctx : contexts) {
+                renderStaffChunk(chunk, events, sctx);
+            }
+            finishChunk(chunk, events, ctx);
+        }
+        return;
+    }
+
+    //! NOTE Each task renders all chunks of one staff, so the staff state that is
+    //! cached while rendering (velocities, realized harmonies) is used by one thread only.
+    //! The events are merged in the same order as they are inserted by the serial rendering
+    std::vector<std::future<std::vector<EventMap> > > futures;
+    futures.reserve(contexts.size());
+
+    for (const StaffContext& sctx : contexts) {
+        futures.push_back(scheduler->submit([this, sctx]() {
+            std::vector<EventMap> chunkEvents(chunks.size());
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                renderStaffChunk(chunks.at(i), &chunkEvents.at(i), sctx);
+            }
+            return chunkEvents;
+        }));
+    }
+
+    std::vector<std::vector<EventMap> > staffEvents;
+    staffEvents.reserve(futures.size());
+
+    for (std::future<std::vector<EventMap> >& future : futures) {
+        staffEvents.push_back(future.get());
+    }
+
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        for (std::vector<EventMap>& chunkEvents : staffEvents) {
+            events->merge(chunkEvents.at(i));
+            chunkEvents.at(i).clear();
+        }
+        finishChunk(chunks.at(i), events, ctx);
     }
 }
 
@@ -2285,6 +2342,20 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
     score->updateChannel();
     score->updateVelo();
 
+    // create note & other events
+    for (const StaffContext& sctx : staffContexts(ctx)) {
+        renderStaffChunk(chunk, events, sctx);
+    }
+
+    finishChunk(chunk, events, ctx);
+}
+
+//---------------------------------------------------------
+//   staffContexts
+//---------------------------------------------------------
+
+std::vector<MidiRenderer::StaffContext> MidiRenderer::staffContexts(const Context& ctx) const
+{
     SynthesizerState s = score->synthesizerState();
     int method = s.method();
     int cc = s.ccToUse();
@@ -2319,15 +2390,29 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
         break;
     }
 
-    // create note & other events
+    std::vector<StaffContext> contexts;
+    contexts.reserve(score->nstaves());
+
     for (Staff* st : score->staves()) {
         StaffContext sctx;
         sctx.staff = st;
         sctx.method = renderMethod;
         sctx.cc = cc;
         sctx.renderHarmony = ctx.renderHarmony;
-        renderStaffChunk(chunk, events, sctx);
+        contexts.push_back(sctx);
     }
+
+    return contexts;
+}
+
+//---------------------------------------------------------
+//   finishChunk
+///   adds the events that don't belong to a single staff
+///   to the chunk's note events and cleans them up
+//---------------------------------------------------------
+
+void MidiRenderer::finishChunk(const Chunk& chunk, EventMap* events, const Context& ctx)
+{
     events->fixupMIDI();
 
     // create sustain pedal events
@@ -130,6 +130,7 @@ public:
         SynthesizerState synthState;
         bool metronome{ true };
         bool renderHarmony{ false };
+        bool renderInParallel{ true };
 
         Context() {}
     };
@@ -143,6 +144,10 @@ public:
     static const int ARTICULATION_CONV_FACTOR { 100000 };
 
     std::vector<Chunk> chunksFromRange(const int fromTick, const int toTick);
+
+private:
+    std::vector<StaffContext> staffContexts(const Context& ctx) const;
+    void finishChunk(const Chunk&, EventMap* events, const Context& ctx);
 };
 } // namespace mu::engraving
 
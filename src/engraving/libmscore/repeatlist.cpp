@@ -23,6 +23,7 @@
 #include "repeatlist.h"
 
 #include <algorithm>
+#include <cstring>
 #include <list>
 #include <utility> // std::pair
 
@@ -119,8 +120,6 @@ const std::vector<const Measure*>& RepeatSegment::measureList() const
 RepeatList::RepeatList(Score* s)
 {
     _score = s;
-    idx1  = 0;
-    idx2  = 0;
 }
 
 //---------------------------------------------------------
@@ -155,15 +154,109 @@ void RepeatList::update(bool expand)
         return;
     }
 
-    if (expand) {
-        unwind();
+    std::vector<int64_t> structure;
+    std::vector<String> labels;
+    collectStructure(structure, labels);
+
+    if (expand == _expanded && !empty() && structure == _structure && labels == _structureLabels) {
+        //! NOTE The edit did not touch anything the unwinding depends on,
+        //! so the segments are still valid and only their timing has to be refreshed
+        updateTicks();
     } else {
-        flatten();
+        if (expand) {
+            unwind();
+        } else {
+            flatten();
+        }
+        _structure = std::move(structure);
+        _structureLabels = std::move(labels);
     }
 
     _scoreChanged = false;
 }
 
+//---------------------------------------------------------
+//   collectStructure
+///   Gather everything that influences the unwinding:
+///   measures and frames, repeats, section breaks, jumps,
+///   markers and voltas
+//---------------------------------------------------------
+
+void RepeatList::collectStructure(std::vector<int64_t>& structure, std::vector<String>& labels) const
+{
+    auto key = [](const void* p) { return static_cast<int64_t>(reinterpret_cast<intptr_t>(p)); };
+
+    for (const MeasureBase* mb = _score->first(); mb; mb = mb->next()) {
+        structure.push_back(key(mb));
+        if (mb->isMeasure()) {
+            structure.push_back((mb->repeatStart() ? 1 : 0) | (mb->repeatEnd() ? 2 : 0));
+            structure.push_back(toMeasure(mb)->repeatCount());
+        }
+        if (mb->sectionBreak()) {
+            const LayoutBreak* layoutBreak = mb->sectionBreakElement();
+            double pause = layoutBreak ? layoutBreak->pause() : 0.0;
+            int64_t pauseBits = 0;
+            static_assert(sizeof(pause) == sizeof(pauseBits));
+            std::memcpy(&pauseBits, &pause, sizeof(pause));
+            structure.push_back(key(layoutBreak));
+            structure.push_back(pauseBits);
+        }
+        for (const EngravingItem* e : mb->el()) {
+            if (e->isJump()) {
+                const Jump* jump = toJump(e);
+                structure.push_back(key(jump));
+                structure.push_back(jump->playRepeats() ? 1 : 0);
+                labels.push_back(jump->jumpTo());
+                labels.push_back(jump->playUntil());
+                labels.push_back(jump->continueAt());
+            } else if (e->isMarker()) {
+                const Marker* marker = toMarker(e);
+                structure.push_back(key(marker));
+                structure.push_back(static_cast<int64_t>(marker->align().horizontal));
+                labels.push_back(marker->label());
+            }
+        }
+    }
+
+    for (const auto& spannerEntry : _score->spanner()) {
+        if (!spannerEntry.second->isVolta()) {
+            continue;
+        }
+        const Volta* volta = toVolta(spannerEntry.second);
+        structure.push_back(key(volta));
+        structure.push_back(key(volta->startMeasure()));
+        structure.push_back(key(volta->endMeasure()));
+        structure.push_back(static_cast<int64_t>(volta->getProperty(Pid::END_HOOK_TYPE).value<HookType>()));
+        const std::vector<int>& endings = volta->endings();
+        structure.push_back(static_cast<int64_t>(endings.size()));
+        for (int ending : endings) {
+            structure.push_back(ending);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   updateTicks
+///   Refresh the timing of the existing segments after
+///   measure lengths or tempo changed
+//---------------------------------------------------------
+
+void RepeatList::updateTicks()
+{
+    for (RepeatSegment* s : *this) {
+        if (s->firstMeasure()) {
+            s->tick = s->firstMeasure()->tick().ticks();
+        }
+        s->utick = 0;
+        s->utime = 0.0;
+        s->timeOffset = 0.0;
+    }
+
+    if (_expanded) {
+        updateTempo();
+    }
+}
+
 //---------------------------------------------------------
 //   updateTempo
 //---------------------------------------------------------
@@ -188,6 +281,20 @@ void RepeatList::updateTempo()
     }
 }
 
+//---------------------------------------------------------
+//   findSegmentFromUTick
+///   Last segment starting at or before utick, segments
+///   are sorted by utick
+//---------------------------------------------------------
+
+static const RepeatSegment* findSegmentFromUTick(const std::vector<RepeatSegment*>& segments, int utick)
+{
+    auto it = std::upper_bound(segments.cbegin(), segments.cend(), utick, [](int utick, const RepeatSegment* s) {
+        return utick < s->utick;
+    });
+    return it != segments.cbegin() ? *(it - 1) : nullptr;
+}
+
 //---------------------------------------------------------
 //   utick2tick
 //---------------------------------------------------------
@@ -201,12 +308,9 @@ int RepeatList::utick2tick(int tick) const
     if (tick < 0) {
         return 0;
     }
-    unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-    for (unsigned i = ii; i < n; ++i) {
-        if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i + 1)->utick))) {
-            idx1 = i;
-            return tick - (at(i)->utick - at(i)->tick);
-        }
+    const RepeatSegment* s = findSegmentFromUTick(*this, tick);
+    if (s) {
+        return tick - (s->utick - s->tick);
     }
 
     ASSERT_X(String(u"tick %1 not found in RepeatList").arg(tick));
@@ -236,14 +340,11 @@ int RepeatList::tick2utick(int tick) const
 
 double RepeatList::utick2utime(int tick) const
 {
-    size_t n = size();
-    unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-    for (unsigned i = ii; i < n; ++i) {
-        if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i + 1)->utick))) {
-            int t     = tick - (at(i)->utick - at(i)->tick);
-            double tt = _score->tempomap()->tick2time(t) + at(i)->timeOffset;
-            return tt;
-        }
+    const RepeatSegment* s = findSegmentFromUTick(*this, tick);
+    if (s) {
+        int t     = tick - (s->utick - s->tick);
+        double tt = _score->tempomap()->tick2time(t) + s->timeOffset;
+        return tt;
     }
     return 0.0;
 }
@@ -254,13 +355,13 @@ double RepeatList::utick2utime(int tick) const
 
 int RepeatList::utime2utick(double secs) const
 {
-    size_t repeatSegmentsCount = size();
-    unsigned ii = (idx2 < repeatSegmentsCount) && (secs >= at(idx2)->utime) ? idx2 : 0;
-    for (unsigned i = ii; i < repeatSegmentsCount; ++i) {
-        if ((secs >= at(i)->utime) && ((i + 1 == repeatSegmentsCount) || (secs < at(i + 1)->utime))) {
-            idx2 = i;
-            return _score->tempomap()->time2tick(secs - at(i)->timeOffset) + (at(i)->utick - at(i)->tick);
-        }
+    // last segment starting at or before secs
+    auto it = std::upper_bound(cbegin(), cend(), secs, [](double secs, const RepeatSegment* s) {
+        return secs < s->utime;
+    });
+    if (it != cbegin()) {
+        const RepeatSegment* s = *(it - 1);
+        return _score->tempomap()->time2tick(secs - s->timeOffset) + (s->utick - s->tick);
     }
 
     ASSERT_X(String(u"time %1 not found in RepeatList").arg(secs));
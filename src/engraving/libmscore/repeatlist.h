@@ -23,6 +23,7 @@
 #ifndef __REPEATLIST_H__
 #define __REPEATLIST_H__
 
+#include <cstdint>
 #include <set>
 #include <vector>
 
@@ -80,11 +81,15 @@ class RepeatList : public std::vector<RepeatSegment*>
     OBJECT_ALLOCATOR(engraving, RepeatList)
 
     Score* _score = nullptr;
-    mutable unsigned idx1, idx2;     // cached values
 
     bool _expanded = false;
     bool _scoreChanged = true;
 
+    // snapshot of everything in the score that determines the shape of the list,
+    // used to skip the unwind when an edit did not touch the repeat structure
+    std::vector<int64_t> _structure;
+    std::vector<String> _structureLabels;
+
     std::set<std::pair<Jump const* const, int> > _jumpsTaken;     // take the jumps only once, so track them during unwind
     std::vector<RepeatListElementList> _rlElements;   // all elements of the score that influence the RepeatList
 
@@ -99,6 +104,9 @@ class RepeatList : public std::vector<RepeatSegment*>
     void unwind();
     void flatten();
 
+    void collectStructure(std::vector<int64_t>& structure, std::vector<String>& labels) const;
+    void updateTicks();
+
 public:
     RepeatList(Score* s);
     RepeatList(const RepeatList&) = delete;
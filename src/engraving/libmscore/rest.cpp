@@ -40,6 +40,7 @@
 #include "measure.h"
 #include "measurerepeat.h"
 #include "note.h"
+#include "page.h"
 #include "score.h"
 #include "segment.h"
 #include "staff.h"
@@ -172,7 +173,12 @@ mu::RectF Rest::drag(EditData& ed)
     }
     setOffset(PointF(s.x(), s.y()));
     layout();
-    score()->rebuildBspTree();
+
+    if (EngravingItem* page = findAncestor(ElementType::PAGE)) {
+        toPage(page)->updateBspTree(this);
+    } else {
+        score()->rebuildBspTree();
+    }
     return abbox().united(r);
 }
 
@@ -54,6 +54,10 @@
 #include "synthesizerstate.h"
 #include "rootitem.h"
 
+namespace mu::draw {
+struct DrawData;
+}
+
 namespace mu::engraving {
 class IMimeData;
 class Read400;
@@ -1205,6 +1209,19 @@ public:
     Measure* firstTrailingMeasure(ChordRest** cr = nullptr);
     ChordRest* cmdTopStaff(ChordRest* cr = nullptr);
 
+    //! NOTE The first page is recorded in the main thread,
+    //! and the recording can be rendered to the thumbnail in any thread
+    struct ThumbnailDrawing {
+        std::shared_ptr<mu::draw::DrawData> data;
+        int width = 0;
+        int height = 0;
+        int dpm = 0;
+        mu::draw::Color backgroundColor;
+    };
+
+    ThumbnailDrawing createThumbnailDrawing();
+    static std::shared_ptr<mu::draw::Pixmap> renderThumbnail(std::shared_ptr<mu::draw::IImageProvider> imageProvider,
+                                                             const ThumbnailDrawing& drawing);
     std::shared_ptr<mu::draw::Pixmap> createThumbnail();
     String createRehearsalMarkText(RehearsalMark* current) const;
     String nextRehearsalMarkText(RehearsalMark* previous, RehearsalMark* current) const;
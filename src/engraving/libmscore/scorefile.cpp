@@ -25,6 +25,9 @@
 #include "io/file.h"
 #include "io/fileinfo.h"
 
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
+
 #include "style/style.h"
 
 #include "compat/writescorehook.h"
@@ -268,6 +271,16 @@ void Score::linkMeasures(Score* score)
 //---------------------------------------------------------
 
 std::shared_ptr<mu::draw::Pixmap> Score::createThumbnail()
+{
+    return renderThumbnail(imageProvider(), createThumbnailDrawing());
+}
+
+//---------------------------------------------------------
+//   createThumbnailDrawing
+//    records the drawing of the first page
+//---------------------------------------------------------
+
+Score::ThumbnailDrawing Score::createThumbnailDrawing()
 {
     TRACEFUNC;
 
@@ -277,23 +290,26 @@ std::shared_ptr<mu::draw::Pixmap> Score::createThumbnail()
     Page* page = pages().at(0);
     RectF fr = page->abbox();
     double mag = 256.0 / std::max(fr.width(), fr.height());
-    int w = int(fr.width() * mag);
-    int h = int(fr.height() * mag);
 
-    int dpm = lrint(DPMM * 1000.0);
-
-    auto pixmap = imageProvider()->createPixmap(w, h, dpm, configuration()->thumbnailBackgroundColor());
+    ThumbnailDrawing drawing;
+    drawing.width = int(fr.width() * mag);
+    drawing.height = int(fr.height() * mag);
+    drawing.dpm = lrint(DPMM * 1000.0);
+    drawing.backgroundColor = configuration()->thumbnailBackgroundColor();
 
     double pr = MScore::pixelRatio;
     MScore::pixelRatio = 1.0;
 
-    auto painterProvider = imageProvider()->painterForImage(pixmap);
-    mu::draw::Painter p(painterProvider, "thumbnail");
+    auto buffer = std::make_shared<mu::draw::BufferedPaintProvider>();
+    {
+        mu::draw::Painter p(buffer, "thumbnail");
 
-    p.setAntialiasing(true);
-    p.scale(mag, mag);
-    print(&p, 0);
-    p.endDraw();
+        p.setAntialiasing(true);
+        p.scale(mag, mag);
+        print(&p, 0);
+        p.endDraw();
+    }
+    drawing.data = std::make_shared<mu::draw::DrawData>(buffer->drawData());
 
     MScore::pixelRatio = pr;
 
@@ -301,6 +317,29 @@ std::shared_ptr<mu::draw::Pixmap> Score::createThumbnail()
         setLayoutMode(mode);
         doLayout();
     }
+    return drawing;
+}
+
+//---------------------------------------------------------
+//   renderThumbnail
+//    doesn't touch the score, so can be called in any thread
+//---------------------------------------------------------
+
+std::shared_ptr<mu::draw::Pixmap> Score::renderThumbnail(std::shared_ptr<mu::draw::IImageProvider> imageProvider,
+                                                         const ThumbnailDrawing& drawing)
+{
+    TRACEFUNC;
+
+    auto pixmap = imageProvider->createPixmap(drawing.width, drawing.height, drawing.dpm, drawing.backgroundColor);
+
+    auto painterProvider = imageProvider->painterForImage(pixmap);
+    mu::draw::Painter p(painterProvider, "thumbnail");
+
+    if (drawing.data) {
+        mu::draw::DrawDataPaint::paint(&p, *drawing.data);
+    }
+    p.endDraw();
+
     return pixmap;
 }
 
@@ -21,6 +21,9 @@
  */
 
 #include "sig.h"
+
+#include <algorithm>
+
 #include "rw/xml.h"
 
 #include "log.h"
@@ -222,6 +225,33 @@ bool SigEvent::operator==(const SigEvent& e) const
     return _timesig.identical(e._timesig);
 }
 
+//---------------------------------------------------------
+//   TimeSigMap
+//---------------------------------------------------------
+
+TimeSigMap::TimeSigMap(const TimeSigMap& other)
+    : std::map<int, SigEvent>(other)
+{
+    updateIndex();
+}
+
+TimeSigMap& TimeSigMap::operator=(const TimeSigMap& other)
+{
+    std::map<int, SigEvent>::operator=(other);
+    updateIndex();
+    return *this;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void TimeSigMap::clear()
+{
+    std::map<int, SigEvent>::clear();
+    updateIndex();
+}
+
 //---------------------------------------------------------
 //   add
 //---------------------------------------------------------
@@ -287,6 +317,29 @@ void TimeSigMap::normalize()
         tick = i->first;
         tm   = ticks_measure(e.timesig());
     }
+    updateIndex();
+}
+
+//---------------------------------------------------------
+//   TimeSigMap::updateIndex
+//---------------------------------------------------------
+
+void TimeSigMap::updateIndex()
+{
+    std::vector<int> ticks;
+    ticks.reserve(size());
+    _events.clear();
+    _events.reserve(size());
+    _bars.clear();
+    _bars.reserve(size());
+
+    for (auto i = begin(); i != end(); ++i) {
+        ticks.push_back(i->first);
+        _events.push_back(&i->second);
+        _bars.push_back(i->second.bar());
+    }
+
+    _index.build(std::move(ticks));
 }
 
 //---------------------------------------------------------
@@ -299,11 +352,8 @@ const SigEvent& TimeSigMap::timesig(int tick) const
     if (empty()) {
         return ev;
     }
-    auto i = upper_bound(tick);
-    if (i != begin()) {
-        --i;
-    }
-    return i->second;
+    const int idx = _index.indexAt(tick);
+    return *_events[idx < 0 ? 0 : idx];
 }
 
 //---------------------------------------------------------
@@ -324,22 +374,23 @@ void TimeSigMap::tickValues(int t, int* bar, int* beat, int* tick) const
         *tick = 0;
         return;
     }
-    auto e = upper_bound(t);
-    if (empty() || e == begin()) {
+    int idx = _index.indexAt(t);
+    if (idx < 0) {
         ASSERT_X(String(u"tickValue(0x%1) not found").arg(t));
+        idx = 0;
     }
-    --e;
-    int delta  = t - e->first;
-    int ticksB = ticks_beat(e->second.timesig().denominator());   // ticks in beat
-    int ticksM = ticksB * e->second.timesig().numerator();        // ticks in measure (bar)
+    const SigEvent& e = *_events[idx];
+    int delta  = t - _index.tick(idx);
+    int ticksB = ticks_beat(e.timesig().denominator());   // ticks in beat
+    int ticksM = ticksB * e.timesig().numerator();        // ticks in measure (bar)
     if (ticksM == 0) {
-        LOGD("TimeSigMap::tickValues: at %d %s", t, muPrintable(e->second.timesig().toString()));
+        LOGD("TimeSigMap::tickValues: at %d %s", t, muPrintable(e.timesig().toString()));
         *bar  = 0;
         *beat = 0;
         *tick = 0;
         return;
     }
-    *bar       = e->second.bar() + delta / ticksM;
+    *bar       = e.bar() + delta / ticksM;
     int rest   = delta % ticksM;
     *beat      = rest / ticksB;
     *tick      = rest % ticksB;
@@ -368,24 +419,19 @@ int TimeSigMap::bar2tick(int bar, int beat) const
 {
     // bar - index of current bar (terminology: bar == measure)
     // beat - index of beat in current bar
-    auto e = begin();
-
-    for (; e != end(); ++e) {
-        if (bar < e->second.bar()) {
-            break;
-        }
-    }
-    if (empty() || e == begin()) {
+    // the bars are ascending, find the first event after the bar
+    const size_t idx = std::upper_bound(_bars.cbegin(), _bars.cend(), bar) - _bars.cbegin();
+    if (empty() || idx == 0) {
         LOGD("TimeSigMap::bar2tick(): not found(%d,%d) not found", bar, beat);
         if (empty()) {
             LOGD("   list is empty");
         }
         return 0;
     }
-    --e;   // current TimeSigMap value
-    int ticksB = ticks_beat(e->second.timesig().denominator());   // ticks per beat
-    int ticksM = ticksB * e->second.timesig().numerator();        // bar length in ticks
-    return e->first + (bar - e->second.bar()) * ticksM + ticksB * beat;
+    const SigEvent& e = *_events[idx - 1];   // current TimeSigMap value
+    int ticksB = ticks_beat(e.timesig().denominator());   // ticks per beat
+    int ticksM = ticksB * e.timesig().numerator();        // bar length in ticks
+    return _index.tick(idx - 1) + (bar - e.bar()) * ticksM + ticksB * beat;
 }
 
 //---------------------------------------------------------
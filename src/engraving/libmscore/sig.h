@@ -24,12 +24,15 @@
 #define __AL_SIG_H__
 
 #include <map>
+#include <vector>
 #include <cassert>
 
 #include "global/allocator.h"
 #include "types/string.h"
 #include "types/fraction.h"
 
+#include "tickindex.h"
+
 namespace mu::engraving {
 class XmlWriter;
 class XmlReader;
@@ -145,10 +148,20 @@ class TimeSigMap : public std::map<int, SigEvent>
 {
     OBJECT_ALLOCATOR(engraving, TimeSigMap)
 
+    //! NOTE Flat index of the events for the lookups, rebuilt on every change
+    TickIndex _index;
+    std::vector<const SigEvent*> _events;
+    std::vector<int> _bars;
+
     void normalize();
+    void updateIndex();
 
 public:
     TimeSigMap() {}
+    TimeSigMap(const TimeSigMap& other);
+    TimeSigMap& operator=(const TimeSigMap& other);
+
+    void clear();
 
     void add(int tick, const Fraction&);
     void add(int tick, const SigEvent& ev);
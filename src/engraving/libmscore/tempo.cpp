@@ -22,6 +22,7 @@
 
 #include "tempo.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "rw/xml.h"
@@ -130,9 +131,35 @@ void TempoMap::normalize()
         tick  = e->first;
         tempo = e->second.tempo.val;
     }
+    updateIndex();
     ++_tempoSN;
 }
 
+//---------------------------------------------------------
+//   TempoMap::updateIndex
+//---------------------------------------------------------
+
+void TempoMap::updateIndex()
+{
+    std::vector<int> ticks;
+    ticks.reserve(size());
+    _tempos.clear();
+    _tempos.reserve(size());
+    _times.clear();
+    _times.reserve(size());
+    _pauses.clear();
+    _pauses.reserve(size());
+
+    for (auto e = begin(); e != end(); ++e) {
+        ticks.push_back(e->first);
+        _tempos.push_back(e->second.tempo);
+        _times.push_back(e->second.time);
+        _pauses.push_back(e->second.pause);
+    }
+
+    _index.build(std::move(ticks));
+}
+
 //---------------------------------------------------------
 //   TempoMap::dump
 //---------------------------------------------------------
@@ -153,6 +180,7 @@ void TempoMap::dump() const
 void TempoMap::clear()
 {
     std::map<int, TEvent>::clear();
+    updateIndex();
     ++_tempoSN;
 }
 
@@ -170,6 +198,7 @@ void TempoMap::clearRange(int tick1, int tick2)
         return;
     }
     erase(first, last);
+    updateIndex();
     ++_tempoSN;
 }
 
@@ -179,30 +208,10 @@ void TempoMap::clearRange(int tick1, int tick2)
 
 BeatsPerSecond TempoMap::tempo(int tick) const
 {
-    auto findTempo = [this](int tick) -> BeatsPerSecond {
-        if (empty()) {
-            return 2.0;
-        }
+    const int idx = _index.indexAt(tick);
+    const BeatsPerSecond tempo = idx < 0 ? BeatsPerSecond(2.0) : _tempos[idx];
 
-        auto i = lower_bound(tick);
-        if (i == end()) {
-            --i;
-            return i->second.tempo;
-        }
-
-        if (i->first == tick) {
-            return i->second.tempo;
-        }
-
-        if (i == begin()) {
-            return 2.0;
-        }
-
-        --i;
-        return i->second.tempo;
-    };
-
-    return findTempo(tick) * _tempoMultiplier;
+    return tempo * _tempoMultiplier;
 }
 
 //---------------------------------------------------------
@@ -292,23 +301,11 @@ double TempoMap::tick2time(int tick, int* sn) const
 
     if (!empty()) {
         int ptick  = 0;
-        auto e = lower_bound(tick);
-        if (e == end()) {
-            auto pe = e;
-            --pe;
-            ptick = pe->first;
-            tempo = pe->second.tempo;
-            time  = pe->second.time;
-        } else if (e->first == tick) {
-            ptick = tick;
-            tempo = e->second.tempo;
-            time  = e->second.time;
-        } else if (e != begin()) {
-            auto pe = e;
-            --pe;
-            ptick = pe->first;
-            tempo = pe->second.tempo;
-            time  = pe->second.time;
+        const int idx = _index.indexAt(tick);
+        if (idx >= 0) {
+            ptick = _index.tick(idx);
+            tempo = _tempos[idx];
+            time  = _times[idx];
         }
         delta = double(tick - ptick);
     } else {
@@ -328,23 +325,19 @@ double TempoMap::tick2time(int tick, int* sn) const
 int TempoMap::time2tick(double time, int* sn) const
 {
     int tick     = 0;
-    double delta = time;
-    BeatsPerSecond tempo = _tempo;
+    double delta = 0.0;
+    BeatsPerSecond tempo = 2.0;
 
-    delta = 0.0;
-    tempo = 2.0;
-    for (auto e = begin(); e != end(); ++e) {
-        // if in a pause period, wait on previous tick
-        if ((time <= e->second.time) && (time > e->second.time - e->second.pause)) {
-            delta = (time - (e->second.time - e->second.pause) + delta);
-            break;
-        }
-        if (e->second.time >= time) {
-            break;
-        }
-        delta = e->second.time;
-        tick  = e->first;
-        tempo = e->second.tempo;
+    // the times are ascending, find the first event that is not before the time
+    const size_t idx = std::lower_bound(_times.cbegin(), _times.cend(), time) - _times.cbegin();
+    if (idx > 0) {
+        delta = _times[idx - 1];
+        tick  = _index.tick(idx - 1);
+        tempo = _tempos[idx - 1];
+    }
+    // if in a pause period, wait on previous tick
+    if (idx < _times.size() && time > _times[idx] - _pauses[idx]) {
+        delta = (time - (_times[idx] - _pauses[idx]) + delta);
     }
     delta = time - delta;
     tick += lrint(delta * _tempoMultiplier.val * Constants::division * tempo.val);
@@ -353,4 +346,39 @@ int TempoMap::time2tick(double time, int* sn) const
     }
     return tick;
 }
+
+//---------------------------------------------------------
+//   tick2time
+//    batched version, avoids the per call overhead when
+//    converting many ticks at once
+//---------------------------------------------------------
+
+std::vector<double> TempoMap::tick2time(const std::vector<int>& ticks) const
+{
+    std::vector<double> times;
+    times.reserve(ticks.size());
+
+    for (int tick : ticks) {
+        times.push_back(tick2time(tick));
+    }
+
+    return times;
+}
+
+//---------------------------------------------------------
+//   time2tick
+//    batched version of time2tick
+//---------------------------------------------------------
+
+std::vector<int> TempoMap::time2tick(const std::vector<double>& times) const
+{
+    std::vector<int> ticks;
+    ticks.reserve(times.size());
+
+    for (double time : times) {
+        ticks.push_back(time2tick(time));
+    }
+
+    return ticks;
+}
 }
@@ -24,12 +24,15 @@
 #define __AL_TEMPO_H__
 
 #include <map>
+#include <vector>
 
 #include "global/allocator.h"
 #include "global/async/notification.h"
 #include "types/flags.h"
 #include "types/types.h"
 
+#include "tickindex.h"
+
 namespace mu::engraving {
 class XmlWriter;
 
@@ -77,7 +80,14 @@ class TempoMap : public std::map<int, TEvent>
     BeatsPerSecond _tempoMultiplier;
     async::Notification _tempoMultiplierChanged;
 
+    //! NOTE Flat copy of the events for the lookups, rebuilt on every change
+    TickIndex _index;
+    std::vector<BeatsPerSecond> _tempos;
+    std::vector<double> _times;
+    std::vector<double> _pauses;
+
     void normalize();
+    void updateIndex();
     void del(int tick);
 
 public:
@@ -94,6 +104,8 @@ public:
     double tick2time(int tick, double time, int* sn) const;
     int time2tick(double time, int* sn = 0) const;
     int time2tick(double time, int tick, int* sn) const;
+    std::vector<double> tick2time(const std::vector<int>& ticks) const;
+    std::vector<int> time2tick(const std::vector<double>& times) const;
     int tempoSN() const { return _tempoSN; }
 
     void setTempo(int t, BeatsPerSecond);
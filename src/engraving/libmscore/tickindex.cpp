@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "tickindex.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace mu::engraving {
+//---------------------------------------------------------
+//   build
+//    ticks must be sorted and unique
+//---------------------------------------------------------
+
+void TickIndex::build(std::vector<int>&& ticks)
+{
+    _ticks = std::move(ticks);
+    _bucketStarts.clear();
+
+    if (_ticks.empty()) {
+        _bucketTicks = 1;
+        return;
+    }
+
+    // about two buckets per event, so that a bucket rarely holds more than one event
+    const int64_t range = int64_t(_ticks.back()) - _ticks.front();
+    _bucketTicks = static_cast<int>(range / int64_t(2 * _ticks.size()) + 1);
+
+    const size_t bucketCount = static_cast<size_t>(range / _bucketTicks) + 1;
+    _bucketStarts.resize(bucketCount);
+
+    size_t idx = 0;
+    for (size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        const int64_t bucketStart = _ticks.front() + int64_t(bucket) * _bucketTicks;
+        while (idx < _ticks.size() && _ticks[idx] < bucketStart) {
+            ++idx;
+        }
+        _bucketStarts[bucket] = idx;
+    }
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void TickIndex::clear()
+{
+    _ticks.clear();
+    _bucketStarts.clear();
+    _bucketTicks = 1;
+}
+
+//---------------------------------------------------------
+//   indexAt
+//---------------------------------------------------------
+
+int TickIndex::indexAt(int tick) const
+{
+    if (_ticks.empty() || tick < _ticks.front()) {
+        return -1;
+    }
+
+    const size_t bucket = static_cast<size_t>((int64_t(tick) - _ticks.front()) / _bucketTicks);
+    if (bucket >= _bucketStarts.size()) {
+        return static_cast<int>(_ticks.size()) - 1;
+    }
+
+    // events before the bucket are before the tick, events of the next buckets are after it
+    auto first = _ticks.cbegin() + _bucketStarts[bucket];
+    auto last = (bucket + 1 < _bucketStarts.size()) ? _ticks.cbegin() + _bucketStarts[bucket + 1] : _ticks.cend();
+
+    return static_cast<int>(std::upper_bound(first, last, tick) - _ticks.cbegin()) - 1;
+}
+}
@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_ENGRAVING_TICKINDEX_H
+#define MU_ENGRAVING_TICKINDEX_H
+
+#include <vector>
+
+namespace mu::engraving {
+//---------------------------------------------------------
+//   TickIndex
+///   Flat lookup structure for the event ticks of a tick
+///   keyed map (tempo map, time signature map).
+///   The ticks are split into equally sized buckets, so a
+///   lookup only has to search the events of one bucket.
+///   It must be rebuilt whenever the map changes.
+//---------------------------------------------------------
+
+class TickIndex
+{
+public:
+    void build(std::vector<int>&& ticks);
+    void clear();
+
+    bool empty() const { return _ticks.empty(); }
+    size_t size() const { return _ticks.size(); }
+    int tick(size_t idx) const { return _ticks[idx]; }
+
+    //! Returns the index of the last event at or before the tick, -1 if there is none
+    int indexAt(int tick) const;
+
+private:
+    std::vector<int> _ticks;
+    std::vector<size_t> _bucketStarts; // index of the first event of each bucket
+    int _bucketTicks = 1;
+};
+}
+
+#endif // MU_ENGRAVING_TICKINDEX_H
@@ -350,7 +350,10 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
         LOG_UNDO() << cmd->name();
     }
 #endif
-    curCmd->appendChild(cmd);
+    {
+        MEMORY_TAG_SCOPE(Undo);
+        curCmd->appendChild(cmd);
+    }
     cmd->redo(ed);
 }
 
@@ -366,6 +369,7 @@ void UndoStack::push1(UndoCommand* cmd)
         }
         return;
     }
+    MEMORY_TAG_SCOPE(Undo);
     curCmd->appendChild(cmd);
 }
 
@@ -454,6 +458,7 @@ void UndoStack::endMacro(bool rollback)
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
+        MEMORY_TAG_SCOPE(Undo);
         list.push_back(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
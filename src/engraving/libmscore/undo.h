@@ -117,6 +117,12 @@ public:
     };
 
     virtual ~UndoCommand();
+
+    //! NOTE The commands and the lists of the undo history that keep them are charged to their own
+    //! memory tag, whoever creates them. What a command holds (e.g. removed elements or copied data)
+    //! is charged to the tag that was current when it was allocated, so "undo" is a lower bound
+    static MemoryTag objectMemoryTag() { return MemoryTag::Undo; }
+
     virtual void undo(EditData*);
     virtual void redo(EditData*);
     void appendChild(UndoCommand* cmd) { childList.push_back(cmd); }
@@ -32,6 +32,8 @@
 #include "libmscore/tempo.h"
 #include "libmscore/measurerepeat.h"
 
+#include "editlatencyprobe.h"
+#include "memoryaccounting.h"
 #include "log.h"
 
 using namespace mu;
@@ -57,6 +59,9 @@ static const Harmony* findChordSymbol(const EngravingItem* item)
 
 void PlaybackModel::load(Score* score)
 {
+    TRACEFUNC;
+    MEMORY_TAG_SCOPE(Playback);
+
     if (!score || score->measures()->empty() || !score->lastMeasure()) {
         return;
     }
@@ -97,6 +102,8 @@ void PlaybackModel::load(Score* score)
 
 void PlaybackModel::reload()
 {
+    TRACEFUNC;
+
     int trackFrom = 0;
     size_t trackTo = m_score->ntracks();
 
@@ -409,6 +416,8 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                                  ChangedTrackIdSet* trackChanges)
 {
     TRACEFUNC;
+    MEMORY_TAG_SCOPE(Playback);
+    EDIT_LATENCY_PHASE(Playback);
 
     std::set<staff_idx_t> changedStaffIdSet = m_score->staffIdsFromRange(trackFrom, trackTo);
 
@@ -22,6 +22,8 @@
 
 #include "xmlwriter.h"
 
+#include <charconv>
+
 #include "types/typesconv.h"
 #include "rw/writecontext.h"
 #include "libmscore/engravingitem.h"
@@ -309,7 +311,14 @@ void XmlWriter::tagFraction(const AsciiStringView& name, const Fraction& v, cons
         return;
     }
 
-    element(name, v.toString());
+    //! NOTE Written as "numerator/denominator" without creating a String
+    char buf[32];
+    char* end = buf + sizeof(buf);
+    std::to_chars_result res = std::to_chars(buf, end, v.numerator());
+    *res.ptr++ = '/';
+    res = std::to_chars(res.ptr, end, v.denominator());
+
+    element(name, AsciiStringView(buf, res.ptr - buf));
 }
 
 void XmlWriter::writeXml(const String& name, String s)
@@ -50,6 +50,8 @@ public:
 
     void tag(const AsciiStringView& name, const Attributes& attrs = {});
     void tag(const AsciiStringView& name, const Value& body);
+    template<typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+    void tag(const AsciiStringView& name, T body) { XmlStreamWriter::element(name, body); }
     void tag(const AsciiStringView& name, const Value& val, const Value& def);
     void tag(const AsciiStringView& name, const Attributes& attrs, const Value& body);
     void tagRaw(const String& elementWithAttrs, const Value& body = Value());
@@ -22,6 +22,8 @@
 
 #include "style.h"
 
+#include <unordered_map>
+
 #include "compat/pageformat.h"
 #include "rw/compat/readchordlisthook.h"
 #include "rw/xml.h"
@@ -104,81 +106,99 @@ int MStyle::defaultStyleVersion() const
     return styleI(Sid::defaultsVersion);
 }
 
+//! NOTE There are more than a thousand style values,
+//! so they are looked up by name through an index instead of a linear search
+static Sid styleIdxByName(const std::string_view& name)
+{
+    static const std::unordered_map<std::string_view, Sid> index = []() {
+        std::unordered_map<std::string_view, Sid> idx;
+        idx.reserve(StyleDef::styleValues.size());
+        for (const StyleDef::StyleValue& st : StyleDef::styleValues) {
+            idx.emplace(std::string_view(st.name().ascii(), st.name().size()), st.styleIdx());
+        }
+        return idx;
+    }();
+
+    auto it = index.find(name);
+    if (it != index.end()) {
+        return it->second;
+    }
+    return Sid::NOSTYLE;
+}
+
 bool MStyle::readProperties(XmlReader& e)
 {
     const AsciiStringView tag(e.name());
 
-    for (const StyleDef::StyleValue& t : StyleDef::styleValues) {
-        Sid idx = t.styleIdx();
-        if (t.name() == tag) {
-            P_TYPE type = t.valueType();
-            switch (type) {
-            case P_TYPE::SPATIUM:
-                set(idx, Spatium(e.readDouble()));
-                break;
-            case P_TYPE::REAL:
-                set(idx, e.readDouble());
-                break;
-            case P_TYPE::BOOL:
-                set(idx, bool(e.readInt()));
-                break;
-            case P_TYPE::INT:
-                set(idx, e.readInt());
-                break;
-            case P_TYPE::DIRECTION_V:
-                set(idx, DirectionV(e.readInt()));
-                break;
-            case P_TYPE::STRING:
-                set(idx, e.readText());
-                break;
-            case P_TYPE::ALIGN: {
-                Align align = TConv::fromXml(e.readText(), Align());
-                set(idx, align);
-            } break;
-            case P_TYPE::POINT: {
-                double x = e.doubleAttribute("x", 0.0);
-                double y = e.doubleAttribute("y", 0.0);
-                set(idx, PointF(x, y));
-                e.readText();
-            } break;
-            case P_TYPE::SIZE: {
-                double x = e.doubleAttribute("w", 0.0);
-                double y = e.doubleAttribute("h", 0.0);
-                set(idx, SizeF(x, y));
-                e.readText();
-            } break;
-            case P_TYPE::SCALE: {
-                double sx = e.doubleAttribute("w", 0.0);
-                double sy = e.doubleAttribute("h", 0.0);
-                set(idx, ScaleF(sx, sy));
-                e.readText();
-            } break;
-            case P_TYPE::COLOR: {
-                mu::draw::Color c;
-                c.setRed(e.intAttribute("r"));
-                c.setGreen(e.intAttribute("g"));
-                c.setBlue(e.intAttribute("b"));
-                c.setAlpha(e.intAttribute("a", 255));
-                set(idx, c);
-                e.readText();
-            } break;
-            case P_TYPE::PLACEMENT_V:
-                set(idx, PlacementV(e.readText().toInt()));
-                break;
-            case P_TYPE::PLACEMENT_H:
-                set(idx, PlacementH(e.readText().toInt()));
-                break;
-            case P_TYPE::HOOK_TYPE:
-                set(idx, HookType(e.readText().toInt()));
-                break;
-            case P_TYPE::LINE_TYPE:
-                set(idx, TConv::fromXml(e.readAsciiText(), LineType::SOLID));
-                break;
-            default:
-                ASSERT_X(u"unhandled type " + String::number(int(type)));
-            }
-            return true;
+    const Sid idx = styleIdxByName(std::string_view(tag.ascii(), tag.size()));
+    if (idx != Sid::NOSTYLE) {
+        P_TYPE type = StyleDef::styleValues[size_t(idx)].valueType();
+        switch (type) {
+        case P_TYPE::SPATIUM:
+            set(idx, Spatium(e.readDouble()));
+            break;
+        case P_TYPE::REAL:
+            set(idx, e.readDouble());
+            break;
+        case P_TYPE::BOOL:
+            set(idx, bool(e.readInt()));
+            break;
+        case P_TYPE::INT:
+            set(idx, e.readInt());
+            break;
+        case P_TYPE::DIRECTION_V:
+            set(idx, DirectionV(e.readInt()));
+            break;
+        case P_TYPE::STRING:
+            set(idx, e.readText());
+            break;
+        case P_TYPE::ALIGN: {
+            Align align = TConv::fromXml(e.readText(), Align());
+            set(idx, align);
+        } break;
+        case P_TYPE::POINT: {
+            double x = e.doubleAttribute("x", 0.0);
+            double y = e.doubleAttribute("y", 0.0);
+            set(idx, PointF(x, y));
+            e.readText();
+        } break;
+        case P_TYPE::SIZE: {
+            double x = e.doubleAttribute("w", 0.0);
+            double y = e.doubleAttribute("h", 0.0);
+            set(idx, SizeF(x, y));
+            e.readText();
+        } break;
+        case P_TYPE::SCALE: {
+            double sx = e.doubleAttribute("w", 0.0);
+            double sy = e.doubleAttribute("h", 0.0);
+            set(idx, ScaleF(sx, sy));
+            e.readText();
+        } break;
+        case P_TYPE::COLOR: {
+            mu::draw::Color c;
+            c.setRed(e.intAttribute("r"));
+            c.setGreen(e.intAttribute("g"));
+            c.setBlue(e.intAttribute("b"));
+            c.setAlpha(e.intAttribute("a", 255));
+            set(idx, c);
+            e.readText();
+        } break;
+        case P_TYPE::PLACEMENT_V:
+            set(idx, PlacementV(e.readText().toInt()));
+            break;
+        case P_TYPE::PLACEMENT_H:
+            set(idx, PlacementH(e.readText().toInt()));
+            break;
+        case P_TYPE::HOOK_TYPE:
+            set(idx, HookType(e.readText().toInt()));
+            break;
+        case P_TYPE::LINE_TYPE:
+            set(idx, TConv::fromXml(e.readAsciiText(), LineType::SOLID));
+            break;
+        default:
+            ASSERT_X(u"unhandled type " + String::number(int(type)));
         }
+        return true;
     }
     if (readStyleValCompat(e)) {
         return true;
@@ -420,10 +440,5 @@ const char* MStyle::valueName(const Sid i)
 Sid MStyle::styleIdx(const String& name)
 {
     ByteArray ba = name.toAscii();
-    for (const StyleDef::StyleValue& st : StyleDef::styleValues) {
-        if (st.name() == ba.constChar()) {
-            return st.styleIdx();
-        }
-    }
-    return Sid::NOSTYLE;
+    return styleIdxByName(std::string_view(ba.constChar(), ba.size()));
 }
@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "benchmarkreport.h"
+
+#include <algorithm>
+
+#include "io/file.h"
+#include "version.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving::benchmarks;
+
+void BenchmarkReport::addSample(const std::string& score, const std::string& step, const Sample& sample)
+{
+    auto it = std::find_if(m_steps.begin(), m_steps.end(), [&score, &step](const Step& s) {
+        return s.score == score && s.name == step;
+    });
+
+    if (it == m_steps.end()) {
+        m_steps.push_back({ score, step, {} });
+        it = std::prev(m_steps.end());
+    }
+
+    it->samples.push_back(sample);
+
+    LOGI() << score << " | " << step << " | " << sample.timeMs << " ms | "
+           << sample.allocations << " allocations | " << sample.peakRssKb << " KB peak RSS";
+}
+
+JsonObject BenchmarkReport::toJson() const
+{
+    JsonArray results;
+
+    for (const Step& step : m_steps) {
+        std::vector<Sample> samples = step.samples;
+        std::sort(samples.begin(), samples.end(), [](const Sample& s1, const Sample& s2) {
+            return s1.timeMs < s2.timeMs;
+        });
+
+        const Sample& median = samples.at(samples.size() / 2);
+        uint64_t peakRssKb = 0;
+        for (const Sample& sample : samples) {
+            peakRssKb = std::max(peakRssKb, sample.peakRssKb);
+        }
+
+        JsonObject result;
+        result["score"] = step.score;
+        result["step"] = step.name;
+        result["runs"] = static_cast<int>(samples.size());
+        result["timeMs"] = median.timeMs;
+        result["minTimeMs"] = samples.front().timeMs;
+        result["maxTimeMs"] = samples.back().timeMs;
+        result["allocations"] = static_cast<double>(median.allocations);
+        result["peakRssKb"] = static_cast<double>(peakRssKb);
+
+        results << result;
+    }
+
+    JsonObject root;
+    root["version"] = framework::Version::fullVersion();
+    root["revision"] = framework::Version::revision();
+    root["results"] = results;
+
+    return root;
+}
+
+bool BenchmarkReport::save(const io::path_t& path) const
+{
+    Ret ret = io::File::writeFile(path, JsonDocument(toJson()).toJson(JsonDocument::Format::Indented));
+    if (!ret) {
+        LOGE() << "failed write benchmark report to: " << path << ", err: " << ret.toString();
+        return false;
+    }
+
+    LOGI() << "benchmark report: " << path;
+    return true;
+}
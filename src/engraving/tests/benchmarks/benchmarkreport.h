@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_BENCHMARKREPORT_H
+#define MU_ENGRAVING_BENCHMARKREPORT_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "io/path.h"
+#include "serialization/json.h"
+
+#include "memorystats.h"
+
+namespace mu::engraving::benchmarks {
+class BenchmarkReport
+{
+public:
+    struct Sample {
+        double timeMs = 0.0;
+        uint64_t allocations = 0;
+        uint64_t peakRssKb = 0;
+    };
+
+    template<typename Func>
+    static Sample run(Func&& func)
+    {
+        MemoryStats::resetPeakRss();
+        const uint64_t allocationsBefore = MemoryStats::allocationsCount();
+        const auto start = std::chrono::steady_clock::now();
+
+        func();
+
+        Sample sample;
+        sample.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        sample.allocations = MemoryStats::allocationsCount() - allocationsBefore;
+        sample.peakRssKb = MemoryStats::peakRssKb();
+
+        return sample;
+    }
+
+    template<typename Func>
+    void measure(const std::string& score, const std::string& step, Func&& func)
+    {
+        addSample(score, step, run(func));
+    }
+
+    void addSample(const std::string& score, const std::string& step, const Sample& sample);
+
+    //! NOTE Every step is reported with the median time of its runs,
+    //! the allocations of the median run and the highest peak RSS
+    JsonObject toJson() const;
+    bool save(const io::path_t& path) const;
+
+private:
+    struct Step {
+        std::string score;
+        std::string name;
+        std::vector<Sample> samples;
+    };
+
+    std::vector<Step> m_steps;
+};
+}
+
+#endif // MU_ENGRAVING_BENCHMARKREPORT_H
@@ -0,0 +1,307 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include <QBuffer>
+#include <QDir>
+#include <QImage>
+#include <QPdfWriter>
+
+#include "io/buffer.h"
+#include "io/file.h"
+
+#include "engraving/compat/mscxcompat.h"
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/infrastructure/localfileinfoprovider.h"
+#include "engraving/infrastructure/mscreader.h"
+#include "engraving/infrastructure/mscwriter.h"
+#include "engraving/infrastructure/paint.h"
+#include "engraving/rw/scorereader.h"
+#include "engraving/playback/playbackmodel.h"
+
+#include "libmscore/chord.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/note.h"
+#include "libmscore/segment.h"
+
+#include "mpe/tests/mocks/articulationprofilesrepositorymock.h"
+
+#include "benchmarkreport.h"
+
+#include "log.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::_;
+
+using namespace mu;
+using namespace mu::io;
+using namespace mu::engraving;
+using namespace mu::engraving::benchmarks;
+
+//! NOTE The curated set of large scores, can be replaced with any directory of scores
+//! by MU_BENCHMARK_SCORES_DIR. MU_BENCHMARK_RUNS sets the runs per score (3 by default),
+//! MU_BENCHMARK_OUTPUT the path of the JSON report
+static const std::vector<std::string> BENCHMARK_SCORES = {
+    "Fugue_1.mscx",
+    "Dawn.mscx",
+    "Brassed_Up.mscx",
+    "Dynamic_Strings.mscx",
+    "goldberg.mscz"
+};
+
+static constexpr size_t EDITS_COUNT = 10;
+static constexpr int EXPORT_DPI = 300;
+
+static std::string envValue(const char* name, const std::string& def)
+{
+    const char* value = std::getenv(name);
+    return value && value[0] ? std::string(value) : def;
+}
+
+class Engraving_Benchmarks : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_profilesRepository = std::make_shared<NiceMock<mpe::ArticulationProfilesRepositoryMock> >();
+        ON_CALL(*m_profilesRepository, defaultProfile(_)).WillByDefault(Return(std::make_shared<mpe::ArticulationsProfile>()));
+    }
+
+    std::vector<path_t> scorePaths() const
+    {
+        std::string dir = envValue("MU_BENCHMARK_SCORES_DIR", "");
+        if (dir.empty()) {
+            std::vector<path_t> paths;
+            for (const std::string& name : BENCHMARK_SCORES) {
+                paths.push_back(path_t(engraving_benchmarks_SCORES_DIR) + "/" + path_t(name));
+            }
+            return paths;
+        }
+
+        std::vector<path_t> paths;
+        QDir scoresDir(QString::fromStdString(dir));
+        for (const QString& name : scoresDir.entryList({ "*.mscz", "*.mscx" }, QDir::Files, QDir::Name)) {
+            paths.push_back(scoresDir.absoluteFilePath(name));
+        }
+        return paths;
+    }
+
+    void benchmarkScore(const path_t& path, BenchmarkReport& report)
+    {
+        const std::string name = io::filename(path).toStdString();
+
+        ByteArray msczData;
+        if (io::suffix(path) == "mscx") {
+            ASSERT_EQ(compat::mscxToMscz(path.toString(), &msczData), Err::NoError);
+        } else {
+            File msczFile(path);
+            ASSERT_TRUE(msczFile.open(IODevice::ReadOnly)) << name;
+            msczData = msczFile.readAll();
+        }
+
+        MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+        score->setFileInfoProvider(std::make_shared<LocalFileInfoProvider>(path));
+
+        Err err = Err::NoError;
+        report.measure(name, "load", [&]() {
+            Buffer msczBuf(&msczData);
+            MscReader::Params params;
+            params.device = &msczBuf;
+            params.filePath = path.toString();
+            params.mode = MscIoMode::Zip;
+
+            MscReader reader(params);
+            reader.open();
+
+            ScoreReader scoreReader;
+            err = scoreReader.loadMscz(score, reader, true);
+        });
+        ASSERT_EQ(err, Err::NoError) << name;
+
+        report.measure(name, "layout", [&]() {
+            for (Score* s : score->scoreList()) {
+                s->doLayout();
+            }
+        });
+
+        benchmarkEdits(name, score, report);
+
+        report.measure(name, "save", [&]() {
+            ByteArray data;
+            Buffer buf(&data);
+            MscWriter::Params params;
+            params.device = &buf;
+            params.filePath = path.toString();
+            params.mode = MscIoMode::Zip;
+
+            MscWriter writer(params);
+            writer.open();
+            score->writeMscz(writer, false, false);
+            writer.close();
+        });
+
+        report.measure(name, "playbackModelLoad", [&]() {
+            PlaybackModel model;
+            model.setprofilesRepository(m_profilesRepository);
+            model.load(score);
+        });
+
+        report.measure(name, "pdfExport", [&]() {
+            exportPdf(score);
+        });
+
+        report.measure(name, "pngExport", [&]() {
+            exportPng(score);
+        });
+
+        delete score;
+    }
+
+    //! NOTE Moves evenly spaced notes of the top staff a semitone up, one undoable command each,
+    //! so every command relayouts only the range around the note, as when editing in the app.
+    //! The edits of a run are summed into one sample, so the step has one sample per run like the others
+    void benchmarkEdits(const std::string& name, MasterScore* score, BenchmarkReport& report)
+    {
+        std::vector<Chord*> chords;
+        for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+            EngravingItem* item = s->element(0);
+            if (item && item->isChord()) {
+                chords.push_back(toChord(item));
+            }
+        }
+
+        if (chords.empty()) {
+            return;
+        }
+
+        BenchmarkReport::Sample total;
+
+        const size_t editsCount = std::min(EDITS_COUNT, chords.size());
+        for (size_t i = 0; i < editsCount; ++i) {
+            Chord* chord = chords.at(i * chords.size() / editsCount);
+            score->select(chord->upNote());
+
+            BenchmarkReport::Sample sample = BenchmarkReport::run([score]() {
+                score->startCmd();
+                score->upDown(true, UpDownMode::CHROMATIC);
+                score->endCmd();
+            });
+
+            total.timeMs += sample.timeMs;
+            total.allocations += sample.allocations;
+            total.peakRssKb = std::max(total.peakRssKb, sample.peakRssKb);
+        }
+
+        score->deselectAll();
+
+        report.addSample(name, "relayoutAfterEdits", total);
+    }
+
+    void exportPdf(Score* score)
+    {
+        QBuffer pdfData;
+        pdfData.open(QIODevice::WriteOnly);
+
+        QPdfWriter pdfWriter(&pdfData);
+        pdfWriter.setResolution(EXPORT_DPI);
+        pdfWriter.setPageMargins(QMarginsF());
+        pdfWriter.setPageLayout(QPageLayout(QPageSize(Paint::pageSizeInch(score).toQSizeF(), QPageSize::Inch),
+                                            QPageLayout::Orientation::Portrait, QMarginsF()));
+
+        draw::Painter painter(&pdfWriter, "benchmark");
+
+        Paint::Options opt;
+        opt.isPrinting = true;
+        opt.deviceDpi = pdfWriter.logicalDpiX();
+        opt.onNewPage = [&pdfWriter]() { pdfWriter.newPage(); };
+
+        Paint::paintScore(&painter, score, opt);
+
+        painter.endDraw();
+
+        resetPrinting(score);
+    }
+
+    void exportPng(Score* score)
+    {
+        const SizeF pageSizeInch = Paint::pageSizeInch(score);
+        const int width = std::lrint(pageSizeInch.width() * EXPORT_DPI);
+        const int height = std::lrint(pageSizeInch.height() * EXPORT_DPI);
+
+        for (size_t i = 0; i < score->npages(); ++i) {
+            QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+            image.fill(Qt::white);
+
+            draw::Painter painter(&image, "benchmark");
+
+            Paint::Options opt;
+            opt.isPrinting = true;
+            opt.fromPage = static_cast<int>(i);
+            opt.toPage = opt.fromPage;
+            opt.deviceDpi = EXPORT_DPI;
+            opt.printPageBackground = false;
+
+            Paint::paintScore(&painter, score, opt);
+
+            painter.endDraw();
+
+            QBuffer pngData;
+            pngData.open(QIODevice::WriteOnly);
+            image.save(&pngData, "png");
+        }
+
+        resetPrinting(score);
+    }
+
+    void resetPrinting(Score* score)
+    {
+        score->setPrinting(false);
+        MScore::pdfPrinting = false;
+    }
+
+    std::shared_ptr<NiceMock<mpe::ArticulationProfilesRepositoryMock> > m_profilesRepository;
+};
+
+TEST_F(Engraving_Benchmarks, LoadLayoutEditSavePlaybackExport)
+{
+    const int runs = std::max(1, std::atoi(envValue("MU_BENCHMARK_RUNS", "3").c_str()));
+    const path_t outputPath = envValue("MU_BENCHMARK_OUTPUT", "engraving_benchmarks.json");
+
+    std::vector<path_t> paths = scorePaths();
+    ASSERT_FALSE(paths.empty());
+
+    BenchmarkReport report;
+    for (int run = 0; run < runs; ++run) {
+        for (const path_t& path : paths) {
+            benchmarkScore(path, report);
+        }
+    }
+
+    EXPECT_TRUE(report.save(outputPath));
+}
@@ -0,0 +1,42 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_MEMORYSTATS_H
+#define MU_ENGRAVING_MEMORYSTATS_H
+
+#include <cstdint>
+
+namespace mu::engraving::benchmarks {
+//! NOTE The allocations are counted by replacing the global operator new in the benchmark executable,
+//! so they include every C++ allocation of the process, on all threads
+class MemoryStats
+{
+public:
+    static uint64_t allocationsCount();
+
+    //! NOTE Resetting the peak is only supported on Linux,
+    //! on other platforms the peak is the high-water mark of the whole process
+    static void resetPeakRss();
+    static uint64_t peakRssKb();
+};
+}
+
+#endif // MU_ENGRAVING_MEMORYSTATS_H
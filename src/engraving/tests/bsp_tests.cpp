@@ -0,0 +1,202 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/note.h"
+#include "libmscore/page.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class Engraving_BspTreeTests : public ::testing::Test
+{
+};
+
+static void collectElements(void* data, EngravingItem* e)
+{
+    static_cast<std::vector<EngravingItem*>*>(data)->push_back(e);
+}
+
+static std::vector<EngravingItem*> pageElements(Page* page)
+{
+    std::vector<EngravingItem*> elements;
+    page->scanElements(&elements, collectElements, false);
+    return elements;
+}
+
+static std::vector<EngravingItem*> sorted(std::vector<EngravingItem*> elements)
+{
+    std::sort(elements.begin(), elements.end());
+    return elements;
+}
+
+static std::vector<EngravingItem*> itemsInRect(const std::vector<EngravingItem*>& elements, const RectF& rect)
+{
+    std::vector<EngravingItem*> result;
+    for (EngravingItem* e : elements) {
+        if (e->pageBoundingRect().intersects(rect)) {
+            result.push_back(e);
+        }
+    }
+    return sorted(result);
+}
+
+static std::vector<EngravingItem*> itemsAtPoint(const std::vector<EngravingItem*>& elements, const PointF& pos)
+{
+    std::vector<EngravingItem*> result;
+    for (EngravingItem* e : elements) {
+        if (e->contains(pos)) {
+            result.push_back(e);
+        }
+    }
+    return sorted(result);
+}
+
+TEST_F(Engraving_BspTreeTests, itemsInRect)
+{
+    //! [GIVEN] Laid out score
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->pages().empty());
+
+    for (Page* page : score->pages()) {
+        std::vector<EngravingItem*> elements = pageElements(page);
+        RectF pageRect = page->bbox();
+
+        //! [WHEN] Query the page with rects of different sizes, including rects out of the page
+        for (double size : { 5.0, 50.0, 500.0 }) {
+            for (double y = pageRect.top() - size; y < pageRect.bottom() + size; y += size) {
+                for (double x = pageRect.left() - size; x < pageRect.right() + size; x += size) {
+                    RectF rect(x, y, size, size);
+
+                    //! [THEN] The same items are found as by checking all the page items
+                    EXPECT_EQ(sorted(page->items(rect)), itemsInRect(elements, rect));
+                }
+            }
+        }
+    }
+
+    delete score;
+}
+
+TEST_F(Engraving_BspTreeTests, itemsAtPoint)
+{
+    //! [GIVEN] Laid out score
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    Page* page = score->pages().front();
+    std::vector<EngravingItem*> elements = pageElements(page);
+
+    //! [WHEN] Query the centers of all the page items
+    //! [THEN] The same items are found as by checking all the page items
+    for (EngravingItem* e : elements) {
+        PointF pos = e->pageBoundingRect().center();
+        std::vector<EngravingItem*> found = page->items(pos);
+        EXPECT_EQ(sorted(found), itemsAtPoint(elements, pos));
+    }
+
+    delete score;
+}
+
+TEST_F(Engraving_BspTreeTests, itemsAppendedToBuffer)
+{
+    //! [GIVEN] Laid out score
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    Page* page = score->pages().front();
+    RectF rect = page->bbox();
+
+    //! [GIVEN] Buffer with an item
+    std::vector<EngravingItem*> buffer { page };
+
+    //! [WHEN] Query the whole page into the buffer
+    page->items(rect, buffer);
+
+    //! [THEN] Found items are appended to the buffer
+    std::vector<EngravingItem*> found = page->items(rect);
+    ASSERT_EQ(buffer.size(), found.size() + 1);
+    EXPECT_EQ(buffer.front(), page);
+    EXPECT_TRUE(std::equal(found.begin(), found.end(), buffer.begin() + 1));
+
+    //! [WHEN] Query again into the cleared buffer
+    size_t capacity = buffer.capacity();
+    buffer.clear();
+    page->items(rect, buffer);
+
+    //! [THEN] The buffer is not reallocated
+    EXPECT_EQ(buffer.capacity(), capacity);
+    EXPECT_EQ(buffer, found);
+
+    delete score;
+}
+
+TEST_F(Engraving_BspTreeTests, movedItems)
+{
+    //! [GIVEN] Laid out score
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    Page* page = score->pages().front();
+    std::vector<EngravingItem*> elements = pageElements(page);
+
+    std::vector<Note*> notes;
+    for (EngravingItem* e : elements) {
+        if (e->isNote()) {
+            notes.push_back(toNote(e));
+        }
+    }
+    ASSERT_FALSE(notes.empty());
+
+    //! [GIVEN] The tree is built
+    page->items(page->bbox());
+
+    //! [WHEN] Move the notes and update the tree
+    double distance = 10 * score->spatium();
+    for (Note* note : notes) {
+        RectF oldRect = note->pageBoundingRect();
+        note->setOffset(note->offset() + PointF(0.0, distance));
+        page->updateBspTree(note);
+
+        //! [THEN] The note is found at the new position only
+        std::vector<EngravingItem*> found = page->items(note->pageBoundingRect());
+        EXPECT_NE(std::find(found.begin(), found.end(), note), found.end());
+
+        found = page->items(oldRect);
+        EXPECT_EQ(std::find(found.begin(), found.end(), note), found.end());
+    }
+
+    //! [THEN] All the items are still found
+    RectF rect = page->bbox().adjusted(-distance, -distance, distance, distance);
+    EXPECT_EQ(sorted(page->items(rect)), itemsInRect(elements, rect));
+
+    delete score;
+}
@@ -0,0 +1,100 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "compat/midi/event.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/rendermidi.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+class Engraving_MidiRendererTests : public ::testing::Test
+{
+protected:
+    static EventMap renderScore(const String& path, bool renderInParallel)
+    {
+        MasterScore* score = ScoreRW::readScore(path);
+        EXPECT_TRUE(score);
+
+        EventMap events;
+        if (!score) {
+            return events;
+        }
+
+        MidiRenderer::Context ctx;
+        ctx.metronome = true;
+        ctx.renderHarmony = true;
+        ctx.renderInParallel = renderInParallel;
+
+        MidiRenderer(score).renderScore(&events, ctx);
+
+        delete score;
+
+        return events;
+    }
+
+    static void checkParallelRenderingMatchesSerial(const String& path)
+    {
+        EventMap serialEvents = renderScore(path, false);
+        EventMap parallelEvents = renderScore(path, true);
+
+        ASSERT_FALSE(serialEvents.empty());
+        ASSERT_EQ(serialEvents.size(), parallelEvents.size());
+
+        auto serialIt = serialEvents.cbegin();
+        auto parallelIt = parallelEvents.cbegin();
+
+        for (; serialIt != serialEvents.cend(); ++serialIt, ++parallelIt) {
+            const NPlayEvent& expected = serialIt->second;
+            const NPlayEvent& actual = parallelIt->second;
+
+            EXPECT_EQ(serialIt->first, parallelIt->first);
+            EXPECT_TRUE(static_cast<const MidiCoreEvent&>(expected) == static_cast<const MidiCoreEvent&>(actual));
+            EXPECT_EQ(expected.tuning(), actual.tuning());
+            EXPECT_EQ(expected.getOriginatingStaff(), actual.getOriginatingStaff());
+            EXPECT_EQ(expected.discard(), actual.discard());
+        }
+    }
+};
+
+/**
+ * @brief MidiRendererTests_ParallelRenderingOfStaves
+ * @details Renders a piano score with many chunks with and without
+ *          rendering staves in parallel, the events must be the same
+ */
+TEST_F(Engraving_MidiRendererTests, ParallelRenderingOfStaves)
+{
+    checkParallelRenderingMatchesSerial(u"all_elements_data/moonlight.mscx");
+}
+
+/**
+ * @brief MidiRendererTests_ParallelRenderingOfChordSymbols
+ * @details Same as above for a score with played chord symbols
+ */
+TEST_F(Engraving_MidiRendererTests, ParallelRenderingOfChordSymbols)
+{
+    checkParallelRenderingMatchesSerial(u"chordsymbol_data/realize-close-ref.mscx");
+}
@@ -410,3 +410,36 @@ TEST_F(Engraving_RepeatTests, DISABLED_repeat67) {
     // Jump at skipped open volta end with end repeat at end of score: #327681
     repeat("repeat67.mscx", u"1;2; 1");
 }
+
+TEST_F(Engraving_RepeatTests, repeatListUpdate) {
+    MasterScore* score = ScoreRW::readScore(REPEAT_DATA_DIR + u"repeat01.mscx");
+    ASSERT_TRUE(score);
+
+    score->setExpandRepeats(true);
+
+    const RepeatList& repeatList = score->repeatList();
+    ASSERT_EQ(repeatList.size(), 2u);
+    const RepeatSegment* first = repeatList.at(0);
+    const RepeatSegment* second = repeatList.at(1);
+    int ticks = repeatList.ticks();
+
+    // unchanged structure keeps the unwound segments
+    score->setPlaylistDirty();
+    EXPECT_EQ(score->repeatList().at(0), first);
+    EXPECT_EQ(score->repeatList().at(1), second);
+    EXPECT_EQ(score->repeatList().ticks(), ticks);
+
+    // utick lookups resolve to the right segment
+    EXPECT_EQ(repeatList.utick2tick(second->utick), second->tick);
+    EXPECT_EQ(repeatList.utick2tick(second->utick - 1), first->tick + first->len() - 1);
+
+    // removing the end repeat unwinds again
+    Measure* m = score->firstMeasure()->nextMeasure()->nextMeasure();
+    ASSERT_TRUE(m->repeatEnd());
+    m->setRepeatEnd(false);
+    score->setPlaylistDirty();
+    EXPECT_EQ(score->repeatList().size(), 1u);
+    EXPECT_LT(score->repeatList().ticks(), ticks);
+
+    delete score;
+}
@@ -22,11 +22,16 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+
 #include "utils/scorerw.h"
 #include "realfn.h"
 #include "types/constants.h"
 #include "libmscore/tempo.h"
 
+#include "log.h"
+
 using namespace mu;
 using namespace mu::engraving;
 
@@ -36,6 +41,36 @@ class Engraving_TempoMapTests : public ::testing::Test
 {
 protected:
     void SetUp() override {}
+
+    //! Creates a tempo map with a tempo change on every beat and a pause on every 16th beat
+    static void fillTempoMap(TempoMap& tempoMap, int count)
+    {
+        for (int i = 0; i < count; ++i) {
+            int tick = i * Constants::division;
+            tempoMap.setTempo(tick, BeatsPerSecond::fromBPM(BeatsPerMinute(60.0 + (i * 7) % 120)));
+            if (i % 16 == 15) {
+                tempoMap.setPause(tick, 0.5);
+            }
+        }
+    }
+
+    //! Looks up the time by walking all tempo events
+    static double referenceTick2time(const TempoMap& tempoMap, int tick)
+    {
+        int ptick = 0;
+        double time = 0.0;
+        double tempo = 2.0;
+        for (const auto& pair : tempoMap) {
+            if (pair.first > tick) {
+                break;
+            }
+            ptick = pair.first;
+            time = pair.second.time;
+            tempo = pair.second.tempo.val;
+        }
+
+        return time + double(tick - ptick) / (Constants::division * tempo * tempoMap.tempoMultiplier().val);
+    }
 };
 
 /**
@@ -256,3 +291,100 @@ TEST_F(Engraving_TempoMapTests, GRADUAL_TEMPO_CHANGE_DOESNT_OVERWRITE_OTHER_TEMP
         EXPECT_TRUE(RealIsEqual(RealRound(tempoMap->at(pair.first).tempo.val, 2), RealRound(pair.second.val, 2)));
     }
 }
+
+/**
+ * @brief TempoMapTests_MANY_TEMPO_CHANGES
+ * @details Tempo map with hundreds of tempo changes and pauses, the indexed lookups
+ *          must match walking the tempo events, the batched lookups must match the single ones
+ */
+TEST_F(Engraving_TempoMapTests, MANY_TEMPO_CHANGES)
+{
+    // [GIVEN] Tempo map with 500 tempo changes
+    TempoMap tempoMap;
+    fillTempoMap(tempoMap, 500);
+
+    std::vector<int> ticks;
+    for (int tick = 0; tick < 510 * Constants::division; tick += 37) {
+        ticks.push_back(tick);
+    }
+
+    // [WHEN] We convert the ticks to times one by one and batched
+    std::vector<double> times = tempoMap.tick2time(ticks);
+    ASSERT_EQ(times.size(), ticks.size());
+
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        // [THEN] The times match the reference
+        EXPECT_DOUBLE_EQ(times.at(i), tempoMap.tick2time(ticks.at(i)));
+        EXPECT_DOUBLE_EQ(times.at(i), referenceTick2time(tempoMap, ticks.at(i)));
+
+        BeatsPerSecond tempo = tempoMap.tempo(ticks.at(i));
+        int tempoTick = ticks.at(i) / Constants::division * Constants::division;
+        EXPECT_TRUE(RealIsEqual(tempo.val, tempoMap.at(std::min(tempoTick, 499 * Constants::division)).tempo.val));
+    }
+
+    // [THEN] Converting the times back gives the original ticks
+    std::vector<int> backTicks = tempoMap.time2tick(times);
+    ASSERT_EQ(backTicks.size(), ticks.size());
+
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        EXPECT_EQ(backTicks.at(i), tempoMap.time2tick(times.at(i)));
+        EXPECT_EQ(backTicks.at(i), ticks.at(i));
+    }
+
+    // [THEN] The lookups follow changes of the tempo map
+    tempoMap.clearRange(100 * Constants::division, 200 * Constants::division);
+    int tick = 150 * Constants::division + 11;
+    EXPECT_DOUBLE_EQ(tempoMap.tick2time(tick), referenceTick2time(tempoMap, tick));
+    EXPECT_TRUE(RealIsEqual(tempoMap.tempo(tick).val, tempoMap.at(99 * Constants::division).tempo.val));
+
+    tempoMap.clear();
+    EXPECT_TRUE(RealIsEqual(tempoMap.tempo(tick).val, 2.0));
+}
+
+/**
+ * @brief TempoMapTests_DISABLED_LOOKUP_BENCHMARK
+ * @details Measures the tick to time conversions over a tempo map with hundreds of tempo changes,
+ *          run with --gtest_also_run_disabled_tests
+ */
+TEST_F(Engraving_TempoMapTests, DISABLED_LOOKUP_BENCHMARK)
+{
+    TempoMap tempoMap;
+    fillTempoMap(tempoMap, 800);
+
+    std::vector<int> ticks;
+    for (int tick = 0; tick < 800 * Constants::division; tick += 7) {
+        ticks.push_back(tick);
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point start = Clock::now();
+    double referenceSum = 0.0;
+    for (int tick : ticks) {
+        referenceSum += referenceTick2time(tempoMap, tick);
+    }
+    Clock::duration referenceDuration = Clock::now() - start;
+
+    start = Clock::now();
+    double sum = 0.0;
+    for (int tick : ticks) {
+        sum += tempoMap.tick2time(tick);
+    }
+    Clock::duration singleDuration = Clock::now() - start;
+
+    start = Clock::now();
+    double batchedSum = 0.0;
+    for (double time : tempoMap.tick2time(ticks)) {
+        batchedSum += time;
+    }
+    Clock::duration batchedDuration = Clock::now() - start;
+
+    EXPECT_DOUBLE_EQ(sum, referenceSum);
+    EXPECT_DOUBLE_EQ(batchedSum, referenceSum);
+
+    using std::chrono::microseconds;
+    using std::chrono::duration_cast;
+    LOGI() << ticks.size() << " lookups, walking events: " << duration_cast<microseconds>(referenceDuration).count() << " us"
+           << ", indexed: " << duration_cast<microseconds>(singleDuration).count() << " us"
+           << ", batched: " << duration_cast<microseconds>(batchedDuration).count() << " us";
+}
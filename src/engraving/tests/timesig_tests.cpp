@@ -25,6 +25,7 @@
 #include "libmscore/factory.h"
 #include "libmscore/masterscore.h"
 #include "libmscore/measure.h"
+#include "libmscore/sig.h"
 #include "libmscore/timesig.h"
 #include "libmscore/undo.h"
 
@@ -306,3 +307,44 @@ TEST_F(Engraving_TimesigTests, timesig_78216)
     EXPECT_FALSE(m3->findSegment(SegmentType::TimeSig, m3->endTick())) << "Should be no timesig at the end of measure 3.";
     delete score;
 }
+
+//---------------------------------------------------------
+///   timesigmap_lookups
+///   bar and beat lookups over many time signature changes
+//---------------------------------------------------------
+
+TEST_F(Engraving_TimesigTests, timesigmap_lookups)
+{
+    static const Fraction timesigs[] = { Fraction(4, 4), Fraction(3, 4), Fraction(7, 8), Fraction(6, 8), Fraction(5, 16) };
+
+    // a time signature change every three bars
+    TimeSigMap sigmap;
+    int tick = 0;
+    for (int bar = 0; bar < 600; bar += 3) {
+        Fraction timesig = timesigs[(bar / 3) % 5];
+        sigmap.add(tick, timesig);
+        tick += 3 * timesig.ticks();
+    }
+
+    tick = 0;
+    for (int bar = 0; bar < 600; ++bar) {
+        Fraction timesig = timesigs[(bar / 3) % 5];
+        EXPECT_EQ(sigmap.bar2tick(bar, 0), tick);
+        EXPECT_EQ(sigmap.timesig(tick).timesig(), timesig);
+
+        int b = 0;
+        int beat = 0;
+        int rtick = 0;
+        sigmap.tickValues(tick + timesig.ticks() - 1, &b, &beat, &rtick);
+        EXPECT_EQ(b, bar);
+        EXPECT_EQ(beat, timesig.numerator() - 1);
+
+        tick += timesig.ticks();
+    }
+
+    sigmap.clearRange(sigmap.bar2tick(300, 0), sigmap.bar2tick(330, 0));
+    EXPECT_EQ(sigmap.timesig(sigmap.bar2tick(310, 0)).timesig(), timesigs[(297 / 3) % 5]);
+
+    sigmap.clear();
+    EXPECT_EQ(sigmap.timesig(0).timesig(), Fraction(4, 4));
+}
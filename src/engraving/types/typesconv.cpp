@@ -21,6 +21,8 @@
  */
 #include "typesconv.h"
 
+#include <unordered_map>
+
 #include "types/translatablestring.h"
 
 #include "symnames.h"
@@ -78,9 +80,8 @@ static AsciiStringView findXmlTagByType(const C& cont, const T& v)
 template<typename T, typename C>
 static T findTypeByXmlTag(const C& cont, const String& tag, T def)
 {
-    ByteArray ba = tag.toAscii();
-    auto it = std::find_if(cont.cbegin(), cont.cend(), [ba](const Item<T>& i) {
-        return i.xml == ba.constChar();
+    auto it = std::find_if(cont.cbegin(), cont.cend(), [&tag](const Item<T>& i) {
+        return tag == i.xml;
     });
 
     IF_ASSERT_FAILED(it != cont.cend()) {
@@ -274,7 +275,26 @@ AsciiStringView TConv::toXml(ElementType v)
 
 ElementType TConv::fromXml(const AsciiStringView& tag, ElementType def, bool silent)
 {
-    return findTypeByXmlTag<ElementType>(ELEMENT_TYPES, tag, def, silent);
+    //! NOTE Called for each element while reading, so look it up by index instead of a linear search
+    static const std::unordered_map<std::string_view, ElementType> index = []() {
+        std::unordered_map<std::string_view, ElementType> idx;
+        idx.reserve(ELEMENT_TYPES.size());
+        for (const Item<ElementType>& i : ELEMENT_TYPES) {
+            idx.emplace(std::string_view(i.xml.ascii(), i.xml.size()), i.type);
+        }
+        return idx;
+    }();
+
+    auto it = index.find(std::string_view(tag.ascii(), tag.size()));
+    if (it == index.end()) {
+        if (!silent) {
+            LOGE() << "not found type for tag: " << tag;
+            assert(it != index.end());
+        }
+        return def;
+    }
+
+    return it->second;
 }
 
 static const std::vector<Item<AlignH> > ALIGN_H = {
@@ -21,6 +21,8 @@
  */
 #include "actionsdispatcher.h"
 #include "log.h"
+#include "defer.h"
+#include "editlatencyprobe.h"
 #include "actionable.h"
 
 using namespace mu::actions;
@@ -50,6 +52,11 @@ void ActionsDispatcher::dispatch(const ActionCode& actionCode, const ActionData&
         return;
     }
 
+    EditLatencyProbe::instance()->beginAction(actionCode);
+    DEFER {
+        EditLatencyProbe::instance()->leaveAction();
+    };
+
     int canReceiveCount = 0;
     const Clients& clients = it->second;
     for (auto cit = clients.cbegin(); cit != clients.cend(); ++cit) {
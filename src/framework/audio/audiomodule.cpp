@@ -42,6 +42,7 @@
 // synthesizers
 #include "internal/synthesizers/fluidsynth/fluidresolver.h"
 #include "internal/synthesizers/synthresolver.h"
+#include "internal/synthesizers/voicebudget.h"
 
 #include "internal/fx/fxresolver.h"
 
@@ -172,6 +173,17 @@ void AudioModule::onInit(const framework::IApplication::RunMode& mode)
 
     s_audioBuffer->init(s_audioConfiguration->audioChannelsCount(),
                         s_audioConfiguration->renderStep());
+    s_audioBuffer->setOnRefillRequired([]() {
+        s_audioWorker->wakeUp();
+    });
+
+    auto applySynthRenderingSettings = []() {
+        VoiceBudget::instance()->setMaxVoices(s_audioConfiguration->synthPolyphonyBudget());
+        VoiceBudget::instance()->setRenderThreadsPerSynth(s_audioConfiguration->synthRenderThreadsPerTrack());
+    };
+
+    applySynthRenderingSettings();
+    s_audioConfiguration->synthRenderingSettingsChanged().onNotify(nullptr, applySynthRenderingSettings);
 
     s_audioOutputController->init();
 
@@ -65,6 +65,15 @@ public:
     virtual void setUserSoundFontDirectories(const io::paths_t& paths) = 0;
     virtual async::Channel<io::paths_t> soundFontDirectoriesChanged() const = 0;
 
+    /// Voices of all the synthesizers together, 0 means no limit
+    virtual int synthPolyphonyBudget() const = 0;
+    virtual void setSynthPolyphonyBudget(int voices) = 0;
+
+    /// Threads that may render the voices of one heavy track, 1 means no splitting. Applies to tracks created afterwards
+    virtual int synthRenderThreadsPerTrack() const = 0;
+    virtual void setSynthRenderThreadsPerTrack(int threads) = 0;
+    virtual async::Notification synthRenderingSettingsChanged() const = 0;
+
     virtual const synth::SynthesizerState& synthesizerState() const = 0;
     virtual Ret saveSynthesizerState(const synth::SynthesizerState& state) = 0;
     virtual async::Notification synthesizerStateChanged() const = 0;
@@ -21,6 +21,8 @@
  */
 #include "audiobuffer.h"
 
+#include <algorithm>
+
 #include "log.h"
 #include "audiosanitizer.h"
 
@@ -29,6 +31,9 @@ using namespace mu::audio;
 static constexpr size_t DEFAULT_SIZE_PER_CHANNEL = 1024 * 8;
 static constexpr size_t DEFAULT_SIZE = DEFAULT_SIZE_PER_CHANNEL * 2;
 
+//! how many driver reads are kept in reserve, the worker is woken up as soon as one of them is consumed
+static constexpr size_t DRIVER_READS_TO_RESERVE = 4;
+
 static const std::vector<float> SILENT_FRAMES(DEFAULT_SIZE, 0.f);
 
 struct BaseBufferProfiler {
@@ -132,7 +137,7 @@ void AudioBuffer::forward()
     const auto currentReadIdx = m_readIndex.load(std::memory_order_acquire);
     size_t nextWriteIdx = currentWriteIdx;
 
-    samples_t framesToReserve = DEFAULT_SIZE / 2;
+    samples_t framesToReserve = samplesToReserve();
 
     while (reservedFrames(nextWriteIdx, currentReadIdx) < framesToReserve) {
         m_source->process(m_data.data() + nextWriteIdx, m_renderStep);
@@ -149,6 +154,10 @@ void AudioBuffer::pop(float* dest, size_t sampleCount)
     const auto currentWriteIdx = m_writeIndex.load(std::memory_order_acquire);
     if (currentReadIdx == currentWriteIdx) { // empty queue
         std::memcpy(dest, SILENT_FRAMES.data(), sampleCount * sizeof(float) * m_audioChannelsCount);
+
+        if (m_onRefillRequired) {
+            m_onRefillRequired();
+        }
         return;
     }
 
@@ -182,6 +191,10 @@ void AudioBuffer::pop(float* dest, size_t sampleCount)
     }
 
     m_readIndex.store(newReadIdx, std::memory_order_release);
+
+    if (m_onRefillRequired && reservedFrames(currentWriteIdx, newReadIdx) < samplesToReserve()) {
+        m_onRefillRequired();
+    }
 }
 
 void AudioBuffer::setMinSamplesToReserve(size_t lag)
@@ -192,6 +205,24 @@ void AudioBuffer::setMinSamplesToReserve(size_t lag)
     m_minSamplesToReserve = lag;
 }
 
+void AudioBuffer::setOnRefillRequired(const std::function<void()>& f)
+{
+    m_onRefillRequired = f;
+}
+
+size_t AudioBuffer::samplesToReserve() const
+{
+    size_t minSamples = m_minSamplesToReserve.load(std::memory_order_relaxed);
+    if (minSamples == 0) {
+        return DEFAULT_SIZE / 2;
+    }
+
+    size_t samples = minSamples * m_audioChannelsCount * DRIVER_READS_TO_RESERVE;
+    samples = std::max<size_t>(samples, m_renderStep * m_audioChannelsCount * 2);
+
+    return std::min<size_t>(samples, DEFAULT_SIZE / 2);
+}
+
 void AudioBuffer::reset()
 {
     m_readIndex.store(0, std::memory_order_release);
@@ -25,6 +25,7 @@
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <functional>
 
 #include "iaudiosource.h"
 #include "audiotypes.h"
@@ -56,13 +57,19 @@ public:
     void pop(float* dest, size_t sampleCount);
     void setMinSamplesToReserve(size_t lag);
 
+    //! called from pop() when the reserve falls below the refill threshold,
+    //! must be set before the reader starts
+    void setOnRefillRequired(const std::function<void()>& f);
+
     void reset();
 
 private:
     size_t reservedFrames(const size_t writeIdx, const size_t readIdx) const;
     size_t incrementWriteIndex(const size_t writeIdx, const samples_t samplesPerChannel);
+    size_t samplesToReserve() const;
 
-    size_t m_minSamplesToReserve = 0;
+    std::atomic<size_t> m_minSamplesToReserve = 0;
+    std::function<void()> m_onRefillRequired = nullptr;
 
     alignas(cache_line_size) std::atomic<size_t> m_writeIndex = 0;
     alignas(cache_line_size) std::atomic<size_t> m_readIndex = 0;
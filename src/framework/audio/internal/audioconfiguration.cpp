@@ -45,6 +45,8 @@ static const Settings::Key AUDIO_BUFFER_SIZE_KEY("audio", "io/bufferSize");
 static const Settings::Key AUDIO_SAMPLE_RATE_KEY("audio", "io/sampleRate");
 
 static const Settings::Key USER_SOUNDFONTS_PATHS("midi", "application/paths/mySoundfonts");
+static const Settings::Key SYNTH_POLYPHONY_BUDGET_KEY("audio", "synthesizers/polyphonyBudget");
+static const Settings::Key SYNTH_RENDER_THREADS_PER_TRACK_KEY("audio", "synthesizers/renderThreadsPerTrack");
 
 static const AudioResourceId DEFAULT_SOUND_FONT_NAME = "MS Basic";     // "GeneralUser GS v1.471.sf2"; // "MS Basic.sf3";
 static const AudioResourceMeta DEFAULT_AUDIO_RESOURCE_META
@@ -79,6 +81,16 @@ void AudioConfiguration::init()
         m_soundFontDirsChanged.send(soundFontDirectories());
     });
 
+    settings()->setDefaultValue(SYNTH_POLYPHONY_BUDGET_KEY, Val(0));
+    settings()->valueChanged(SYNTH_POLYPHONY_BUDGET_KEY).onReceive(nullptr, [this](const Val&) {
+        m_synthRenderingSettingsChanged.notify();
+    });
+
+    settings()->setDefaultValue(SYNTH_RENDER_THREADS_PER_TRACK_KEY, Val(1));
+    settings()->valueChanged(SYNTH_RENDER_THREADS_PER_TRACK_KEY).onReceive(nullptr, [this](const Val&) {
+        m_synthRenderingSettingsChanged.notify();
+    });
+
     for (const auto& path : userSoundFontDirectories()) {
         fileSystem()->makePath(path);
     }
@@ -185,6 +197,31 @@ async::Channel<io::paths_t> AudioConfiguration::soundFontDirectoriesChanged() co
     return m_soundFontDirsChanged;
 }
 
+int AudioConfiguration::synthPolyphonyBudget() const
+{
+    return settings()->value(SYNTH_POLYPHONY_BUDGET_KEY).toInt();
+}
+
+void AudioConfiguration::setSynthPolyphonyBudget(int voices)
+{
+    settings()->setSharedValue(SYNTH_POLYPHONY_BUDGET_KEY, Val(voices));
+}
+
+int AudioConfiguration::synthRenderThreadsPerTrack() const
+{
+    return settings()->value(SYNTH_RENDER_THREADS_PER_TRACK_KEY).toInt();
+}
+
+void AudioConfiguration::setSynthRenderThreadsPerTrack(int threads)
+{
+    settings()->setSharedValue(SYNTH_RENDER_THREADS_PER_TRACK_KEY, Val(threads));
+}
+
+async::Notification AudioConfiguration::synthRenderingSettingsChanged() const
+{
+    return m_synthRenderingSettingsChanged;
+}
+
 AudioInputParams AudioConfiguration::defaultAudioInputParams() const
 {
     AudioInputParams result;
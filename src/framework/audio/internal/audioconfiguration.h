@@ -62,6 +62,12 @@ public:
     void setUserSoundFontDirectories(const io::paths_t& paths) override;
     async::Channel<io::paths_t> soundFontDirectoriesChanged() const override;
 
+    int synthPolyphonyBudget() const override;
+    void setSynthPolyphonyBudget(int voices) override;
+    int synthRenderThreadsPerTrack() const override;
+    void setSynthRenderThreadsPerTrack(int threads) override;
+    async::Notification synthRenderingSettingsChanged() const override;
+
     AudioInputParams defaultAudioInputParams() const override;
 
     const synth::SynthesizerState& defaultSynthesizerState() const;
@@ -84,6 +90,7 @@ private:
     async::Notification m_audioOutputDeviceIdChanged;
     async::Notification m_driverBufferSizeChanged;
     async::Notification m_driverSampleRateChanged;
+    async::Notification m_synthRenderingSettingsChanged;
 };
 }
 
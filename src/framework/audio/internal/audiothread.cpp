@@ -23,16 +23,68 @@
 
 #include "log.h"
 #include "runtime.h"
+#include "memoryaccounting.h"
 #include "async/processevents.h"
 
 #ifdef Q_OS_WASM
 #include <emscripten/html5.h>
 #endif
 
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_MAC)
+#include <dispatch/dispatch.h>
+#else
+#include <cerrno>
+#include <semaphore.h>
+#endif
+
 using namespace mu::audio;
 
+//! NOTE The driver callback wakes the thread up, so posting must not take a lock
+//! (the condition variable needs its mutex to not lose a notification).
+//! The native semaphores only make a system call when the thread is actually waiting
+class AudioThread::WakeUpSemaphore
+{
+public:
+#if defined(Q_OS_WIN)
+    WakeUpSemaphore() { m_handle = CreateSemaphore(nullptr, 0, LONG_MAX, nullptr); }
+    ~WakeUpSemaphore() { CloseHandle(m_handle); }
+    void post() { ReleaseSemaphore(m_handle, 1, nullptr); }
+    void wait() { WaitForSingleObject(m_handle, INFINITE); }
+
+private:
+    HANDLE m_handle = nullptr;
+#elif defined(Q_OS_MAC)
+    WakeUpSemaphore() { m_sem = dispatch_semaphore_create(0); }
+    ~WakeUpSemaphore() { dispatch_release(m_sem); }
+    void post() { dispatch_semaphore_signal(m_sem); }
+    void wait() { dispatch_semaphore_wait(m_sem, DISPATCH_TIME_FOREVER); }
+
+private:
+    dispatch_semaphore_t m_sem = nullptr;
+#else
+    WakeUpSemaphore() { sem_init(&m_sem, 0, 0); }
+    ~WakeUpSemaphore() { sem_destroy(&m_sem); }
+    void post() { sem_post(&m_sem); }
+    void wait()
+    {
+        while (sem_wait(&m_sem) != 0 && errno == EINTR) {
+        }
+    }
+
+private:
+    sem_t m_sem;
+#endif
+};
+
 std::thread::id AudioThread::ID;
 
+AudioThread::AudioThread()
+    : m_wakeUpSemaphore(std::make_unique<WakeUpSemaphore>())
+{
+}
+
 AudioThread::~AudioThread()
 {
     if (m_running) {
@@ -62,6 +114,7 @@ void AudioThread::stop(const Runnable& onFinished)
 {
     m_onFinished = onFinished;
     m_running = false;
+    wakeUp();
     if (m_thread) {
         m_thread->join();
     }
@@ -72,26 +125,52 @@ bool AudioThread::isRunning() const
     return m_running;
 }
 
+void AudioThread::wakeUp()
+{
+    //! NOTE Post once per pass: the thread resets the request before the pass
+    //! and waits once after it, so a request made during the pass is not lost
+    if (m_wakeUpRequested.exchange(true)) {
+        return;
+    }
+
+    m_wakeUpSemaphore->post();
+}
+
 void AudioThread::main()
 {
     mu::runtime::setThreadName("audio_worker");
 
+    //! NOTE Everything the worker allocates (synths, mixer, event sequences) is charged to audio
+    MEMORY_TAG_SCOPE(Audio);
+
     AudioThread::ID = std::this_thread::get_id();
 
+    //! NOTE Instead of polling, the loop runs when a call is queued for this thread
+    //! or when somebody (e.g. the driver running out of data) asks for it
+    mu::async::onQueued(AudioThread::ID, [this]() {
+        wakeUp();
+    });
+
     if (m_onStart) {
         m_onStart();
     }
 
     while (m_running) {
+        m_wakeUpRequested = false;
+
         mu::async::processEvents();
 
         if (m_mainLoopBody) {
             m_mainLoopBody();
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        if (m_running) {
+            m_wakeUpSemaphore->wait();
+        }
     }
 
+    mu::async::onQueued(AudioThread::ID, nullptr);
+
     if (m_onFinished) {
         m_onFinished();
     }
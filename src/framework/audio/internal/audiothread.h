@@ -32,7 +32,7 @@ namespace mu::audio {
 class AudioThread
 {
 public:
-    AudioThread() = default;
+    AudioThread();
     ~AudioThread();
 
     static std::thread::id ID;
@@ -43,7 +43,13 @@ public:
     void stop(const Runnable& onFinished = nullptr);
     bool isRunning() const;
 
+    //! request one more pass of the loop, the thread sleeps until then;
+    //! lock-free, can be called from the audio driver callback
+    void wakeUp();
+
 private:
+    class WakeUpSemaphore;
+
     void main();
 
     Runnable m_onStart = nullptr;
@@ -52,6 +58,9 @@ private:
 
     std::unique_ptr<std::thread> m_thread = nullptr;
     std::atomic<bool> m_running = false;
+
+    std::atomic<bool> m_wakeUpRequested = false;
+    std::unique_ptr<WakeUpSemaphore> m_wakeUpSemaphore;
 };
 using AudioThreadPtr = std::shared_ptr<AudioThread>;
 }
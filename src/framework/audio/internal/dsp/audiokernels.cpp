@@ -0,0 +1,448 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "audiokernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "audiomathutils.h"
+
+#if defined(MU_AUDIO_SIMD_SSE) && !defined(__EMSCRIPTEN__) \
+    && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define MU_AUDIO_SIMD_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define MU_AUDIO_TARGET_AVX2
+#else
+#define MU_AUDIO_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+namespace {
+//! the vector paths handle interleaved layouts which repeat every MAX_PERIOD_VECTORS vectors at most,
+//! i.e. 1, 2, 4, 8 or 16 channels; everything else goes through the scalar path
+constexpr int MAX_PERIOD_VECTORS = 4;
+
+using MixAddFunc = void (*)(float*, const float*, const samples_t);
+using ScaleFunc = void (*)(float*, const samples_t, const gain_t);
+using ApplyGainFunc = void (*)(float*, const audioch_t, const samples_t, const gain_t*, const gain_t*, SignalMeasure*);
+
+struct Kernels {
+    MixAddFunc mixAdd = nullptr;
+    ScaleFunc scale = nullptr;
+    ApplyGainFunc applyGain = nullptr;
+    const char* name = nullptr;
+};
+
+float rampStep(const gain_t from, const gain_t to, const samples_t samplesPerChannel)
+{
+    return samplesPerChannel > 0 ? (to - from) / static_cast<float>(samplesPerChannel) : 0.f;
+}
+
+void applyGainScalarFrom(float* buffer, const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+                         const samples_t firstFrame, const gain_t* fromGains, const gain_t* toGains, SignalMeasure* measures)
+{
+    for (audioch_t ch = 0; ch < audioChannelsCount; ++ch) {
+        const float step = rampStep(fromGains[ch], toGains[ch], samplesPerChannel);
+        float squaredSum = 0.f;
+        float peak = measures[ch].peak;
+
+        for (samples_t f = firstFrame; f < samplesPerChannel; ++f) {
+            float& sample = buffer[f * audioChannelsCount + ch];
+            sample *= fromGains[ch] + step * static_cast<float>(f + 1);
+            squaredSum += sample * sample;
+            peak = std::max(peak, std::abs(sample));
+        }
+
+        measures[ch].squaredSum += squaredSum;
+        measures[ch].peak = peak;
+    }
+}
+
+void mixAddScalar(float* out, const float* in, const samples_t count)
+{
+    for (samples_t i = 0; i < count; ++i) {
+        out[i] += in[i];
+    }
+}
+
+void scaleScalar(float* buffer, const samples_t count, const gain_t gain)
+{
+    for (samples_t i = 0; i < count; ++i) {
+        buffer[i] *= gain;
+    }
+}
+
+void applyGainScalar(float* buffer, const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+                     const gain_t* fromGains, const gain_t* toGains, SignalMeasure* measures)
+{
+    std::fill(measures, measures + audioChannelsCount, SignalMeasure());
+    applyGainScalarFrom(buffer, audioChannelsCount, samplesPerChannel, 0, fromGains, toGains, measures);
+}
+
+//! Describes how an interleaved buffer maps onto vectors of LANES floats:
+//! the layout repeats every `vectors` vectors, which hold `frames` frames
+template<int LANES>
+struct VectorLayout {
+    int vectors = 0;
+    samples_t frames = 0;
+
+    explicit VectorLayout(const audioch_t audioChannelsCount)
+    {
+        if (audioChannelsCount == 0) {
+            return;
+        }
+
+        int period = 0;
+        if (LANES % audioChannelsCount == 0) {
+            period = LANES;
+        } else if (audioChannelsCount % LANES == 0) {
+            period = audioChannelsCount;
+        }
+
+        if (period == 0 || period / LANES > MAX_PERIOD_VECTORS) {
+            return;
+        }
+
+        vectors = period / LANES;
+        frames = period / audioChannelsCount;
+    }
+
+    bool isValid() const
+    {
+        return vectors > 0;
+    }
+
+    //! gain of every lane on the first period, and its increase from one period to the next
+    void fillGains(const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+                   const gain_t* fromGains, const gain_t* toGains, float* base, float* step) const
+    {
+        for (int lane = 0; lane < vectors * LANES; ++lane) {
+            const audioch_t ch = lane % audioChannelsCount;
+            const float frameStep = rampStep(fromGains[ch], toGains[ch], samplesPerChannel);
+            base[lane] = fromGains[ch] + frameStep * static_cast<float>(lane / audioChannelsCount + 1);
+            step[lane] = frameStep * static_cast<float>(frames);
+        }
+    }
+
+    //! fold the lane measures into per channel ones
+    void reduce(const audioch_t audioChannelsCount, const float* squaredSums, const float* peaks, SignalMeasure* measures) const
+    {
+        std::fill(measures, measures + audioChannelsCount, SignalMeasure());
+
+        for (int lane = 0; lane < vectors * LANES; ++lane) {
+            SignalMeasure& measure = measures[lane % audioChannelsCount];
+            measure.squaredSum += squaredSums[lane];
+            measure.peak = std::max(measure.peak, peaks[lane]);
+        }
+    }
+};
+
+#if defined(MU_AUDIO_SIMD_SSE)
+void mixAddSse(float* out, const float* in, const samples_t count)
+{
+    samples_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_loadu_ps(in + i)));
+        _mm_storeu_ps(out + i + 4, _mm_add_ps(_mm_loadu_ps(out + i + 4), _mm_loadu_ps(in + i + 4)));
+    }
+    mixAddScalar(out + i, in + i, count - i);
+}
+
+void scaleSse(float* buffer, const samples_t count, const gain_t gain)
+{
+    const __m128 factor = _mm_set1_ps(gain);
+    samples_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), factor));
+        _mm_storeu_ps(buffer + i + 4, _mm_mul_ps(_mm_loadu_ps(buffer + i + 4), factor));
+    }
+    scaleScalar(buffer + i, count - i, gain);
+}
+
+void applyGainSse(float* buffer, const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+                  const gain_t* fromGains, const gain_t* toGains, SignalMeasure* measures)
+{
+    constexpr int LANES = 4;
+    const VectorLayout<LANES> layout(audioChannelsCount);
+    if (!layout.isValid()) {
+        applyGainScalar(buffer, audioChannelsCount, samplesPerChannel, fromGains, toGains, measures);
+        return;
+    }
+
+    alignas(16) float base[MAX_PERIOD_VECTORS * LANES];
+    alignas(16) float step[MAX_PERIOD_VECTORS * LANES];
+    layout.fillGains(audioChannelsCount, samplesPerChannel, fromGains, toGains, base, step);
+
+    __m128 squaredSums[MAX_PERIOD_VECTORS];
+    __m128 peaks[MAX_PERIOD_VECTORS];
+    for (int v = 0; v < layout.vectors; ++v) {
+        squaredSums[v] = _mm_setzero_ps();
+        peaks[v] = _mm_setzero_ps();
+    }
+
+    const __m128 signMask = _mm_set1_ps(-0.f);
+    const samples_t periods = samplesPerChannel / layout.frames;
+    float* data = buffer;
+
+    for (samples_t period = 0; period < periods; ++period) {
+        const __m128 index = _mm_set1_ps(static_cast<float>(period));
+
+        for (int v = 0; v < layout.vectors; ++v, data += LANES) {
+            const __m128 gain = _mm_add_ps(_mm_load_ps(base + v * LANES), _mm_mul_ps(_mm_load_ps(step + v * LANES), index));
+            const __m128 sample = _mm_mul_ps(_mm_loadu_ps(data), gain);
+            _mm_storeu_ps(data, sample);
+
+            squaredSums[v] = _mm_add_ps(squaredSums[v], _mm_mul_ps(sample, sample));
+            peaks[v] = _mm_max_ps(peaks[v], _mm_andnot_ps(signMask, sample));
+        }
+    }
+
+    alignas(16) float laneSquaredSums[MAX_PERIOD_VECTORS * LANES];
+    alignas(16) float lanePeaks[MAX_PERIOD_VECTORS * LANES];
+    for (int v = 0; v < layout.vectors; ++v) {
+        _mm_store_ps(laneSquaredSums + v * LANES, squaredSums[v]);
+        _mm_store_ps(lanePeaks + v * LANES, peaks[v]);
+    }
+
+    layout.reduce(audioChannelsCount, laneSquaredSums, lanePeaks, measures);
+    applyGainScalarFrom(buffer, audioChannelsCount, samplesPerChannel, periods * layout.frames, fromGains, toGains, measures);
+}
+#endif
+
+#if defined(MU_AUDIO_SIMD_AVX2)
+MU_AUDIO_TARGET_AVX2
+void mixAddAvx2(float* out, const float* in, const samples_t count)
+{
+    samples_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_loadu_ps(in + i)));
+        _mm256_storeu_ps(out + i + 8, _mm256_add_ps(_mm256_loadu_ps(out + i + 8), _mm256_loadu_ps(in + i + 8)));
+    }
+    mixAddScalar(out + i, in + i, count - i);
+}
+
+MU_AUDIO_TARGET_AVX2
+void scaleAvx2(float* buffer, const samples_t count, const gain_t gain)
+{
+    const __m256 factor = _mm256_set1_ps(gain);
+    samples_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm256_storeu_ps(buffer + i, _mm256_mul_ps(_mm256_loadu_ps(buffer + i), factor));
+        _mm256_storeu_ps(buffer + i + 8, _mm256_mul_ps(_mm256_loadu_ps(buffer + i + 8), factor));
+    }
+    scaleScalar(buffer + i, count - i, gain);
+}
+
+MU_AUDIO_TARGET_AVX2
+void applyGainAvx2(float* buffer, const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+                   const gain_t* fromGains, const gain_t* toGains, SignalMeasure* measures)
+{
+    constexpr int LANES = 8;
+    const VectorLayout<LANES> layout(audioChannelsCount);
+    if (!layout.isValid()) {
+        applyGainScalar(buffer, audioChannelsCount, samplesPerChannel, fromGains, toGains, measures);
+        return;
+    }
+
+    alignas(32) float base[MAX_PERIOD_VECTORS * LANES];
+    alignas(32) float step[MAX_PERIOD_VECTORS * LANES];
+    layout.fillGains(audioChannelsCount, samplesPerChannel, fromGains, toGains, base, step);
+
+    __m256 squaredSums[MAX_PERIOD_VECTORS];
+    __m256 peaks[MAX_PERIOD_VECTORS];
+    for (int v = 0; v < layout.vectors; ++v) {
+        squaredSums[v] = _mm256_setzero_ps();
+        peaks[v] = _mm256_setzero_ps();
+    }
+
+    const __m256 signMask = _mm256_set1_ps(-0.f);
+    const samples_t periods = samplesPerChannel / layout.frames;
+    float* data = buffer;
+
+    for (samples_t period = 0; period < periods; ++period) {
+        const __m256 index = _mm256_set1_ps(static_cast<float>(period));
+
+        for (int v = 0; v < layout.vectors; ++v, data += LANES) {
+            const __m256 gain = _mm256_add_ps(_mm256_load_ps(base + v * LANES), _mm256_mul_ps(_mm256_load_ps(step + v * LANES), index));
+            const __m256 sample = _mm256_mul_ps(_mm256_loadu_ps(data), gain);
+            _mm256_storeu_ps(data, sample);
+
+            squaredSums[v] = _mm256_add_ps(squaredSums[v], _mm256_mul_ps(sample, sample));
+            peaks[v] = _mm256_max_ps(peaks[v], _mm256_andnot_ps(signMask, sample));
+        }
+    }
+
+    alignas(32) float laneSquaredSums[MAX_PERIOD_VECTORS * LANES];
+    alignas(32) float lanePeaks[MAX_PERIOD_VECTORS * LANES];
+    for (int v = 0; v < layout.vectors; ++v) {
+        _mm256_store_ps(laneSquaredSums + v * LANES, squaredSums[v]);
+        _mm256_store_ps(lanePeaks + v * LANES, peaks[v]);
+    }
+
+    layout.reduce(audioChannelsCount, laneSquaredSums, lanePeaks, measures);
+    applyGainScalarFrom(buffer, audioChannelsCount, samplesPerChannel, periods * layout.frames, fromGains, toGains, measures);
+}
+
+bool isAvx2Supported()
+{
+#if defined(_MSC_VER)
+    int info[4] = { 0 };
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    __cpuid(info, 1);
+    const bool osUsesXSave = (info[2] & (1 << 27)) != 0;
+    if (!osUsesXSave || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#if defined(MU_AUDIO_SIMD_NEON)
+void mixAddNeon(float* out, const float* in, const samples_t count)
+{
+    samples_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        vst1q_f32(out + i, vaddq_f32(vld1q_f32(out + i), vld1q_f32(in + i)));
+        vst1q_f32(out + i + 4, vaddq_f32(vld1q_f32(out + i + 4), vld1q_f32(in + i + 4)));
+    }
+    mixAddScalar(out + i, in + i, count - i);
+}
+
+void scaleNeon(float* buffer, const samples_t count, const gain_t gain)
+{
+    samples_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        vst1q_f32(buffer + i, vmulq_n_f32(vld1q_f32(buffer + i), gain));
+        vst1q_f32(buffer + i + 4, vmulq_n_f32(vld1q_f32(buffer + i + 4), gain));
+    }
+    scaleScalar(buffer + i, count - i, gain);
+}
+
+void applyGainNeon(float* buffer, const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+                   const gain_t* fromGains, const gain_t* toGains, SignalMeasure* measures)
+{
+    constexpr int LANES = 4;
+    const VectorLayout<LANES> layout(audioChannelsCount);
+    if (!layout.isValid()) {
+        applyGainScalar(buffer, audioChannelsCount, samplesPerChannel, fromGains, toGains, measures);
+        return;
+    }
+
+    alignas(16) float base[MAX_PERIOD_VECTORS * LANES];
+    alignas(16) float step[MAX_PERIOD_VECTORS * LANES];
+    layout.fillGains(audioChannelsCount, samplesPerChannel, fromGains, toGains, base, step);
+
+    float32x4_t squaredSums[MAX_PERIOD_VECTORS];
+    float32x4_t peaks[MAX_PERIOD_VECTORS];
+    for (int v = 0; v < layout.vectors; ++v) {
+        squaredSums[v] = vdupq_n_f32(0.f);
+        peaks[v] = vdupq_n_f32(0.f);
+    }
+
+    const samples_t periods = samplesPerChannel / layout.frames;
+    float* data = buffer;
+
+    for (samples_t period = 0; period < periods; ++period) {
+        const float index = static_cast<float>(period);
+
+        for (int v = 0; v < layout.vectors; ++v, data += LANES) {
+            const float32x4_t gain = vmlaq_n_f32(vld1q_f32(base + v * LANES), vld1q_f32(step + v * LANES), index);
+            const float32x4_t sample = vmulq_f32(vld1q_f32(data), gain);
+            vst1q_f32(data, sample);
+
+            squaredSums[v] = vmlaq_f32(squaredSums[v], sample, sample);
+            peaks[v] = vmaxq_f32(peaks[v], vabsq_f32(sample));
+        }
+    }
+
+    float laneSquaredSums[MAX_PERIOD_VECTORS * LANES];
+    float lanePeaks[MAX_PERIOD_VECTORS * LANES];
+    for (int v = 0; v < layout.vectors; ++v) {
+        vst1q_f32(laneSquaredSums + v * LANES, squaredSums[v]);
+        vst1q_f32(lanePeaks + v * LANES, peaks[v]);
+    }
+
+    layout.reduce(audioChannelsCount, laneSquaredSums, lanePeaks, measures);
+    applyGainScalarFrom(buffer, audioChannelsCount, samplesPerChannel, periods * layout.frames, fromGains, toGains, measures);
+}
+#endif
+
+Kernels selectKernels()
+{
+#if defined(MU_AUDIO_SIMD_AVX2)
+    if (isAvx2Supported()) {
+        return { mixAddAvx2, scaleAvx2, applyGainAvx2, "AVX2" };
+    }
+#endif
+
+#if defined(MU_AUDIO_SIMD_SSE)
+    return { mixAddSse, scaleSse, applyGainSse, "SSE" };
+#elif defined(MU_AUDIO_SIMD_NEON)
+    return { mixAddNeon, scaleNeon, applyGainNeon, "NEON" };
+#else
+    return { mixAddScalar, scaleScalar, applyGainScalar, "scalar" };
+#endif
+}
+
+const Kernels& kernels()
+{
+    static const Kernels s_kernels = selectKernels();
+    return s_kernels;
+}
+}
+
+void mu::audio::dsp::mixAdd(float* out, const float* in, const samples_t count)
+{
+    kernels().mixAdd(out, in, count);
+}
+
+void mu::audio::dsp::scale(float* buffer, const samples_t count, const gain_t gain)
+{
+    kernels().scale(buffer, count, gain);
+}
+
+void mu::audio::dsp::applyGain(float* buffer, const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+                               const gain_t* fromGains, const gain_t* toGains, SignalMeasure* measures)
+{
+    kernels().applyGain(buffer, audioChannelsCount, samplesPerChannel, fromGains, toGains, measures);
+}
+
+const char* mu::audio::dsp::kernelsInstructionSet()
+{
+    return kernels().name;
+}
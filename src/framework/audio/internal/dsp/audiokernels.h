@@ -0,0 +1,51 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_AUDIOKERNELS_H
+#define MU_AUDIO_AUDIOKERNELS_H
+
+#include "audiotypes.h"
+
+//! Vectorized kernels for the hot loops of the mixer.
+//! The instruction set (SSE2, AVX2, NEON or plain C++) is chosen at runtime on first use
+namespace mu::audio::dsp {
+struct SignalMeasure {
+    float squaredSum = 0.f;
+    float peak = 0.f;
+};
+
+//! out[i] += in[i]
+void mixAdd(float* out, const float* in, const samples_t count);
+
+//! buffer[i] *= gain
+void scale(float* buffer, const samples_t count, const gain_t gain);
+
+//! multiply every channel of the interleaved buffer by a gain going linearly
+//! from fromGains[ch] to toGains[ch] over the block, and write the measures of the result per channel
+void applyGain(float* buffer, const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+               const gain_t* fromGains, const gain_t* toGains, SignalMeasure* measures);
+
+//! instruction set the kernels run on
+const char* kernelsInstructionSet();
+}
+
+#endif // MU_AUDIO_AUDIOKERNELS_H
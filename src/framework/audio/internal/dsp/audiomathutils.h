@@ -26,6 +26,14 @@
 #include <cstdlib>
 #include <limits>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MU_AUDIO_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+#define MU_AUDIO_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 #include "audiotypes.h"
 
 namespace mu::audio::dsp {
@@ -70,6 +78,37 @@ inline void multiplySamples(float* buffer, const audioch_t& audioChannelsCount,
     }
 }
 
+//! sum of a[i] * b[i], the kernel of FIR filtering
+inline float dotProduct(const float* a, const float* b, const samples_t count)
+{
+    samples_t i = 0;
+    float sum = 0.f;
+
+#if defined(MU_AUDIO_SIMD_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(MU_AUDIO_SIMD_NEON)
+    float32x4_t acc = vdupq_n_f32(0.f);
+    for (; i + 4 <= count; i += 4) {
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    sum = (vgetq_lane_f32(acc, 0) + vgetq_lane_f32(acc, 1)) + (vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3));
+#endif
+
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+
+    return sum;
+}
+
 template<typename T>
 constexpr T convertFloatSamples(float value)
 {
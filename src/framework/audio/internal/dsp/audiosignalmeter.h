@@ -0,0 +1,83 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_AUDIOSIGNALMETER_H
+#define MU_AUDIO_AUDIOSIGNALMETER_H
+
+#include <algorithm>
+#include <vector>
+
+#include "audiotypes.h"
+#include "audiokernels.h"
+#include "audiomathutils.h"
+
+namespace mu::audio::dsp {
+//! NOTE Accumulates the block measures of every channel and reports RMS values
+//! about UPDATES_PER_SECOND times per second, since the meters can't show anything faster
+//! and every notification is a dB conversion plus a message to the main thread
+class AudioSignalMeter
+{
+public:
+    static constexpr unsigned int UPDATES_PER_SECOND = 30;
+
+    void setSampleRate(const unsigned int sampleRate)
+    {
+        m_windowSamples = std::max(sampleRate / UPDATES_PER_SECOND, 1u);
+    }
+
+    //! measures == nullptr means a silent block
+    void accumulate(const SignalMeasure* measures, const audioch_t audioChannelsCount, const samples_t samplesPerChannel,
+                    AudioSignalsNotifier& notifier)
+    {
+        if (m_squaredSums.size() != audioChannelsCount) {
+            m_squaredSums.assign(audioChannelsCount, 0.f);
+            m_accumulatedSamples = 0;
+        }
+
+        if (measures) {
+            for (audioch_t ch = 0; ch < audioChannelsCount; ++ch) {
+                m_squaredSums[ch] += measures[ch].squaredSum;
+            }
+        }
+
+        m_accumulatedSamples += samplesPerChannel;
+        if (m_accumulatedSamples < m_windowSamples) {
+            return;
+        }
+
+        for (audioch_t ch = 0; ch < audioChannelsCount; ++ch) {
+            float rms = samplesRootMeanSquare(m_squaredSums[ch], m_accumulatedSamples);
+            notifier.updateSignalValues(ch, rms, dbFromSample(rms));
+            m_squaredSums[ch] = 0.f;
+        }
+
+        m_accumulatedSamples = 0;
+    }
+
+private:
+    std::vector<float> m_squaredSums;
+    samples_t m_accumulatedSamples = 0;
+    samples_t m_windowSamples = 1;
+};
+}
+
+#endif // MU_AUDIO_AUDIOSIGNALMETER_H
@@ -0,0 +1,232 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "biquad.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "log.h"
+
+#include "audiomathutils.h"
+
+using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+namespace {
+constexpr size_t STATE_PER_SECTION = 2 * BiquadCascade::LANES;
+constexpr size_t SECTIONS_PER_PASS = 8;
+
+#if defined(MU_AUDIO_SIMD_SSE)
+using Vec = __m128;
+
+inline Vec splat(const float value) { return _mm_set1_ps(value); }
+inline Vec load(const float* data) { return _mm_loadu_ps(data); }
+inline void store(float* data, const Vec value) { _mm_storeu_ps(data, value); }
+inline Vec add(const Vec a, const Vec b) { return _mm_add_ps(a, b); }
+inline Vec sub(const Vec a, const Vec b) { return _mm_sub_ps(a, b); }
+inline Vec mul(const Vec a, const Vec b) { return _mm_mul_ps(a, b); }
+#elif defined(MU_AUDIO_SIMD_NEON)
+using Vec = float32x4_t;
+
+inline Vec splat(const float value) { return vdupq_n_f32(value); }
+inline Vec load(const float* data) { return vld1q_f32(data); }
+inline void store(float* data, const Vec value) { vst1q_f32(data, value); }
+inline Vec add(const Vec a, const Vec b) { return vaddq_f32(a, b); }
+inline Vec sub(const Vec a, const Vec b) { return vsubq_f32(a, b); }
+inline Vec mul(const Vec a, const Vec b) { return vmulq_f32(a, b); }
+#else
+struct Vec {
+    float lanes[BiquadCascade::LANES];
+};
+
+inline Vec splat(const float value) { return { { value, value, value, value } }; }
+inline Vec load(const float* data) { return { { data[0], data[1], data[2], data[3] } }; }
+inline void store(float* data, const Vec value) { std::copy(value.lanes, value.lanes + BiquadCascade::LANES, data); }
+inline Vec add(const Vec a, const Vec b) { return { { a.lanes[0] + b.lanes[0], a.lanes[1] + b.lanes[1], a.lanes[2] + b.lanes[2], a.lanes[3] + b.lanes[3] } }; }
+inline Vec sub(const Vec a, const Vec b) { return { { a.lanes[0] - b.lanes[0], a.lanes[1] - b.lanes[1], a.lanes[2] - b.lanes[2], a.lanes[3] - b.lanes[3] } }; }
+inline Vec mul(const Vec a, const Vec b) { return { { a.lanes[0] * b.lanes[0], a.lanes[1] * b.lanes[1], a.lanes[2] * b.lanes[2], a.lanes[3] * b.lanes[3] } }; }
+#endif
+
+template<audioch_t USED_LANES>
+inline Vec loadLanes(const float* data)
+{
+    if constexpr (USED_LANES == BiquadCascade::LANES) {
+        return load(data);
+    } else {
+        float lanes[BiquadCascade::LANES] = {};
+        std::copy(data, data + USED_LANES, lanes);
+        return load(lanes);
+    }
+}
+
+template<audioch_t USED_LANES>
+inline void storeLanes(float* data, const Vec value)
+{
+    if constexpr (USED_LANES == BiquadCascade::LANES) {
+        store(data, value);
+    } else {
+        float lanes[BiquadCascade::LANES];
+        store(lanes, value);
+        std::copy(lanes, lanes + USED_LANES, data);
+    }
+}
+
+//! Runs up to SECTIONS_PER_PASS sections frame by frame: the sections only depend on each other through
+//! the current frame, so the CPU can overlap their feedback chains instead of waiting on one at a time
+template<audioch_t USED_LANES>
+void processSections(const BiquadCoefficients* coefficients, const size_t sectionsCount, float* state, float* buffer,
+                     const audioch_t stride, const samples_t samplesPerChannel)
+{
+    Vec b0[SECTIONS_PER_PASS], b1[SECTIONS_PER_PASS], b2[SECTIONS_PER_PASS], a1[SECTIONS_PER_PASS], a2[SECTIONS_PER_PASS];
+    Vec z1[SECTIONS_PER_PASS], z2[SECTIONS_PER_PASS];
+
+    for (size_t section = 0; section < sectionsCount; ++section) {
+        b0[section] = splat(coefficients[section].b0);
+        b1[section] = splat(coefficients[section].b1);
+        b2[section] = splat(coefficients[section].b2);
+        a1[section] = splat(coefficients[section].a1);
+        a2[section] = splat(coefficients[section].a2);
+
+        z1[section] = load(state + section * STATE_PER_SECTION);
+        z2[section] = load(state + section * STATE_PER_SECTION + BiquadCascade::LANES);
+    }
+
+    for (samples_t frame = 0; frame < samplesPerChannel; ++frame) {
+        float* data = buffer + frame * stride;
+        Vec x = loadLanes<USED_LANES>(data);
+
+        for (size_t section = 0; section < sectionsCount; ++section) {
+            const Vec y = add(mul(b0[section], x), z1[section]);
+            z1[section] = add(sub(mul(b1[section], x), mul(a1[section], y)), z2[section]);
+            z2[section] = sub(mul(b2[section], x), mul(a2[section], y));
+            x = y;
+        }
+
+        storeLanes<USED_LANES>(data, x);
+    }
+
+    for (size_t section = 0; section < sectionsCount; ++section) {
+        store(state + section * STATE_PER_SECTION, z1[section]);
+        store(state + section * STATE_PER_SECTION + BiquadCascade::LANES, z2[section]);
+    }
+}
+}
+
+BiquadCoefficients BiquadCoefficients::peaking(const unsigned int sampleRate, const float frequency, const volume_db_t gain,
+                                               const float q)
+{
+    IF_ASSERT_FAILED(sampleRate > 0 && q > 0.f) {
+        return BiquadCoefficients();
+    }
+
+    float a = std::pow(10.f, gain / 40.f);
+    float w0 = 2 * M_PI * frequency / sampleRate;
+    float alpha = std::sin(w0) * a / (2 * q);
+    float a0 = 1 + alpha / a;
+
+    BiquadCoefficients result;
+    result.b0 = (1 + alpha * a) / a0;
+    result.b1 = (-2 * std::cos(w0)) / a0;
+    result.b2 = (1 - alpha * a) / a0;
+    result.a1 = (-2 * std::cos(w0)) / a0;
+    result.a2 = (1 - alpha / a) / a0;
+
+    return result;
+}
+
+audioch_t BiquadCascade::audioChannelsCount() const
+{
+    return m_audioChannelsCount;
+}
+
+void BiquadCascade::setAudioChannelsCount(const audioch_t count)
+{
+    if (m_audioChannelsCount == count) {
+        return;
+    }
+
+    m_audioChannelsCount = count;
+    resizeState();
+}
+
+void BiquadCascade::setSections(const std::vector<BiquadCoefficients>& sections)
+{
+    bool sizeChanged = m_sections.size() != sections.size();
+    m_sections = sections;
+
+    if (sizeChanged) {
+        resizeState();
+    }
+}
+
+void BiquadCascade::setSection(const size_t index, const BiquadCoefficients& coefficients)
+{
+    IF_ASSERT_FAILED(index < m_sections.size()) {
+        return;
+    }
+
+    m_sections[index] = coefficients;
+}
+
+void BiquadCascade::reset()
+{
+    std::fill(m_state.begin(), m_state.end(), 0.f);
+}
+
+void BiquadCascade::process(float* buffer, const samples_t samplesPerChannel)
+{
+    const size_t sectionsCount = m_sections.size();
+
+    for (size_t group = 0; group < laneGroupsCount(); ++group) {
+        const audioch_t firstChannel = static_cast<audioch_t>(group * LANES);
+        const audioch_t usedLanes = std::min<audioch_t>(LANES, m_audioChannelsCount - firstChannel);
+        float* groupBuffer = buffer + firstChannel;
+
+        for (size_t section = 0; section < sectionsCount; section += SECTIONS_PER_PASS) {
+            const BiquadCoefficients* coefficients = m_sections.data() + section;
+            const size_t count = std::min(SECTIONS_PER_PASS, sectionsCount - section);
+            float* state = m_state.data() + (group * sectionsCount + section) * STATE_PER_SECTION;
+
+            switch (usedLanes) {
+            case 1: processSections<1>(coefficients, count, state, groupBuffer, m_audioChannelsCount, samplesPerChannel);
+                break;
+            case 2: processSections<2>(coefficients, count, state, groupBuffer, m_audioChannelsCount, samplesPerChannel);
+                break;
+            case 3: processSections<3>(coefficients, count, state, groupBuffer, m_audioChannelsCount, samplesPerChannel);
+                break;
+            default: processSections<LANES>(coefficients, count, state, groupBuffer, m_audioChannelsCount, samplesPerChannel);
+                break;
+            }
+        }
+    }
+}
+
+size_t BiquadCascade::laneGroupsCount() const
+{
+    return (m_audioChannelsCount + LANES - 1) / LANES;
+}
+
+void BiquadCascade::resizeState()
+{
+    m_state.assign(laneGroupsCount() * m_sections.size() * STATE_PER_SECTION, 0.f);
+}
@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_BIQUAD_H
+#define MU_AUDIO_BIQUAD_H
+
+#include <vector>
+
+#include "audiotypes.h"
+
+namespace mu::audio::dsp {
+//! Biquad coefficients normalized by a0
+struct BiquadCoefficients {
+    float b0 = 1.f;
+    float b1 = 0.f;
+    float b2 = 0.f;
+    float a1 = 0.f;
+    float a2 = 0.f;
+
+    static BiquadCoefficients peaking(const unsigned int sampleRate, const float frequency, const volume_db_t gain, const float q);
+};
+
+//! Cascade of biquad sections applied to an interleaved buffer, in transposed direct form II.
+//! The channels are filtered side by side, LANES of them per SIMD vector,
+//! and up to 8 sections are run together frame by frame
+class BiquadCascade
+{
+public:
+    static constexpr audioch_t LANES = 4;
+
+    audioch_t audioChannelsCount() const;
+    void setAudioChannelsCount(const audioch_t count);
+
+    //! the filter state is kept as long as the number of sections doesn't change
+    void setSections(const std::vector<BiquadCoefficients>& sections);
+    void setSection(const size_t index, const BiquadCoefficients& coefficients);
+
+    void reset();
+
+    void process(float* buffer, const samples_t samplesPerChannel);
+
+private:
+    size_t laneGroupsCount() const;
+    void resizeState();
+
+    std::vector<BiquadCoefficients> m_sections;
+    audioch_t m_audioChannelsCount = 0;
+
+    //! z1 and z2 of every lane, per lane group and section
+    std::vector<float> m_state;
+};
+}
+
+#endif // MU_AUDIO_BIQUAD_H
@@ -3,6 +3,7 @@
 #include "log.h"
 
 #include "audiomathutils.h"
+#include "audiokernels.h"
 
 using namespace mu::audio;
 using namespace mu::audio::dsp;
@@ -72,10 +73,8 @@ void Compressor::process(const float linearRms, float* buffer, const audioch_t&
 
     float currentGainReduction = std::min(gainFact, m_previousGainReduction);
 
-    // apply gain
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount; ++audioChNum) {
-        multiplySamples(buffer, audioChannelsCount, audioChNum, samplesPerChannel, currentGainReduction);
-    }
+    // apply gain, constant over the block, so the interleaved buffer is scaled in one pass
+    scale(buffer, samplesPerChannel * audioChannelsCount, currentGainReduction);
 
     m_previousGainReduction = currentGainReduction;
 }
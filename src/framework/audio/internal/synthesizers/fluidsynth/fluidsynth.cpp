@@ -25,15 +25,19 @@
 #include <thread>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <limits>
 #include <fluidsynth.h>
 
 #include "log.h"
 #include "realfn.h"
+#include "concurrency/taskscheduler.h"
 
 #include "sfcachedloader.h"
 #include "audioerrors.h"
 #include "audiotypes.h"
+#include "internal/dsp/audiokernels.h"
 
 using namespace mu;
 using namespace mu::midi;
@@ -50,17 +54,106 @@ static constexpr msecs_t MIN_NOTE_LENGTH = 10;
 /// @see https://www.fluidsynth.org/api/settings_synth.html
 static const audioch_t FLUID_AUDIO_CHANNELS_PAIR = 1;
 
-struct mu::audio::synth::Fluid {
+//! every partition is created with all the voices it can use, see updatePolyphony()
+static constexpr int MAX_POLYPHONY = 512;
+
+//! the extra voice partitions start small and grow when the track gets heavy
+static constexpr int EXTRA_PARTITION_POLYPHONY = 64;
+
+//! below this number of voices the whole track is rendered by one partition on one thread
+static constexpr int PARALLEL_RENDERING_MIN_VOICES = 32;
+
+//! a partition without voices is still rendered for a while, to let its reverb ring out
+static constexpr msecs_t PARTITION_TAIL_MSECS = 3000;
+
+//! NOTE A heavy track splits its voices between several fluid instances ("partitions"),
+//! which are rendered in parallel and summed. Every instance receives all the channel messages,
+//! new notes go to the least busy one. The soundfonts are shared between the instances by the cached loader
+struct FluidPartition {
     fluid_settings_t* settings = nullptr;
     fluid_synth_t* synth = nullptr;
 
-    ~Fluid()
+    std::vector<float> buffer;
+    int polyphony = 0;
+    int activeVoices = 0;
+    samples_t silentSamples = 0;
+
+    FluidPartition() = default;
+    FluidPartition(const FluidPartition&) = delete;
+    FluidPartition& operator=(const FluidPartition&) = delete;
+
+    ~FluidPartition()
     {
         delete_fluid_synth(synth);
         delete_fluid_settings(settings);
     }
 };
 
+struct mu::audio::synth::Fluid {
+    std::vector<std::unique_ptr<FluidPartition> > partitions;
+    std::vector<size_t> partitionsToRender;
+    int activeVoices = 0;
+
+    fluid_synth_t* synth() const
+    {
+        return partitions.empty() ? nullptr : partitions.front()->synth;
+    }
+
+    template<typename Func>
+    void forEachSynth(Func&& func) const
+    {
+        for (const auto& partition : partitions) {
+            func(partition->synth);
+        }
+    }
+
+    fluid_synth_t* noteOnSynth()
+    {
+        if (activeVoices < PARALLEL_RENDERING_MIN_VOICES) {
+            return synth();
+        }
+
+        auto leastBusy = std::min_element(partitions.begin(), partitions.end(), [](const auto& p1, const auto& p2) {
+            return p1->activeVoices < p2->activeVoices;
+        });
+
+        (*leastBusy)->activeVoices++;
+
+        return (*leastBusy)->synth;
+    }
+};
+
+//! Runs the jobs on the calling thread and on up to helpersCount scheduler threads.
+//! The caller only ever waits for jobs which are already running, so this can't deadlock
+//! when all the scheduler threads are busy with other tracks
+template<typename Job>
+static void runInParallel(const size_t jobsCount, const size_t helpersCount, const Job& job)
+{
+    struct Batch {
+        std::atomic<size_t> next = 0;
+        std::atomic<size_t> done = 0;
+    };
+
+    auto batch = std::make_shared<Batch>();
+
+    auto work = [batch, jobsCount, &job]() {
+        for (size_t index = batch->next.fetch_add(1); index < jobsCount; index = batch->next.fetch_add(1)) {
+            job(index);
+            batch->done.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    for (size_t i = 0; i < helpersCount; ++i) {
+        TaskScheduler::instance()->push(work);
+    }
+
+    work();
+
+    while (batch->done.load(std::memory_order_acquire) < jobsCount) {
+        std::this_thread::yield();
+    }
+}
+
 FluidSynth::FluidSynth(const AudioSourceParams& params)
     : AbstractSynthesizer(params)
 {
@@ -71,7 +164,7 @@ FluidSynth::FluidSynth(const AudioSourceParams& params)
 
 bool FluidSynth::isValid() const
 {
-    return m_fluid->synth != nullptr;
+    return m_fluid->synth() != nullptr;
 }
 
 SoundFontFormats FluidSynth::soundFontFormats() const
@@ -110,35 +203,6 @@ Ret FluidSynth::init()
     fluid_set_log_function(FLUID_INFO, fluid_log_out, nullptr);
     fluid_set_log_function(FLUID_DBG, fluid_log_out, nullptr);
 
-    m_fluid->settings = new_fluid_settings();
-    fluid_settings_setnum(m_fluid->settings, "synth.gain", FLUID_GLOBAL_VOLUME_GAIN);
-    fluid_settings_setint(m_fluid->settings, "synth.audio-channels", FLUID_AUDIO_CHANNELS_PAIR); // 1 pair of audio channels
-    fluid_settings_setint(m_fluid->settings, "synth.lock-memory", 0);
-    fluid_settings_setint(m_fluid->settings, "synth.threadsafe-api", 0);
-    fluid_settings_setint(m_fluid->settings, "synth.midi-channels", 16);
-    fluid_settings_setint(m_fluid->settings, "synth.dynamic-sample-loading", 1);
-    fluid_settings_setint(m_fluid->settings, "synth.polyphony", 512);
-
-    if (m_sampleRate > 0) {
-        fluid_settings_setnum(m_fluid->settings, "synth.sample-rate", static_cast<double>(m_sampleRate));
-    }
-
-    fluid_settings_setint(m_fluid->settings, "synth.min-note-length", MIN_NOTE_LENGTH);
-
-    fluid_settings_setint(m_fluid->settings, "synth.chorus.active", 0);
-    fluid_settings_setnum(m_fluid->settings, "synth.chorus.depth", 8);
-    fluid_settings_setnum(m_fluid->settings, "synth.chorus.level", 10);
-    fluid_settings_setint(m_fluid->settings, "synth.chorus.nr", 4);
-    fluid_settings_setnum(m_fluid->settings, "synth.chorus.speed", 1);
-
-    fluid_settings_setint(m_fluid->settings, "synth.reverb.active", 1);
-    fluid_settings_setnum(m_fluid->settings, "synth.reverb.room-size", 0.6);
-    fluid_settings_setnum(m_fluid->settings, "synth.reverb.damp", 0.8);
-    fluid_settings_setnum(m_fluid->settings, "synth.reverb.width", 10.0);
-    fluid_settings_setnum(m_fluid->settings, "synth.reverb.level", 0.5);
-
-    fluid_settings_setstr(m_fluid->settings, "audio.sample-format", "float");
-
     createFluidInstance();
 
     m_sequencer.flushedOffStreamEvents().onNotify(this, [this]() {
@@ -149,14 +213,62 @@ Ret FluidSynth::init()
     return true;
 }
 
+static fluid_settings_t* createSettings(const samples_t sampleRate, const int polyphony)
+{
+    fluid_settings_t* settings = new_fluid_settings();
+    fluid_settings_setnum(settings, "synth.gain", FLUID_GLOBAL_VOLUME_GAIN);
+    fluid_settings_setint(settings, "synth.audio-channels", FLUID_AUDIO_CHANNELS_PAIR); // 1 pair of audio channels
+    fluid_settings_setint(settings, "synth.lock-memory", 0);
+    fluid_settings_setint(settings, "synth.threadsafe-api", 0);
+    fluid_settings_setint(settings, "synth.midi-channels", 16);
+    fluid_settings_setint(settings, "synth.dynamic-sample-loading", 1);
+    fluid_settings_setint(settings, "synth.polyphony", polyphony);
+
+    if (sampleRate > 0) {
+        fluid_settings_setnum(settings, "synth.sample-rate", static_cast<double>(sampleRate));
+    }
+
+    fluid_settings_setint(settings, "synth.min-note-length", MIN_NOTE_LENGTH);
+
+    fluid_settings_setint(settings, "synth.chorus.active", 0);
+    fluid_settings_setnum(settings, "synth.chorus.depth", 8);
+    fluid_settings_setnum(settings, "synth.chorus.level", 10);
+    fluid_settings_setint(settings, "synth.chorus.nr", 4);
+    fluid_settings_setnum(settings, "synth.chorus.speed", 1);
+
+    fluid_settings_setint(settings, "synth.reverb.active", 1);
+    fluid_settings_setnum(settings, "synth.reverb.room-size", 0.6);
+    fluid_settings_setnum(settings, "synth.reverb.damp", 0.8);
+    fluid_settings_setnum(settings, "synth.reverb.width", 10.0);
+    fluid_settings_setnum(settings, "synth.reverb.level", 0.5);
+
+    fluid_settings_setstr(settings, "audio.sample-format", "float");
+
+    return settings;
+}
+
 void FluidSynth::createFluidInstance()
 {
-    m_fluid->synth = new_fluid_synth(m_fluid->settings);
+    m_fluid->partitions.clear();
+    m_fluid->activeVoices = 0;
+
+    //! NOTE Every partition gets its own settings: fluid binds the settings callbacks to the last synth created with them
+    int partitionsCount = VoiceBudget::instance()->renderThreadsPerSynth();
+
+    for (int i = 0; i < partitionsCount; ++i) {
+        auto partition = std::make_unique<FluidPartition>();
+        partition->settings = createSettings(m_sampleRate, MAX_POLYPHONY);
+        partition->synth = new_fluid_synth(partition->settings);
+        partition->polyphony = fluid_synth_limit_polyphony(partition->synth, i == 0 ? MAX_POLYPHONY : EXTRA_PARTITION_POLYPHONY);
+        partition->silentSamples = std::numeric_limits<samples_t>::max() / 2;
 
-    fluid_sfloader_t* sfloader = new_fluid_sfloader(loadSoundFont, delete_fluid_sfloader);
+        fluid_sfloader_t* sfloader = new_fluid_sfloader(loadSoundFont, delete_fluid_sfloader);
 
-    fluid_sfloader_set_data(sfloader, m_fluid->settings);
-    fluid_synth_add_sfloader(m_fluid->synth, sfloader);
+        fluid_sfloader_set_data(sfloader, partition->settings);
+        fluid_synth_add_sfloader(partition->synth, sfloader);
+
+        m_fluid->partitions.push_back(std::move(partition));
+    }
 }
 
 bool FluidSynth::handleEvent(const midi::Event& event)
@@ -164,11 +276,17 @@ bool FluidSynth::handleEvent(const midi::Event& event)
     int ret = FLUID_OK;
     switch (event.opcode()) {
     case Event::Opcode::NoteOn: {
-        ret = fluid_synth_noteon(m_fluid->synth, event.channel(), event.note(), event.velocity());
+        ret = fluid_synth_noteon(m_fluid->noteOnSynth(), event.channel(), event.note(), event.velocity());
         m_tuning.add(event.note(), event.pitchTuningCents());
     } break;
     case Event::Opcode::NoteOff: {
-        ret = fluid_synth_noteoff(m_fluid->synth, event.channel(), event.note());
+        // the note may sound in any partition, the others just ignore the note off
+        ret = FLUID_FAILED;
+        m_fluid->forEachSynth([&ret, &event](fluid_synth_t* synth) {
+            if (fluid_synth_noteoff(synth, event.channel(), event.note()) == FLUID_OK) {
+                ret = FLUID_OK;
+            }
+        });
         m_tuning.add(event.note(), event.pitchTuningCents());
     } break;
     case Event::Opcode::ControlChange: {
@@ -179,10 +297,14 @@ bool FluidSynth::handleEvent(const midi::Event& event)
         }
     } break;
     case Event::Opcode::ProgramChange: {
-        fluid_synth_program_change(m_fluid->synth, event.channel(), event.program());
+        m_fluid->forEachSynth([&event](fluid_synth_t* synth) {
+            fluid_synth_program_change(synth, event.channel(), event.program());
+        });
     } break;
     case Event::Opcode::PitchBend: {
-        ret = fluid_synth_pitch_bend(m_fluid->synth, event.channel(), event.data());
+        m_fluid->forEachSynth([&ret, &event](fluid_synth_t* synth) {
+            ret = fluid_synth_pitch_bend(synth, event.channel(), event.data());
+        });
     } break;
     default: {
         LOGD() << "not supported event type: " << event.opcodeString();
@@ -202,13 +324,6 @@ void FluidSynth::setSampleRate(unsigned int sampleRate)
     }
 
     m_sampleRate = sampleRate;
-    if (m_fluid->settings) {
-        fluid_settings_setnum(m_fluid->settings, "synth.sample-rate", static_cast<double>(m_sampleRate));
-    }
-
-    if (m_fluid->synth) {
-        delete_fluid_synth(m_fluid->synth);
-    }
 
     createFluidInstance();
     addSoundFonts(std::vector<io::path_t>(m_sfontPaths.cbegin(), m_sfontPaths.cend()));
@@ -217,13 +332,18 @@ void FluidSynth::setSampleRate(unsigned int sampleRate)
 
 Ret FluidSynth::addSoundFonts(const std::vector<io::path_t>& sfonts)
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->synth()) {
         return make_ret(Err::SynthNotInited);
     }
 
     bool ok = true;
     for (const io::path_t& sfont : sfonts) {
-        if (fluid_synth_sfload(m_fluid->synth, sfont.c_str(), 0) == FLUID_FAILED) {
+        bool loaded = true;
+        m_fluid->forEachSynth([&loaded, &sfont](fluid_synth_t* synth) {
+            loaded = loaded && fluid_synth_sfload(synth, sfont.c_str(), 0) != FLUID_FAILED;
+        });
+
+        if (!loaded) {
             LOGE() << "failed load soundfont: " << sfont;
             ok = false;
             continue;
@@ -248,22 +368,26 @@ AudioSourceType FluidSynth::type() const
 
 void FluidSynth::setupSound(const PlaybackSetupData& setupData)
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->synth()) {
         return;
     }
 
-    fluid_synth_activate_key_tuning(m_fluid->synth, 0, 0, "standard", NULL, true);
+    m_fluid->forEachSynth([](fluid_synth_t* synth) {
+        fluid_synth_activate_key_tuning(synth, 0, 0, "standard", NULL, true);
+    });
 
     auto setupChannel = [this](const midi::channel_t channelIdx, const midi::Program& program) {
-        fluid_synth_set_interp_method(m_fluid->synth, channelIdx, FLUID_INTERP_DEFAULT);
-        fluid_synth_pitch_wheel_sens(m_fluid->synth, channelIdx, 24);
-        fluid_synth_bank_select(m_fluid->synth, channelIdx, program.bank);
-        fluid_synth_program_change(m_fluid->synth, channelIdx, program.program);
-        fluid_synth_cc(m_fluid->synth, channelIdx, 7, DEFAULT_MIDI_VOLUME);
-        fluid_synth_cc(m_fluid->synth, channelIdx, 74, 0);
-        fluid_synth_set_portamento_mode(m_fluid->synth, channelIdx, FLUID_CHANNEL_PORTAMENTO_MODE_EACH_NOTE);
-        fluid_synth_set_legato_mode(m_fluid->synth, channelIdx, FLUID_CHANNEL_LEGATO_MODE_RETRIGGER);
-        fluid_synth_activate_tuning(m_fluid->synth, channelIdx, 0, 0, 0);
+        m_fluid->forEachSynth([channelIdx, &program](fluid_synth_t* synth) {
+            fluid_synth_set_interp_method(synth, channelIdx, FLUID_INTERP_DEFAULT);
+            fluid_synth_pitch_wheel_sens(synth, channelIdx, 24);
+            fluid_synth_bank_select(synth, channelIdx, program.bank);
+            fluid_synth_program_change(synth, channelIdx, program.program);
+            fluid_synth_cc(synth, channelIdx, 7, DEFAULT_MIDI_VOLUME);
+            fluid_synth_cc(synth, channelIdx, 74, 0);
+            fluid_synth_set_portamento_mode(synth, channelIdx, FLUID_CHANNEL_PORTAMENTO_MODE_EACH_NOTE);
+            fluid_synth_set_legato_mode(synth, channelIdx, FLUID_CHANNEL_LEGATO_MODE_RETRIGGER);
+            fluid_synth_activate_tuning(synth, channelIdx, 0, 0, 0);
+        });
     };
 
     m_sequencer.channelAdded().onReceive(this, setupChannel);
@@ -284,23 +408,27 @@ void FluidSynth::setupEvents(const mpe::PlaybackData& playbackData)
 
 void FluidSynth::revokePlayingNotes()
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->synth()) {
         return;
     }
 
-    fluid_synth_all_notes_off(m_fluid->synth, -1);
+    m_fluid->forEachSynth([](fluid_synth_t* synth) {
+        fluid_synth_all_notes_off(synth, -1);
+    });
 }
 
 void FluidSynth::flushSound()
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->synth()) {
         return;
     }
 
     revokePlayingNotes();
 
-    fluid_synth_all_sounds_off(m_fluid->synth, -1);
-    fluid_synth_cc(m_fluid->synth, -1, 121, 127);
+    m_fluid->forEachSynth([](fluid_synth_t* synth) {
+        fluid_synth_all_sounds_off(synth, -1);
+        fluid_synth_cc(synth, -1, 121, 127);
+    });
 }
 
 bool FluidSynth::isActive() const
@@ -335,6 +463,8 @@ unsigned int FluidSynth::audioChannelsCount() const
 
 samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
 {
+    TRACEFUNC;
+
     IF_ASSERT_FAILED(samplesPerChannel > 0) {
         return 0;
     }
@@ -351,21 +481,109 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
         handleEvent(std::get<midi::Event>(event));
     }
 
-    fluid_synth_tune_notes(m_fluid->synth, 0, 0, m_tuning.size(), m_tuning.keys.data(), m_tuning.pitches.data(), true);
-
-    unsigned int channelCount = audioChannelsCount();
-
-    int result = fluid_synth_write_float(m_fluid->synth, samplesPerChannel,
-                                         buffer, 0, channelCount,
-                                         buffer, 1, channelCount);
+    m_fluid->forEachSynth([this](fluid_synth_t* synth) {
+        fluid_synth_tune_notes(synth, 0, 0, m_tuning.size(), m_tuning.keys.data(), m_tuning.pitches.data(), true);
+    });
 
-    if (result != FLUID_OK) {
+    if (!renderPartitions(buffer, samplesPerChannel)) {
         return 0;
     }
 
+    updatePolyphony();
+
     return samplesPerChannel;
 }
 
+bool FluidSynth::renderPartitions(float* buffer, samples_t samplesPerChannel)
+{
+    const unsigned int channelCount = audioChannelsCount();
+    const samples_t tailSamples = PARTITION_TAIL_MSECS * m_sampleRate / 1000;
+
+    // the first partition renders straight into the output, the others only while they have something to play
+    std::vector<size_t>& toRender = m_fluid->partitionsToRender;
+    toRender.clear();
+
+    for (size_t i = 1; i < m_fluid->partitions.size(); ++i) {
+        FluidPartition& partition = *m_fluid->partitions[i];
+        partition.silentSamples = partition.activeVoices > 0 ? 0 : partition.silentSamples + samplesPerChannel;
+
+        if (partition.silentSamples < tailSamples) {
+            partition.buffer.resize(samplesPerChannel * channelCount);
+            toRender.push_back(i);
+        }
+    }
+
+    std::atomic<bool> ok = true;
+
+    auto render = [this, buffer, samplesPerChannel, channelCount, &ok](size_t job) {
+        FluidPartition& partition = job == 0 ? *m_fluid->partitions.front() : *m_fluid->partitions[m_fluid->partitionsToRender[job - 1]];
+        float* output = job == 0 ? buffer : partition.buffer.data();
+
+        int result = fluid_synth_write_float(partition.synth, samplesPerChannel,
+                                             output, 0, channelCount,
+                                             output, 1, channelCount);
+
+        if (result != FLUID_OK) {
+            ok = false;
+        }
+    };
+
+    if (toRender.empty()) {
+        render(0);
+    } else {
+        size_t helpers = std::min<size_t>(toRender.size(), VoiceBudget::instance()->renderThreadsPerSynth() - 1);
+        runInParallel(toRender.size() + 1, helpers, render);
+
+        for (size_t i : toRender) {
+            dsp::mixAdd(buffer, m_fluid->partitions[i]->buffer.data(), samplesPerChannel * channelCount);
+        }
+    }
+
+    return ok;
+}
+
+void FluidSynth::updatePolyphony()
+{
+    m_fluid->activeVoices = 0;
+    for (const auto& partition : m_fluid->partitions) {
+        partition->activeVoices = fluid_synth_get_active_voice_count(partition->synth);
+        m_fluid->activeVoices += partition->activeVoices;
+    }
+
+    if (!m_voiceBudgetEntry) {
+        m_voiceBudgetEntry = VoiceBudget::instance()->registerSynth();
+    }
+
+    //! NOTE The playing voices are never cut: fluid_synth_set_polyphony() would turn off the voices above
+    //! a lowered limit and allocate voices when it is raised, so only the limit for new notes is moved,
+    //! and never below the last playing voice. When there is no room left a new note makes fluid
+    //! steal the least important voice of its partition (released, quiet or old ones first)
+    int allowedVoices = VoiceBudget::instance()->allowedVoices(m_voiceBudgetEntry, m_fluid->activeVoices);
+    int freeVoices = allowedVoices == VoiceBudget::UNLIMITED ? MAX_POLYPHONY : std::max(allowedVoices - m_fluid->activeVoices, 0);
+
+    // the extra partitions only get new notes when the track is heavy,
+    // the free voices are split between the partitions that get them, so that the track doesn't exceed its allowance
+    bool isHeavy = m_fluid->activeVoices >= PARALLEL_RENDERING_MIN_VOICES;
+    int newNotesPartitions = isHeavy ? static_cast<int>(m_fluid->partitions.size()) : 1;
+
+    for (int i = 0; i < static_cast<int>(m_fluid->partitions.size()); ++i) {
+        FluidPartition* partition = m_fluid->partitions[i].get();
+
+        int partitionFreeVoices = 0;
+        if (i < newNotesPartitions) {
+            partitionFreeVoices = allowedVoices == VoiceBudget::UNLIMITED
+                                  ? freeVoices
+                                  : VoiceBudget::splitVoices(freeVoices, i, newNotesPartitions);
+        }
+
+        int polyphony = std::clamp(partition->activeVoices + partitionFreeVoices, 1, MAX_POLYPHONY);
+
+        if (polyphony != partition->polyphony) {
+            partition->polyphony = fluid_synth_limit_polyphony(partition->synth, polyphony);
+        }
+    }
+}
+
 async::Channel<unsigned int> FluidSynth::audioChannelsCountChanged() const
 {
     return m_streamsCountChanged;
@@ -386,9 +604,11 @@ int FluidSynth::setExpressionLevel(int level)
 {
     midi::channel_t lastChannelIdx = m_sequencer.channels().lastIndex();
 
-    for (midi::channel_t i = 0; i < lastChannelIdx; ++i) {
-        fluid_synth_cc(m_fluid->synth, i, midi::EXPRESSION_CONTROLLER, level);
-    }
+    m_fluid->forEachSynth([lastChannelIdx, level](fluid_synth_t* synth) {
+        for (midi::channel_t i = 0; i < lastChannelIdx; ++i) {
+            fluid_synth_cc(synth, i, midi::EXPRESSION_CONTROLLER, level);
+        }
+    });
 
     return FLUID_OK;
 }
@@ -396,11 +616,16 @@ int FluidSynth::setExpressionLevel(int level)
 int FluidSynth::setControllerValue(const midi::Event& event)
 {
     int currentValue = 0;
-    fluid_synth_get_cc(m_fluid->synth, event.channel(), event.index(), &currentValue);
+    fluid_synth_get_cc(m_fluid->synth(), event.channel(), event.index(), &currentValue);
 
     if (event.data() == static_cast<uint32_t>(currentValue)) {
         return FLUID_OK;
     }
 
-    return fluid_synth_cc(m_fluid->synth, event.channel(), event.index(),  event.data());
+    int ret = FLUID_OK;
+    m_fluid->forEachSynth([&ret, &event](fluid_synth_t* synth) {
+        ret = fluid_synth_cc(synth, event.channel(), event.index(), event.data());
+    });
+
+    return ret;
 }
@@ -36,6 +36,7 @@
 #include "abstractsynthesizer.h"
 #include "fluidsequencer.h"
 #include "soundmapping.h"
+#include "internal/synthesizers/voicebudget.h"
 
 namespace mu::audio::synth {
 struct Fluid;
@@ -100,6 +101,9 @@ private:
     Ret init();
     void createFluidInstance();
 
+    bool renderPartitions(float* buffer, samples_t samplesPerChannel);
+    void updatePolyphony();
+
     bool handleEvent(const midi::Event& event);
 
     void toggleExpressionController();
@@ -115,6 +119,8 @@ private:
     std::set<io::path_t> m_sfontPaths;
 
     KeyTuning m_tuning;
+
+    VoiceBudget::EntryPtr m_voiceBudgetEntry;
 };
 
 using FluidSynthPtr = std::shared_ptr<FluidSynth>;
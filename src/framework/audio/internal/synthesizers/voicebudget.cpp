@@ -0,0 +1,104 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "voicebudget.h"
+
+#include <algorithm>
+
+using namespace mu::audio::synth;
+
+struct VoiceBudget::Entry {
+    explicit Entry(VoiceBudget* budget)
+        : budget(budget)
+    {
+        budget->m_synthsCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~Entry()
+    {
+        budget->m_activeVoices.fetch_sub(activeVoices, std::memory_order_relaxed);
+        budget->m_synthsCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    VoiceBudget* budget = nullptr;
+    int activeVoices = 0;
+};
+
+VoiceBudget* VoiceBudget::instance()
+{
+    static VoiceBudget s;
+    return &s;
+}
+
+int VoiceBudget::maxVoices() const
+{
+    return m_maxVoices.load(std::memory_order_relaxed);
+}
+
+void VoiceBudget::setMaxVoices(int voices)
+{
+    m_maxVoices.store(std::max(voices, 0), std::memory_order_relaxed);
+}
+
+int VoiceBudget::renderThreadsPerSynth() const
+{
+    return m_renderThreadsPerSynth.load(std::memory_order_relaxed);
+}
+
+void VoiceBudget::setRenderThreadsPerSynth(int threads)
+{
+    m_renderThreadsPerSynth.store(std::max(threads, 1), std::memory_order_relaxed);
+}
+
+VoiceBudget::EntryPtr VoiceBudget::registerSynth()
+{
+    return std::make_shared<Entry>(this);
+}
+
+int VoiceBudget::allowedVoices(const EntryPtr& entry, int activeVoices)
+{
+    if (!entry) {
+        return UNLIMITED;
+    }
+
+    int othersActiveVoices = m_activeVoices.fetch_add(activeVoices - entry->activeVoices, std::memory_order_relaxed)
+                             - entry->activeVoices;
+    entry->activeVoices = activeVoices;
+
+    int maxVoices = this->maxVoices();
+    if (maxVoices == UNLIMITED) {
+        return UNLIMITED;
+    }
+
+    int fairShare = maxVoices / std::max(m_synthsCount.load(std::memory_order_relaxed), 1);
+
+    return std::max({ maxVoices - othersActiveVoices, fairShare, 1 });
+}
+
+int VoiceBudget::splitVoices(int voices, int partition, int partitionsCount)
+{
+    if (partitionsCount <= 1) {
+        return voices;
+    }
+
+    return voices / partitionsCount + (partition < voices % partitionsCount ? 1 : 0);
+}
@@ -0,0 +1,70 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_VOICEBUDGET_H
+#define MU_AUDIO_VOICEBUDGET_H
+
+#include <atomic>
+#include <memory>
+
+namespace mu::audio::synth {
+//! NOTE Shares a global number of voices between all the synthesizers, which render on different threads.
+//! Every synthesizer reports its active voices once per block and gets back how many it may use:
+//! what the others leave free, but never less than an even share of the budget.
+//! A synthesizer that reaches its allowance steals its own least important voices
+//! instead of pushing the total CPU load further
+class VoiceBudget
+{
+public:
+    static VoiceBudget* instance();
+
+    static constexpr int UNLIMITED = 0;
+
+    struct Entry;
+    using EntryPtr = std::shared_ptr<Entry>;
+
+    int maxVoices() const;
+    void setMaxVoices(int voices);
+
+    //! how many threads may render the voices of one synthesizer
+    int renderThreadsPerSynth() const;
+    void setRenderThreadsPerSynth(int threads);
+
+    EntryPtr registerSynth();
+
+    //! returns the number of voices the synthesizer may use, UNLIMITED if there is no budget
+    int allowedVoices(const EntryPtr& entry, int activeVoices);
+
+    //! returns the part of the voices that the given one of the synthesizer's voice partitions may start,
+    //! so that all the partitions together don't start more than the voices
+    static int splitVoices(int voices, int partition, int partitionsCount);
+
+private:
+    std::atomic<int> m_maxVoices = UNLIMITED;
+    std::atomic<int> m_renderThreadsPerSynth = 1;
+
+    std::atomic<int> m_activeVoices = 0;
+    std::atomic<int> m_synthsCount = 0;
+};
+}
+
+#endif // MU_AUDIO_VOICEBUDGET_H
@@ -20,6 +20,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "audiostream.h"
+
+#include <algorithm>
+
 #include "log.h"
 
 #define DR_WAV_IMPLEMENTATION
@@ -38,7 +41,7 @@
 using namespace mu::audio;
 
 AudioStream::AudioStream()
-    : m_src(m_data, 0, 1, 1)
+    : m_src(0, 1, 1)
 {
 }
 
@@ -48,6 +51,7 @@ bool AudioStream::loadFile(const io::path_t& path)
     if (loaded) {
         m_src.setChannelCount(m_channels);
         m_src.setSampleRateIn(m_sampleRate);
+        m_srcSampleRate = 0;
     }
     return loaded;
 }
@@ -55,9 +59,11 @@ bool AudioStream::loadFile(const io::path_t& path)
 void AudioStream::convertSampleRate(unsigned int sampleRate)
 {
     if (sampleRate != m_sampleRate) {
-        auto src = new SampleRateConvertor(m_data, m_channels, m_sampleRate, sampleRate);
-        m_data = src->convert();
+        SampleRateConvertor src(m_channels, m_sampleRate, sampleRate);
+        m_data = src.convert(m_data);
         m_sampleRate = sampleRate;
+        m_src.setSampleRateIn(m_sampleRate);
+        m_srcSampleRate = 0;
     }
 }
 
@@ -74,9 +80,34 @@ unsigned int AudioStream::sampleRate() const
 unsigned int AudioStream::copySamplesToBuffer(float* buffer, unsigned int fromSample, unsigned int sampleCount, unsigned int sampleRate)
 {
     if (m_sampleRate != sampleRate) {
-        m_src.setSampleRateOut(sampleRate);
-
-        return m_src.convert(buffer, fromSample, sampleCount);
+        if (m_srcSampleRate != sampleRate || m_srcOutputFrame != fromSample) {
+            m_src.setSampleRateOut(sampleRate);
+            m_srcSampleRate = sampleRate;
+            m_srcInputFrame = m_src.seek(fromSample);
+        }
+
+        samples_t framesCount = m_data.size() / m_channels;
+        samples_t used = 0;
+        samples_t generated = 0;
+        if (m_srcInputFrame < framesCount) {
+            m_src.process(m_data.data() + m_srcInputFrame * m_channels, framesCount - m_srcInputFrame, used,
+                          buffer, sampleCount, generated);
+        }
+
+        m_srcInputFrame += used;
+
+        //! NOTE The last frames are still in the filter when the data is used up, they are flushed until the end of the stream
+        samples_t outputFramesCount = framesCount * sampleRate / m_sampleRate;
+        samples_t outputEnd = std::min<samples_t>(fromSample + sampleCount, outputFramesCount);
+        if (m_srcInputFrame >= framesCount && fromSample + generated < outputEnd) {
+            samples_t flushed = 0;
+            m_src.flush(buffer + generated * m_channels, outputEnd - fromSample - generated, flushed);
+            generated += flushed;
+        }
+
+        m_srcOutputFrame = fromSample + generated;
+
+        return static_cast<unsigned int>(generated);
     }
 
     auto from = fromSample * m_channels;
@@ -57,6 +57,11 @@ private:
     unsigned int m_sampleRate = 1;
     std::vector<float> m_data = {};
     SampleRateConvertor m_src;
+
+    //! position of the streaming conversion, to continue it without seeking
+    unsigned int m_srcSampleRate = 0;
+    samples_t m_srcInputFrame = 0;
+    samples_t m_srcOutputFrame = 0;
 };
 }
 
@@ -27,12 +27,25 @@
 
 using namespace mu::audio;
 
+static constexpr audioch_t DEFAULT_AUDIO_CHANNELS_COUNT = 2;
+
+Equaliser::Equaliser()
+{
+    m_filter.setAudioChannelsCount(DEFAULT_AUDIO_CHANNELS_COUNT);
+    m_filter.setSections({ dsp::BiquadCoefficients() });
+}
+
 void Equaliser::setSampleRate(unsigned int sampleRate)
 {
     m_sampleRate = sampleRate;
     calculate();
 }
 
+void Equaliser::setAudioChannelsCount(audioch_t count)
+{
+    m_filter.setAudioChannelsCount(count);
+}
+
 bool Equaliser::active() const
 {
     return m_active;
@@ -43,19 +56,9 @@ void Equaliser::setActive(bool active)
     m_active = active;
 }
 
-void Equaliser::process(float* buffer, unsigned int sampleCount)
+void Equaliser::process(float* buffer, unsigned int samplesPerChannel)
 {
-    for (unsigned int i = 0; i < sampleCount; ++i) {
-        m_x[2] = m_x[1];
-        m_x[1] = m_x[0];
-        m_x[0] = buffer[i];
-
-        m_y[2] = m_y[1];
-        m_y[1] = m_y[0];
-        m_y[0] = (m_b[2] * m_x[2] + m_b[1] * m_x[1] + m_b[0] * m_x[0] - m_a[1] * m_y[1] - m_a[2] * m_y[2]) / m_a[0];
-
-        buffer[i] = m_y[0];
-    }
+    m_filter.process(buffer, samplesPerChannel);
 }
 
 void Equaliser::calculate()
@@ -63,17 +66,8 @@ void Equaliser::calculate()
     if (!m_sampleRate) {
         return;
     }
-    float a = std::pow(10.f, m_gain / 40.f);
-    float w0 = 2 * M_PI * m_frequency / m_sampleRate;
-    float alpha = std::sin(w0) * a / (2 * m_q);
-
-    m_b[0] = 1 + alpha * a;
-    m_b[1] = -2 * std::cos(w0);
-    m_b[2] = 1 - alpha * a;
 
-    m_a[0] = 1 + alpha / a;
-    m_a[1] = -2 * std::cos(w0);
-    m_a[2] = 1 - alpha / a;
+    m_filter.setSection(0, dsp::BiquadCoefficients::peaking(m_sampleRate, m_frequency, m_gain, m_q));
 }
 
 void mu::audio::Equaliser::setFrequency(float value)
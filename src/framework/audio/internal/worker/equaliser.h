@@ -23,6 +23,7 @@
 #define MU_AUDIO_EQUALISER_H
 
 #include "ifxprocessor.h"
+#include "internal/dsp/biquad.h"
 
 namespace mu::audio {
 class Equaliser : public IFxProcessor
@@ -31,6 +32,7 @@ public:
     Equaliser();
 
     void setSampleRate(unsigned int sampleRate) override;
+    void setAudioChannelsCount(audioch_t count);
 
     bool active() const override;
     void setActive(bool active) override;
@@ -39,7 +41,7 @@ public:
     void setGain(float value);
     void setQ(float value);
 
-    void process(float* buffer, unsigned int sampleCount) override;
+    void process(float* buffer, unsigned int samplesPerChannel) override;
 
 private:
     void calculate();
@@ -48,10 +50,7 @@ private:
     bool m_active = true;
 
     float m_gain = 0, m_frequency = 1000.f, m_q = 1.f;
-    float m_a[3] = { 0, 0, 0 };
-    float m_b[3] = { 0, 0, 0 };
-    float m_x[3] = { 0, 0, 0 };
-    float m_y[3] = { 0, 0, 0 };
+    dsp::BiquadCascade m_filter;
 };
 }
 
@@ -99,6 +99,7 @@ void Mixer::setSampleRate(unsigned int sampleRate)
     ONLY_AUDIO_WORKER_THREAD;
 
     m_limiter = std::make_unique<dsp::Limiter>(sampleRate);
+    m_signalMeter.setSampleRate(sampleRate);
 
     AbstractAudioSource::setSampleRate(sampleRate);
 
@@ -116,6 +117,8 @@ unsigned int Mixer::audioChannelsCount() const
 
 samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 {
+    TRACEFUNC;
+
     ONLY_AUDIO_WORKER_THREAD;
 
     for (IClockPtr clock : m_clocks) {
@@ -158,9 +161,7 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     }
 
     if (m_masterParams.muted || masterChannelSampleCount == 0) {
-        for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-            notifyAboutAudioSignalChanges(audioChNum, 0);
-        }
+        notifyAboutSilence(samplesPerChannel);
         return 0;
     }
 
@@ -276,13 +277,7 @@ void Mixer::mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int
         return;
     }
 
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        for (samples_t s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
-
-            outBuffer[idx] += inBuffer[idx];
-        }
-    }
+    dsp::mixAdd(outBuffer, inBuffer, samplesCount * audioChannelsCount());
 }
 
 void Mixer::completeOutput(float* buffer, const samples_t& samplesPerChannel)
@@ -291,37 +286,41 @@ void Mixer::completeOutput(float* buffer, const samples_t& samplesPerChannel)
         return;
     }
 
-    float totalSquaredSum = 0.f;
-
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
-
-        gain_t totalGain = dsp::balanceGain(m_masterParams.balance, audioChNum) * dsp::linearFromDecibels(m_masterParams.volume);
+    const audioch_t channelsCount = audioChannelsCount();
+    if (channelsCount == 0 || samplesPerChannel == 0) {
+        return;
+    }
 
-        for (samples_t s = 0; s < samplesPerChannel; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
+    const gain_t volumeGain = dsp::linearFromDecibels(m_masterParams.volume);
+    m_gains.resize(channelsCount);
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        m_gains[audioChNum] = dsp::balanceGain(m_masterParams.balance, audioChNum) * volumeGain;
+    }
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    if (m_previousGains.size() != channelsCount) {
+        m_previousGains = m_gains;
+    }
 
-            float squaredSample = resultSample * resultSample;
-            totalSquaredSum += squaredSample;
-            singleChannelSquaredSum += squaredSample;
-        }
+    m_measures.resize(channelsCount);
+    dsp::applyGain(buffer, channelsCount, samplesPerChannel, m_previousGains.data(), m_gains.data(), m_measures.data());
+    std::swap(m_previousGains, m_gains);
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesPerChannel);
-        notifyAboutAudioSignalChanges(audioChNum, rms);
-    }
+    m_signalMeter.accumulate(m_measures.data(), channelsCount, samplesPerChannel, m_audioSignalNotifier);
 
     if (!m_limiter->isActive()) {
         return;
     }
 
-    float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesPerChannel * audioChannelsCount());
-    m_limiter->process(totalRms, buffer, audioChannelsCount(), samplesPerChannel);
+    float totalSquaredSum = 0.f;
+    for (const dsp::SignalMeasure& measure : m_measures) {
+        totalSquaredSum += measure.squaredSum;
+    }
+
+    float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesPerChannel * channelsCount);
+    m_limiter->process(totalRms, buffer, channelsCount, samplesPerChannel);
 }
 
-void Mixer::notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const
+void Mixer::notifyAboutSilence(const samples_t samplesPerChannel)
 {
-    m_audioSignalNotifier.updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
+    m_signalMeter.accumulate(nullptr, audioChannelsCount(), samplesPerChannel, m_audioSignalNotifier);
 }
@@ -31,6 +31,8 @@
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
 #include "internal/dsp/limiter.h"
+#include "internal/dsp/audiokernels.h"
+#include "internal/dsp/audiosignalmeter.h"
 #include "ifxresolver.h"
 #include "iclock.h"
 
@@ -68,7 +70,7 @@ public:
 private:
     void mixOutputFromChannel(float* outBuffer, float* inBuffer, unsigned int samplesCount);
     void completeOutput(float* buffer, const samples_t& samplesPerChannel);
-    void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
+    void notifyAboutSilence(const samples_t samplesPerChannel);
 
     std::vector<float> m_writeCacheBuff;
 
@@ -82,6 +84,11 @@ private:
     std::set<IClockPtr> m_clocks;
     audioch_t m_audioChannelsCount = 0;
 
+    std::vector<gain_t> m_gains;
+    std::vector<gain_t> m_previousGains;
+    std::vector<dsp::SignalMeasure> m_measures;
+    dsp::AudioSignalMeter m_signalMeter;
+
     mutable AudioSignalsNotifier m_audioSignalNotifier;
 };
 
@@ -137,6 +137,8 @@ void MixerChannel::setSampleRate(unsigned int sampleRate)
         return;
     }
 
+    m_sampleRate = sampleRate;
+    m_signalMeter.setSampleRate(sampleRate);
     m_audioSource->setSampleRate(sampleRate);
 
     for (IFxProcessorPtr fx : m_fxProcessors) {
@@ -168,6 +170,8 @@ async::Channel<unsigned int> MixerChannel::audioChannelsCountChanged() const
 
 samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
 {
+    TRACEFUNC;
+
     ONLY_AUDIO_WORKER_THREAD;
 
     IF_ASSERT_FAILED(m_audioSource) {
@@ -178,10 +182,7 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
 
     if (processedSamplesCount == 0 || m_params.muted) {
         std::fill(buffer, buffer + samplesPerChannel * audioChannelsCount(), 0.f);
-
-        for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-            notifyAboutAudioSignalChanges(audioChNum, 0.f);
-        }
+        notifyAboutSilence(samplesPerChannel);
 
         return processedSamplesCount;
     }
@@ -198,40 +199,45 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
     return processedSamplesCount;
 }
 
-void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) const
+void MixerChannel::completeOutput(float* buffer, samples_t samplesPerChannel)
 {
-    float totalSquaredSum = 0.f;
-
-    for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
-        float singleChannelSquaredSum = 0.f;
-
-        gain_t totalGain = dsp::balanceGain(m_params.balance, audioChNum) * dsp::linearFromDecibels(m_params.volume);
-
-        for (unsigned int s = 0; s < samplesCount; ++s) {
-            int idx = s * audioChannelsCount() + audioChNum;
+    const audioch_t channelsCount = audioChannelsCount();
+    if (channelsCount == 0 || samplesPerChannel == 0) {
+        return;
+    }
 
-            float resultSample = buffer[idx] * totalGain;
-            buffer[idx] = resultSample;
+    //! NOTE The gain goes from the previous block's value to the current one over the block,
+    //! so volume and balance changes don't click
+    const gain_t volumeGain = dsp::linearFromDecibels(m_params.volume);
+    m_gains.resize(channelsCount);
+    for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
+        m_gains[audioChNum] = dsp::balanceGain(m_params.balance, audioChNum) * volumeGain;
+    }
 
-            float squaredSample = resultSample * resultSample;
-            singleChannelSquaredSum += squaredSample;
-            totalSquaredSum += squaredSample;
-        }
+    if (m_previousGains.size() != channelsCount) {
+        m_previousGains = m_gains;
+    }
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
+    m_measures.resize(channelsCount);
+    dsp::applyGain(buffer, channelsCount, samplesPerChannel, m_previousGains.data(), m_gains.data(), m_measures.data());
+    std::swap(m_previousGains, m_gains);
 
-        notifyAboutAudioSignalChanges(audioChNum, rms);
-    }
+    m_signalMeter.accumulate(m_measures.data(), channelsCount, samplesPerChannel, m_audioSignalNotifier);
 
     if (!m_compressor->isActive()) {
         return;
     }
 
-    float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesCount * audioChannelsCount());
-    m_compressor->process(totalRms, buffer, audioChannelsCount(), samplesCount);
+    float totalSquaredSum = 0.f;
+    for (const dsp::SignalMeasure& measure : m_measures) {
+        totalSquaredSum += measure.squaredSum;
+    }
+
+    float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesPerChannel * channelsCount);
+    m_compressor->process(totalRms, buffer, channelsCount, samplesPerChannel);
 }
 
-void MixerChannel::notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const
+void MixerChannel::notifyAboutSilence(samples_t samplesPerChannel)
 {
-    m_audioSignalNotifier.updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
+    m_signalMeter.accumulate(nullptr, audioChannelsCount(), samplesPerChannel, m_audioSignalNotifier);
 }
@@ -30,6 +30,8 @@
 #include "ifxprocessor.h"
 #include "track.h"
 #include "internal/dsp/compressor.h"
+#include "internal/dsp/audiokernels.h"
+#include "internal/dsp/audiosignalmeter.h"
 
 namespace mu::audio {
 class MixerChannel : public ITrackAudioOutput, public async::Asyncable
@@ -54,8 +56,8 @@ public:
     samples_t process(float* buffer, samples_t samplesPerChannel) override;
 
 private:
-    void completeOutput(float* buffer, unsigned int samplesCount) const;
-    void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
+    void completeOutput(float* buffer, samples_t samplesPerChannel);
+    void notifyAboutSilence(samples_t samplesPerChannel);
 
     TrackId m_trackId = -1;
 
@@ -67,6 +69,11 @@ private:
 
     dsp::CompressorPtr m_compressor = nullptr;
 
+    std::vector<gain_t> m_gains;
+    std::vector<gain_t> m_previousGains;
+    std::vector<dsp::SignalMeasure> m_measures;
+    dsp::AudioSignalMeter m_signalMeter;
+
     mutable async::Channel<AudioOutputParams> m_paramsChanges;
     mutable AudioSignalsNotifier m_audioSignalNotifier;
 };
@@ -20,74 +20,154 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "samplerateconvertor.h"
-#include "log.h"
+
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+
+#include "internal/dsp/audiomathutils.h"
+
+#include "log.h"
 
 using namespace mu::audio;
 
-SampleRateConvertor::SampleRateConvertor(const std::vector<float>& data,
-                                         unsigned int channelsCount,
-                                         unsigned int sampleRateIn,
-                                         unsigned int sampleRateOut)
-    : m_data(data), m_fir(), m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut)
+static constexpr double STOPBAND_ATTENUATION_DB = 96;
+static constexpr double PASSBAND = 0.9; //!< part of the target Nyquist frequency that is kept
+
+static double zeroBessel(double x)
 {
-    m_fir.resize(FIR_LENGTH, 0);
-    m_y.resize(FIR_LENGTH, 0);
-    initWindow();
+    //return std::cyl_bessel_i(0, x);
+
+    double sum = 1, term = 1;
+    double halfX = x / 2;
+
+    for (int k = 1; term > sum * std::numeric_limits<float>::epsilon(); ++k) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+    }
+
+    return sum;
 }
 
-std::vector<float> SampleRateConvertor::convert()
+SampleRateConvertor::SampleRateConvertor(unsigned int channelsCount, unsigned int sampleRateIn, unsigned int sampleRateOut)
+    : m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut)
 {
-    std::vector<float> out;
-    auto resultSamples = m_data.size() * m_sampleRateOut / (m_channelsCount * m_sampleRateIn);
+    initFilter();
+}
 
-    out.resize(resultSamples * m_channelsCount);
-    for (unsigned sample = 0; sample < resultSamples; ++sample) {
-        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
-            out[sample * m_channelsCount + channel] = y(sample, channel);
-        }
+std::vector<float> SampleRateConvertor::convert(const std::vector<float>& data)
+{
+    std::vector<float> out;
+    if (m_channelsCount == 0) {
+        return out;
     }
 
+    samples_t inputFrames = data.size() / m_channelsCount;
+    samples_t resultFrames = inputFrames * m_sampleRateOut / m_sampleRateIn;
+    out.resize(resultFrames * m_channelsCount);
+
+    reset();
+
+    samples_t used = 0;
+    samples_t generated = 0;
+    process(data.data(), inputFrames, used, out.data(), resultFrames, generated);
+
+    samples_t tailGenerated = 0;
+    flush(out.data() + generated * m_channelsCount, resultFrames - generated, tailGenerated);
+
     return out;
 }
 
-unsigned int SampleRateConvertor::convert(float* buffer, unsigned int from, unsigned int count)
+void SampleRateConvertor::process(const float* input, samples_t inputFrames, samples_t& inputFramesUsed,
+                                  float* output, samples_t outputFrames, samples_t& outputFramesGenerated)
 {
-    unsigned int sample = from;
-    unsigned int converted = 0;
+    inputFramesUsed = 0;
+    outputFramesGenerated = 0;
+
+    if (m_channelsCount == 0) {
+        return;
+    }
 
-    for (converted = 0; converted < count; ++converted, ++sample) {
-        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
-            if (!availableSamples(sample)) {
-                return converted;
+    // an output frame is ready when the history ends half of the window after its position
+    const samples_t lookahead = m_taps / 2 + 1;
+
+    while (true) {
+        while (m_inputFrame == m_outputPos + lookahead) {
+            if (outputFramesGenerated == outputFrames) {
+                return;
             }
-            buffer[converted * m_channelsCount + channel] = y(sample, channel);
+
+            generateFrame(output + outputFramesGenerated * m_channelsCount);
+            ++outputFramesGenerated;
+        }
+
+        if (outputFramesGenerated == outputFrames || inputFramesUsed == inputFrames) {
+            return;
         }
+
+        pushFrame(input + inputFramesUsed * m_channelsCount);
+        ++inputFramesUsed;
     }
-    return converted;
 }
 
-float SampleRateConvertor::y(unsigned int sample, unsigned int channel) const
+void SampleRateConvertor::flush(float* output, samples_t outputFrames, samples_t& outputFramesGenerated)
 {
-    switch (m_method) {
-    case SINC:
-        return ySinc(sample, channel);
-    case FIR:
-        return yFIR(sample, channel);
+    outputFramesGenerated = 0;
+
+    if (m_channelsCount == 0) {
+        return;
+    }
+
+    const samples_t lookahead = m_taps / 2 + 1;
+
+    while (outputFramesGenerated < outputFrames) {
+        if (m_inputFrame == m_outputPos + lookahead) {
+            generateFrame(output + outputFramesGenerated * m_channelsCount);
+            ++outputFramesGenerated;
+        } else {
+            pushSilentFrame();
+        }
     }
-    return 0.f;
+}
+
+samples_t SampleRateConvertor::seek(samples_t outputFrame)
+{
+    reset();
+
+    uint64_t position = outputFrame * m_M;
+    m_outputPos = position / m_L;
+    m_outputPhase = position % m_L;
+
+    // the window of the first frame starts half of its length before its position,
+    // everything before the start of the data is silence
+    samples_t firstInputFrame = m_outputPos + 1 > m_taps / 2 ? m_outputPos + 1 - m_taps / 2 : 0;
+    m_inputFrame = firstInputFrame;
+
+    return firstInputFrame;
+}
+
+void SampleRateConvertor::reset()
+{
+    m_history.assign(2 * m_taps * m_channelsCount, 0.f);
+    m_historyPos = 0;
+    m_inputFrame = 0;
+    m_outputPos = 0;
+    m_outputPhase = 0;
 }
 
 void SampleRateConvertor::setChannelCount(unsigned int count)
 {
-    m_channelsCount = count;
+    if (m_channelsCount != count) {
+        m_channelsCount = count;
+        reset();
+    }
 }
 
 void SampleRateConvertor::setSampleRateIn(unsigned int sampleRate)
 {
     if (m_sampleRateIn != sampleRate) {
         m_sampleRateIn = sampleRate;
-        initWindow();
+        initFilter();
     }
 }
 
@@ -95,116 +175,100 @@ void SampleRateConvertor::setSampleRateOut(unsigned int sampleRate)
 {
     if (m_sampleRateOut != sampleRate) {
         m_sampleRateOut = sampleRate;
-        initWindow();
+        initFilter();
     }
 }
 
-float SampleRateConvertor::ySinc(unsigned int sample, unsigned int channel) const
+void SampleRateConvertor::pushFrame(const float* frame)
 {
-    double currentOutputSampleTime = sample / static_cast<double>(m_sampleRateOut);
-    auto zeroInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn);
-
-    float out = 0.f;
-    for (unsigned int i = 0; i < USE_SAMPLES; ++i) {
-        int currentSample = zeroInputSample + i - USE_SAMPLES / 2;
-        double currentInputSampleTime = currentSample / static_cast<double>(m_sampleRateIn);
-
-        if (currentSample < 0 || currentSample * m_channelsCount + channel >= m_data.size()) {
-            continue;
-        }
-        out += m_data.at(currentSample * m_channelsCount + channel) * sinc(currentOutputSampleTime - currentInputSampleTime);
+    for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
+        float* history = m_history.data() + channel * 2 * m_taps;
+        history[m_historyPos] = frame[channel];
+        history[m_historyPos + m_taps] = frame[channel];
     }
-    return out;
+
+    m_historyPos = (m_historyPos + 1) % m_taps;
+    ++m_inputFrame;
 }
 
-float SampleRateConvertor::yFIR(unsigned int sample, unsigned int channel) const
+void SampleRateConvertor::pushSilentFrame()
 {
-    auto x = [this, &channel](int m) -> float {
-        int pos = m * m_M / m_L * m_channelsCount + channel;
-        if (pos >= 0 && pos < static_cast<int>(m_data.size())) {
-            return m_data.at(pos);
-        }
-        return 0.f;
-    };
-
-    float y = 0.f;
-    for (unsigned int i = 0; i < FIR_LENGTH; ++i) {
-        int t = sample - static_cast<int>(i);
-        y += x(t) * m_fir[i];
+    for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
+        float* history = m_history.data() + channel * 2 * m_taps;
+        history[m_historyPos] = 0.f;
+        history[m_historyPos + m_taps] = 0.f;
     }
-    return y;
+
+    m_historyPos = (m_historyPos + 1) % m_taps;
+    ++m_inputFrame;
 }
 
-bool SampleRateConvertor::availableSamples(unsigned int sample) const
+void SampleRateConvertor::generateFrame(float* frame)
 {
-    float currentOutputSampleTime = sample / static_cast<float>(m_sampleRateOut);
-    auto firstInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn) - USE_SAMPLES / 2;
+    const uint64_t row = m_phases == m_L ? m_outputPhase : m_outputPhase * m_phases / m_L;
+    const float* coefficients = m_fir.data() + row * m_taps;
 
-    // first sample for conversion points out of the input buffer
-    if (firstInputSample * m_channelsCount >= m_data.size()) {
-        return false;
+    for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
+        // the oldest frame of the window is the one written next
+        const float* window = m_history.data() + channel * 2 * m_taps + m_historyPos;
+        frame[channel] = dsp::dotProduct(window, coefficients, m_taps);
     }
-    return true;
+
+    m_outputPhase += m_M;
+    m_outputPos += m_outputPhase / m_L;
+    m_outputPhase %= m_L;
 }
 
-inline double zeroBessel(double x)
+void SampleRateConvertor::initFilter()
 {
-    //return std::cyl_bessel_i(0, x);
+    IF_ASSERT_FAILED(m_sampleRateIn > 0 && m_sampleRateOut > 0) {
+        m_sampleRateIn = m_sampleRateOut = 1;
+    }
 
-    double s = 1, y = 1;
-    int m = 1;
+    uint64_t divider = std::gcd(m_sampleRateIn, m_sampleRateOut);
+    m_M = m_sampleRateIn / divider;
+    m_L = m_sampleRateOut / divider;
+    m_phases = static_cast<unsigned int>(std::min<uint64_t>(m_L, MAX_PHASES));
 
-    while (y > std::numeric_limits<float>::min()) {
-        m += 2;
-        y *= x * x / (4 * m * m);
-        s += s * y;
-    }
+    // when decimating, the cutoff is lowered and the window is widened by the same ratio
+    double ratio = std::min(1.0, static_cast<double>(m_sampleRateOut) / m_sampleRateIn);
+    double cutoff = ratio * PASSBAND;
+    m_taps = static_cast<unsigned int>(std::ceil(TAPS / ratio / 4)) * 4;
 
-    return s;
-}
+    double halfWidth = m_taps / 2.0;
+    double beta = 0.1102 * (STOPBAND_ATTENUATION_DB - 8.7);
+    double windowNorm = zeroBessel(beta);
 
-void SampleRateConvertor::initWindow()
-{
-    int max = std::max(m_sampleRateIn, m_sampleRateOut), min = std::min(m_sampleRateIn, m_sampleRateOut);
-    int maxCommonDivider = 1;
-    while (max % min != 0) {
-        maxCommonDivider = max % min;
-        max = min;
-        min = maxCommonDivider;
-    }
-    m_M = m_sampleRateIn / maxCommonDivider;
-    m_L = m_sampleRateOut / maxCommonDivider;
-    double fStop = std::min(m_sampleRateIn, m_sampleRateOut) / 2,
-           fIntermediateSampleRate = m_sampleRateIn * m_M,
-           attenuation = 96 /*dB*/;
-    int M = FIR_LENGTH;
-    int Np = (M - 1) / 2;
-
-    double alpha = 0.1102 * (attenuation - 8.7);
-    double A[FIR_LENGTH];
-
-    A[0] = 2 * fStop / fIntermediateSampleRate;
-    for (int j = 1; j <= Np; j++) {
-        A[j]  = std::sin(2 * j * M_PI * fStop / fIntermediateSampleRate) / j * M_PI;
-    }
+    m_fir.resize(static_cast<size_t>(m_phases) * m_taps);
 
-    for (int j = 0; j <= Np; j++) {
-        m_fir[Np + j]  = A[j];
-        m_fir[Np + j] *= zeroBessel(alpha * std::sqrt(1 - (j * j / (Np * Np))));
-        m_fir[Np + j] /= zeroBessel(alpha);
-    }
+    for (unsigned int phase = 0; phase < m_phases; ++phase) {
+        double fraction = static_cast<double>(phase) / m_phases;
+        float* row = m_fir.data() + static_cast<size_t>(phase) * m_taps;
+        double sum = 0;
 
-    for (int j = 0; j < Np; j++) {
-        m_fir[j] = m_fir[M - 1 - j];
-    }
-}
+        for (unsigned int tap = 0; tap < m_taps; ++tap) {
+            // distance between the output position and the input frame of this tap
+            double distance = fraction + halfWidth - 1 - tap;
+            double r = distance / halfWidth;
+            if (std::abs(r) >= 1) {
+                row[tap] = 0.f;
+                continue;
+            }
 
-double SampleRateConvertor::sinc(double value) const
-{
-    if (value == 0) {
-        return 1.f;
+            double x = M_PI * cutoff * distance;
+            double sinc = x == 0 ? 1.0 : std::sin(x) / x;
+            double window = zeroBessel(beta * std::sqrt(1 - r * r)) / windowNorm;
+            double value = cutoff * sinc * window;
+
+            row[tap] = static_cast<float>(value);
+            sum += value;
+        }
+
+        // unity gain for DC in every phase
+        for (unsigned int tap = 0; tap < m_taps; ++tap) {
+            row[tap] = static_cast<float>(row[tap] / sum);
+        }
     }
-    double sincArg = M_PI * value * m_sampleRateIn;
-    double gain = std::min(1.0, m_sampleRateOut / static_cast<double>(m_sampleRateIn));
-    return gain * std::sin(sincArg) / sincArg;
+
+    reset();
 }
@@ -23,56 +23,66 @@
 #define MU_AUDIO_SAMPLERATECONVERTOR_H
 
 #include <vector>
-#include <deque>
+
+#include "audiotypes.h"
+
 namespace mu::audio {
+//! Polyphase resampler with precomputed windowed-sinc tables.
+//! Keeps the filter history between calls, so data can be fed block by block
 class SampleRateConvertor
 {
 public:
-    enum Method {
-        SINC, FIR
-    };
-    explicit SampleRateConvertor(const std::vector<float>& data, unsigned int channelsCount, unsigned int sampleRateIn,
-                                 unsigned int sampleRateOut);
+    explicit SampleRateConvertor(unsigned int channelsCount, unsigned int sampleRateIn, unsigned int sampleRateOut);
 
     //! offline convert full data set
-    std::vector<float> convert();
+    std::vector<float> convert(const std::vector<float>& data);
+
+    //! online convert: reads interleaved input frames and writes interleaved output frames
+    //! until either the input is used up or the output is full
+    void process(const float* input, samples_t inputFrames, samples_t& inputFramesUsed,
+                 float* output, samples_t outputFrames, samples_t& outputFramesGenerated);
 
-    //! online convert
-    unsigned int convert(float* buffer, unsigned int from, unsigned int count);
+    //! online convert after the end of the input: feeds silence to get the last frames,
+    //! which depend on the input past the end. The caller stops at the end of the output
+    void flush(float* output, samples_t outputFrames, samples_t& outputFramesGenerated);
+
+    //! restart conversion at the given output frame,
+    //! return the input frame the data has to be fed from
+    samples_t seek(samples_t outputFrame);
+    void reset();
 
     void setChannelCount(unsigned int count);
     void setSampleRateIn(unsigned int sampleRate);
     void setSampleRateOut(unsigned int sampleRate);
 
 private:
+    void initFilter();
+    void pushFrame(const float* frame);
+    void pushSilentFrame();
+    void generateFrame(float* frame);
 
-    //! return value of sinc function (LPF) with consideration of used sampleRates
-    double sinc(double value) const;
-
-    //! output sample value
-    float y(unsigned int sample, unsigned int channel) const;
-    float ySinc(unsigned int sample, unsigned int channel) const;
-    float yFIR(unsigned int sample, unsigned int channel) const;
-
-    //! return true if there are samples in input buffer for conversion
-    bool availableSamples(unsigned int sample) const;
+    static constexpr unsigned int TAPS = 64; //!< taps per phase without decimation, defines the quality and complexity of SRC
+    static constexpr unsigned int MAX_PHASES = 1024; //!< phase resolution for rates without a large common divider
 
-    //! calculate window function values
-    void initWindow();
+    unsigned int m_channelsCount = 0;
+    unsigned int m_sampleRateIn = 0;
+    unsigned int m_sampleRateOut = 0;
 
-    const static unsigned int USE_SAMPLES = 16; //!< this value defines the quality and complexity of SRC.
-    const std::vector<float>& m_data;
+    //! output frame n is at input position n * m_M / m_L
+    uint64_t m_L = 1;
+    uint64_t m_M = 1;
+    unsigned int m_taps = TAPS;
+    unsigned int m_phases = 1;
+    std::vector<float> m_fir; //!< m_phases rows of m_taps coefficients
 
-    //! values of window function for USE_SAMPLES
-    const static unsigned int FIR_LENGTH = 33;
-    unsigned int m_M = 1, m_L = 1;
-    std::vector<float> m_fir;
-    mutable std::deque<float> m_y;
+    //! per channel history of the last m_taps frames, every frame is written twice
+    //! so that the whole window is always contiguous in memory
+    std::vector<float> m_history;
+    unsigned int m_historyPos = 0;
 
-    unsigned int m_channelsCount;
-    unsigned int m_sampleRateIn;
-    unsigned int m_sampleRateOut;
-    Method m_method = FIR;
+    samples_t m_inputFrame = 0; //!< index of the next input frame
+    samples_t m_outputPos = 0; //!< integer part of the next output position
+    uint64_t m_outputPhase = 0; //!< fractional part of the next output position, in 1 / m_L
 };
 }
 
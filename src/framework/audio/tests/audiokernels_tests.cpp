@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "internal/dsp/audiokernels.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+class Audio_AudioKernelsTests : public ::testing::Test
+{
+public:
+    static std::vector<float> noise(samples_t count, unsigned int seed)
+    {
+        std::vector<float> data(count);
+        unsigned int state = seed;
+        for (float& sample : data) {
+            state = state * 1664525u + 1013904223u;
+            sample = static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 2.f - 1.f;
+        }
+        return data;
+    }
+
+    static void applyGainReference(std::vector<float>& buffer, audioch_t channels, samples_t frames,
+                                   const std::vector<gain_t>& from, const std::vector<gain_t>& to,
+                                   std::vector<SignalMeasure>& measures)
+    {
+        measures.assign(channels, SignalMeasure());
+        for (audioch_t ch = 0; ch < channels; ++ch) {
+            float step = (to[ch] - from[ch]) / frames;
+            for (samples_t f = 0; f < frames; ++f) {
+                float& sample = buffer[f * channels + ch];
+                sample *= from[ch] + step * (f + 1);
+                measures[ch].squaredSum += sample * sample;
+                measures[ch].peak = std::max(measures[ch].peak, std::abs(sample));
+            }
+        }
+    }
+};
+
+TEST_F(Audio_AudioKernelsTests, MixAdd)
+{
+    LOGI() << "kernels: " << kernelsInstructionSet();
+
+    for (samples_t count : { 1, 7, 8, 17, 1023 }) {
+        std::vector<float> out = noise(count, 1);
+        std::vector<float> in = noise(count, 2);
+        std::vector<float> expected = out;
+        for (samples_t i = 0; i < count; ++i) {
+            expected[i] += in[i];
+        }
+
+        mixAdd(out.data(), in.data(), count);
+
+        EXPECT_EQ(out, expected);
+    }
+}
+
+TEST_F(Audio_AudioKernelsTests, ApplyGainMatchesReference)
+{
+    for (audioch_t channels : { 1, 2, 3, 4, 6, 8, 16 }) {
+        for (samples_t frames : { 1, 3, 64, 511, 512 }) {
+            std::vector<gain_t> from(channels);
+            std::vector<gain_t> to(channels);
+            for (audioch_t ch = 0; ch < channels; ++ch) {
+                from[ch] = 0.25f + 0.1f * ch;
+                to[ch] = 1.f - 0.05f * ch;
+            }
+
+            std::vector<float> buffer = noise(channels * frames, channels + frames);
+            std::vector<float> expected = buffer;
+
+            std::vector<SignalMeasure> measures(channels);
+            std::vector<SignalMeasure> expectedMeasures;
+
+            applyGain(buffer.data(), channels, frames, from.data(), to.data(), measures.data());
+            applyGainReference(expected, channels, frames, from, to, expectedMeasures);
+
+            for (size_t i = 0; i < buffer.size(); ++i) {
+                ASSERT_NEAR(buffer[i], expected[i], 1e-5f) << "channels " << int(channels) << ", frames " << frames << ", sample " << i;
+            }
+
+            for (audioch_t ch = 0; ch < channels; ++ch) {
+                EXPECT_NEAR(measures[ch].squaredSum, expectedMeasures[ch].squaredSum, 1e-3f * (1.f + expectedMeasures[ch].squaredSum));
+                EXPECT_NEAR(measures[ch].peak, expectedMeasures[ch].peak, 1e-5f);
+            }
+        }
+    }
+}
+
+TEST_F(Audio_AudioKernelsTests, ApplyConstantGain)
+{
+    constexpr audioch_t channels = 2;
+    constexpr samples_t frames = 256;
+
+    std::vector<float> buffer(channels * frames, -0.5f);
+    std::vector<gain_t> gains = { 0.5f, 2.f };
+    std::vector<SignalMeasure> measures(channels);
+
+    applyGain(buffer.data(), channels, frames, gains.data(), gains.data(), measures.data());
+
+    for (samples_t f = 0; f < frames; ++f) {
+        EXPECT_FLOAT_EQ(buffer[f * channels], -0.25f);
+        EXPECT_FLOAT_EQ(buffer[f * channels + 1], -1.f);
+    }
+
+    EXPECT_FLOAT_EQ(measures[0].peak, 0.25f);
+    EXPECT_FLOAT_EQ(measures[1].peak, 1.f);
+    EXPECT_NEAR(measures[0].squaredSum, 0.0625f * frames, 1e-3f);
+    EXPECT_NEAR(measures[1].squaredSum, 1.f * frames, 1e-3f);
+}
+
+TEST_F(Audio_AudioKernelsTests, DISABLED_MixerThroughput)
+{
+    constexpr size_t tracks = 64;
+    constexpr audioch_t channels = 2;
+    constexpr samples_t frames = 512;
+    constexpr int blocks = 10000;
+
+    std::vector<std::vector<float> > trackBuffers;
+    for (size_t t = 0; t < tracks; ++t) {
+        trackBuffers.push_back(noise(channels * frames, t));
+    }
+
+    std::vector<float> master(channels * frames);
+    std::vector<gain_t> from = { 0.5f, 0.5f };
+    std::vector<gain_t> to = { 0.6f, 0.4f };
+    std::vector<SignalMeasure> measures(channels);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int block = 0; block < blocks; ++block) {
+        std::fill(master.begin(), master.end(), 0.f);
+        for (std::vector<float>& track : trackBuffers) {
+            applyGain(track.data(), channels, frames, from.data(), to.data(), measures.data());
+            mixAdd(master.data(), track.data(), master.size());
+            std::swap(from, to);
+        }
+    }
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    LOGI() << kernelsInstructionSet() << ": " << tracks << " tracks x " << frames << " frames, "
+           << secs * 1e6 / blocks << " us per block";
+}
@@ -0,0 +1,350 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "internal/dsp/compressor.h"
+#include "internal/dsp/limiter.h"
+#include "internal/dsp/biquad.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::dsp;
+
+static constexpr unsigned int SAMPLE_RATE = 48000;
+static constexpr samples_t BLOCK_SIZE = 512;
+
+//! The per channel implementations the dsp classes had before they were vectorized,
+//! the new ones must give the same output
+namespace reference {
+class Compressor
+{
+public:
+    void process(const float linearRms, float* buffer, const audioch_t channels, const samples_t samplesPerChannel)
+    {
+        float dbGain = dbFromSample(linearRms);
+        if (dbGain <= m_config.minimumOperableLevel()) {
+            return;
+        }
+
+        dbGain += m_feedbackGain;
+
+        float dbDiff = computeGain(dbGain) - dbGain;
+        m_feedbackGain = dbDiff;
+
+        float gain = std::min(linearFromDecibels(dbDiff * 2.f), m_previousGainReduction);
+        for (audioch_t ch = 0; ch < channels; ++ch) {
+            multiplySamples(buffer, channels, ch, samplesPerChannel, gain);
+        }
+
+        m_previousGainReduction = gain;
+    }
+
+private:
+    volume_db_t computeGain(const volume_db_t sample) const
+    {
+        // dsp::Compressor keeps its own soft thresholds, which stay at 0 dB
+        const volume_db_t lower = 0.f;
+        const volume_db_t upper = 0.f;
+
+        if (sample < lower) {
+            return sample;
+        }
+
+        if (sample <= upper) {
+            return sample + (((1 / m_config.ratio()) - 1) * std::pow(sample - upper, 2)) / (2 * m_config.kneeWidth());
+        }
+
+        return m_config.logarithmicThreshold() + (sample - m_config.logarithmicThreshold()) / m_config.ratio();
+    }
+
+    EnvelopeFilterConfig m_config = EnvelopeFilterConfig(SAMPLE_RATE, 4.f);
+    float m_previousGainReduction = 1.f;
+    float m_feedbackGain = 0.f;
+};
+
+class Limiter
+{
+public:
+    void process(const float linearRms, float* buffer, const audioch_t channels, const samples_t samplesPerChannel)
+    {
+        volume_db_t rmsDb = dbFromSample(linearRms);
+        if (rmsDb <= m_config.minimumOperableLevel()) {
+            return;
+        }
+
+        float computedGain = computeGain(rmsDb) - rmsDb;
+
+        float coefficient = computedGain <= m_previousGainReduction
+                            ? m_config.attackTimeCoefficient()
+                            : m_config.releaseTimeCoefficient();
+        float smoothedGain = (coefficient * m_previousGainReduction) + ((1 - coefficient) * computedGain);
+        m_previousGainReduction = smoothedGain;
+
+        float gain = linearFromDecibels(smoothedGain + m_config.makeUpGain());
+        for (audioch_t ch = 0; ch < channels; ++ch) {
+            multiplySamples(buffer, channels, ch, samplesPerChannel, gain);
+        }
+    }
+
+private:
+    volume_db_t computeGain(const volume_db_t sample) const
+    {
+        if (sample < m_config.softThresholdLower()) {
+            return sample;
+        }
+
+        if (sample <= m_config.softThresholdUpper()) {
+            return sample - (std::pow((sample - m_config.softThresholdUpper()), 2) / (2 * m_config.kneeWidth()));
+        }
+
+        return m_config.logarithmicThreshold();
+    }
+
+    EnvelopeFilterConfig m_config = EnvelopeFilterConfig(SAMPLE_RATE, 1.f, 0.f);
+    float m_previousGainReduction = 0.f;
+};
+
+//! direct form I, one channel
+class Biquad
+{
+public:
+    Biquad(float frequency, float gain, float q)
+    {
+        float a = std::pow(10.f, gain / 40.f);
+        float w0 = 2 * M_PI * frequency / SAMPLE_RATE;
+        float alpha = std::sin(w0) * a / (2 * q);
+
+        m_b[0] = 1 + alpha * a;
+        m_b[1] = -2 * std::cos(w0);
+        m_b[2] = 1 - alpha * a;
+
+        m_a[0] = 1 + alpha / a;
+        m_a[1] = -2 * std::cos(w0);
+        m_a[2] = 1 - alpha / a;
+    }
+
+    void process(float* buffer, const audioch_t channels, const audioch_t channel, const samples_t samplesPerChannel)
+    {
+        for (samples_t i = 0; i < samplesPerChannel; ++i) {
+            float& sample = buffer[i * channels + channel];
+
+            m_x[2] = m_x[1];
+            m_x[1] = m_x[0];
+            m_x[0] = sample;
+
+            m_y[2] = m_y[1];
+            m_y[1] = m_y[0];
+            m_y[0] = (m_b[2] * m_x[2] + m_b[1] * m_x[1] + m_b[0] * m_x[0] - m_a[1] * m_y[1] - m_a[2] * m_y[2]) / m_a[0];
+
+            sample = m_y[0];
+        }
+    }
+
+private:
+    float m_a[3] = { 0, 0, 0 };
+    float m_b[3] = { 0, 0, 0 };
+    float m_x[3] = { 0, 0, 0 };
+    float m_y[3] = { 0, 0, 0 };
+};
+}
+
+class Audio_DspTests : public ::testing::Test
+{
+public:
+    //! a few sines with a loudness going up and down from block to block
+    static std::vector<float> signal(const audioch_t channels, const size_t blocks)
+    {
+        std::vector<float> data(channels * BLOCK_SIZE * blocks);
+        for (samples_t frame = 0; frame < BLOCK_SIZE * blocks; ++frame) {
+            float level = 0.05f + 0.95f * std::abs(std::sin(frame / float(BLOCK_SIZE * 5)));
+            for (audioch_t ch = 0; ch < channels; ++ch) {
+                float phase = 2 * M_PI * frame / SAMPLE_RATE;
+                data[frame * channels + ch] = level * (0.6f * std::sin(phase * (220.f + 110.f * ch)) + 0.4f * std::sin(phase * 5000.f));
+            }
+        }
+        return data;
+    }
+
+    static float blockRms(const float* block, const size_t count)
+    {
+        float squaredSum = 0.f;
+        for (size_t i = 0; i < count; ++i) {
+            squaredSum += block[i] * block[i];
+        }
+        return samplesRootMeanSquare(squaredSum, count);
+    }
+};
+
+TEST_F(Audio_DspTests, CompressorMatchesReference)
+{
+    constexpr audioch_t channels = 2;
+    constexpr size_t blocks = 64;
+
+    std::vector<float> expected = signal(channels, blocks);
+    std::vector<float> actual = expected;
+
+    reference::Compressor referenceCompressor;
+    dsp::Compressor compressor(SAMPLE_RATE);
+
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t offset = block * BLOCK_SIZE * channels;
+        float rms = blockRms(expected.data() + offset, BLOCK_SIZE * channels);
+
+        referenceCompressor.process(rms, expected.data() + offset, channels, BLOCK_SIZE);
+        compressor.process(rms, actual.data() + offset, channels, BLOCK_SIZE);
+    }
+
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(Audio_DspTests, LimiterMatchesReference)
+{
+    constexpr audioch_t channels = 2;
+    constexpr size_t blocks = 64;
+
+    std::vector<float> expected = signal(channels, blocks);
+    for (float& sample : expected) {
+        sample *= 4.f;
+    }
+    std::vector<float> actual = expected;
+
+    reference::Limiter referenceLimiter;
+    dsp::Limiter limiter(SAMPLE_RATE);
+
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t offset = block * BLOCK_SIZE * channels;
+        float rms = blockRms(expected.data() + offset, BLOCK_SIZE * channels);
+
+        referenceLimiter.process(rms, expected.data() + offset, channels, BLOCK_SIZE);
+        limiter.process(rms, actual.data() + offset, channels, BLOCK_SIZE);
+    }
+
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(Audio_DspTests, BiquadMatchesReference)
+{
+    constexpr size_t blocks = 8;
+
+    for (audioch_t channels : { 1, 2, 3, 4, 6 }) {
+        std::vector<float> expected = signal(channels, blocks);
+        std::vector<float> actual = expected;
+
+        std::vector<reference::Biquad> referenceFilters(channels, reference::Biquad(1000.f, 6.f, 0.7f));
+
+        BiquadCascade filter;
+        filter.setAudioChannelsCount(channels);
+        filter.setSections({ BiquadCoefficients::peaking(SAMPLE_RATE, 1000.f, 6.f, 0.7f) });
+
+        for (size_t block = 0; block < blocks; ++block) {
+            const size_t offset = block * BLOCK_SIZE * channels;
+
+            for (audioch_t ch = 0; ch < channels; ++ch) {
+                referenceFilters[ch].process(expected.data() + offset, channels, ch, BLOCK_SIZE);
+            }
+            filter.process(actual.data() + offset, BLOCK_SIZE);
+        }
+
+        for (size_t i = 0; i < actual.size(); ++i) {
+            ASSERT_NEAR(actual[i], expected[i], 1e-4f) << "channels " << int(channels) << ", sample " << i;
+        }
+    }
+}
+
+TEST_F(Audio_DspTests, BiquadCascadeMatchesSingleSections)
+{
+    constexpr audioch_t channels = 2;
+
+    const std::vector<BiquadCoefficients> sections = {
+        BiquadCoefficients::peaking(SAMPLE_RATE, 100.f, 4.f, 0.7f),
+        BiquadCoefficients::peaking(SAMPLE_RATE, 1000.f, -6.f, 1.f),
+        BiquadCoefficients::peaking(SAMPLE_RATE, 8000.f, 3.f, 2.f)
+    };
+
+    std::vector<float> expected = signal(channels, 4);
+    std::vector<float> actual = expected;
+
+    for (const BiquadCoefficients& section : sections) {
+        BiquadCascade filter;
+        filter.setAudioChannelsCount(channels);
+        filter.setSections({ section });
+        filter.process(expected.data(), expected.size() / channels);
+    }
+
+    BiquadCascade cascade;
+    cascade.setAudioChannelsCount(channels);
+    cascade.setSections(sections);
+    cascade.process(actual.data(), actual.size() / channels);
+
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(Audio_DspTests, DISABLED_CpuPerChannel)
+{
+    constexpr audioch_t channels = 2;
+    constexpr size_t blocks = 20000;
+
+    const std::vector<float> source = signal(channels, 1);
+    std::vector<float> buffer = source;
+    const float rms = blockRms(source.data(), source.size());
+
+    auto measure = [&](const char* name, auto&& processBlock) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t block = 0; block < blocks; ++block) {
+            std::copy(source.begin(), source.end(), buffer.begin());
+            processBlock();
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        LOGI() << name << ": " << secs * 1e9 / (blocks * BLOCK_SIZE * channels) << " ns per channel sample";
+    };
+
+    dsp::Compressor compressor(SAMPLE_RATE);
+    measure("compressor", [&]() { compressor.process(rms, buffer.data(), channels, BLOCK_SIZE); });
+
+    dsp::Limiter limiter(SAMPLE_RATE);
+    measure("limiter", [&]() { limiter.process(rms, buffer.data(), channels, BLOCK_SIZE); });
+
+    std::vector<reference::Biquad> referenceBands;
+    for (float frequency : { 100.f, 500.f, 2000.f, 8000.f }) {
+        referenceBands.emplace_back(frequency, 3.f, 1.f);
+    }
+    measure("4 band eq, direct form", [&]() {
+        for (reference::Biquad& band : referenceBands) {
+            band.process(buffer.data(), 1, 0, BLOCK_SIZE * channels);
+        }
+    });
+
+    BiquadCascade cascade;
+    cascade.setAudioChannelsCount(channels);
+    cascade.setSections({ BiquadCoefficients::peaking(SAMPLE_RATE, 100.f, 3.f, 1.f),
+                          BiquadCoefficients::peaking(SAMPLE_RATE, 500.f, 3.f, 1.f),
+                          BiquadCoefficients::peaking(SAMPLE_RATE, 2000.f, 3.f, 1.f),
+                          BiquadCoefficients::peaking(SAMPLE_RATE, 8000.f, 3.f, 1.f) });
+    measure("4 band eq, cascade", [&]() { cascade.process(buffer.data(), BLOCK_SIZE); });
+}
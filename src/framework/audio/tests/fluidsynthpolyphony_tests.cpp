@@ -0,0 +1,327 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fluidsynth.h>
+
+#include "internal/synthesizers/voicebudget.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+
+static constexpr int SAMPLE_RATE = 44100;
+static constexpr int BLOCK_SIZE = 512;
+static constexpr int MAX_POLYPHONY = 64;
+
+//! NOTE A SoundFont with one preset, which plays a looped sine wave as long as the key is held
+class TestSoundFont
+{
+public:
+    TestSoundFont()
+    {
+        static constexpr int SAMPLES = 1000;
+        static constexpr int PERIOD = 100;
+
+        std::string smpl;
+        for (int i = 0; i < SAMPLES + 46; ++i) {
+            int16_t value = i < SAMPLES ? static_cast<int16_t>(16000 * std::sin(2 * M_PI * i / PERIOD)) : 0;
+            smpl += word(static_cast<uint16_t>(value));
+        }
+
+        std::string info = chunk("ifil", word(2) + word(1)) + chunk("isng", padded("EMU8000", 8)) + chunk("INAM", padded("Test", 6));
+
+        std::string phdr = padded("Sine", 20) + word(0) + word(0) + word(0) + dword(0) + dword(0) + dword(0)
+                           + padded("EOP", 20) + word(0) + word(0) + word(1) + dword(0) + dword(0) + dword(0);
+        std::string pbag = word(0) + word(0) + word(1) + word(0);
+        std::string pgen = word(41) + word(0) + word(0) + word(0); // instrument 0
+        std::string inst = padded("Sine", 20) + word(0) + padded("EOI", 20) + word(1);
+        std::string ibag = word(0) + word(0) + word(2) + word(0);
+        std::string igen = word(54) + word(1) + word(53) + word(0) + word(0) + word(0); // looped sample 0
+        std::string shdr = padded("Sine", 20) + dword(0) + dword(SAMPLES) + dword(PERIOD) + dword(SAMPLES - PERIOD)
+                           + dword(SAMPLE_RATE) + byte(69) + byte(0) + word(0) + word(1)
+                           + padded("EOS", 20) + dword(0) + dword(0) + dword(0) + dword(0) + dword(0) + byte(0) + byte(0) + word(0) + word(0);
+
+        std::string pdta = chunk("phdr", phdr) + chunk("pbag", pbag) + chunk("pmod", std::string(10, '\0'))
+                           + chunk("pgen", pgen) + chunk("inst", inst) + chunk("ibag", ibag)
+                           + chunk("imod", std::string(10, '\0')) + chunk("igen", igen) + chunk("shdr", shdr);
+
+        m_data = chunk("RIFF", "sfbk" + list("INFO", info) + list("sdta", chunk("smpl", smpl)) + list("pdta", pdta));
+    }
+
+    //! loads the SoundFont from memory into the synth
+    int load(fluid_settings_t* settings, fluid_synth_t* synth) const
+    {
+        fluid_sfloader_t* loader = new_fluid_defsfloader(settings);
+        fluid_sfloader_set_callbacks(loader, &open, &read, &seek, &tell, &close);
+        fluid_synth_add_sfloader(synth, loader);
+
+        std::string address = std::to_string(reinterpret_cast<uintptr_t>(this));
+        return fluid_synth_sfload(synth, address.c_str(), 1);
+    }
+
+private:
+    struct File {
+        const std::string* data = nullptr;
+        long pos = 0;
+    };
+
+    static std::string byte(uint8_t v) { return std::string(1, static_cast<char>(v)); }
+    static std::string word(uint16_t v) { return byte(v & 0xff) + byte(v >> 8); }
+    static std::string dword(uint32_t v) { return word(v & 0xffff) + word(v >> 16); }
+    static std::string padded(const char* s, size_t size)
+    {
+        std::string result(s);
+        result.resize(size, '\0');
+        return result;
+    }
+
+    static std::string chunk(const char* id, const std::string& data) { return std::string(id, 4) + dword(data.size()) + data; }
+    static std::string list(const char* id, const std::string& data) { return chunk("LIST", std::string(id, 4) + data); }
+
+    static void* open(const char* filename)
+    {
+        auto font = reinterpret_cast<const TestSoundFont*>(std::stoull(filename));
+        return new File { &font->m_data, 0 };
+    }
+
+    static int read(void* buf, int count, void* handle)
+    {
+        File* file = static_cast<File*>(handle);
+        if (file->pos + count > static_cast<long>(file->data->size())) {
+            return FLUID_FAILED;
+        }
+        std::memcpy(buf, file->data->data() + file->pos, count);
+        file->pos += count;
+        return FLUID_OK;
+    }
+
+    static int seek(void* handle, long offset, int origin)
+    {
+        File* file = static_cast<File*>(handle);
+        long base = origin == SEEK_SET ? 0 : origin == SEEK_CUR ? file->pos : static_cast<long>(file->data->size());
+        file->pos = base + offset;
+        return FLUID_OK;
+    }
+
+    static long tell(void* handle)
+    {
+        return static_cast<File*>(handle)->pos;
+    }
+
+    static int close(void* handle)
+    {
+        delete static_cast<File*>(handle);
+        return FLUID_OK;
+    }
+
+    std::string m_data;
+};
+
+class Audio_FluidSynthPolyphonyTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_settings = new_fluid_settings();
+        fluid_settings_setint(m_settings, "synth.polyphony", MAX_POLYPHONY);
+        fluid_settings_setnum(m_settings, "synth.sample-rate", SAMPLE_RATE);
+        fluid_settings_setint(m_settings, "synth.reverb.active", 0);
+        fluid_settings_setint(m_settings, "synth.chorus.active", 0);
+
+        m_synth = new_fluid_synth(m_settings);
+        ASSERT_NE(m_font.load(m_settings, m_synth), FLUID_FAILED);
+    }
+
+    void TearDown() override
+    {
+        delete_fluid_synth(m_synth);
+        delete_fluid_settings(m_settings);
+    }
+
+    //! renders one block and returns its peak level
+    float render()
+    {
+        std::vector<float> buffer(BLOCK_SIZE * 2);
+        fluid_synth_write_float(m_synth, BLOCK_SIZE, buffer.data(), 0, 2, buffer.data(), 1, 2);
+
+        float peak = 0.f;
+        for (float sample : buffer) {
+            peak = std::max(peak, std::abs(sample));
+        }
+        return peak;
+    }
+
+    TestSoundFont m_font;
+    fluid_settings_t* m_settings = nullptr;
+    fluid_synth_t* m_synth = nullptr;
+};
+
+TEST_F(Audio_FluidSynthPolyphonyTests, HeldNotesSoundWhileBudgetShrinks)
+{
+    //! [GIVEN] The synth holds 8 notes
+    VoiceBudget budget;
+    budget.setMaxVoices(MAX_POLYPHONY);
+    VoiceBudget::EntryPtr synth = budget.registerSynth();
+    VoiceBudget::EntryPtr other = budget.registerSynth();
+
+    for (int key = 60; key < 68; ++key) {
+        fluid_synth_noteon(m_synth, 0, key, 100);
+    }
+    EXPECT_GT(render(), 0.f);
+    ASSERT_EQ(fluid_synth_get_active_voice_count(m_synth), 8);
+
+    //! DO Another synth takes the budget, this one may only use its even share of the voices
+    budget.allowedVoices(other, MAX_POLYPHONY);
+    budget.setMaxVoices(4);
+    int allowed = budget.allowedVoices(synth, 8);
+    ASSERT_EQ(allowed, 2);
+
+    int polyphony = fluid_synth_limit_polyphony(m_synth, allowed);
+
+    //! CHECK The polyphony stays above the playing voices and all the held notes still sound
+    EXPECT_GE(polyphony, 8);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_GT(render(), 0.f);
+    }
+    EXPECT_EQ(fluid_synth_get_active_voice_count(m_synth), 8);
+
+    //! DO Release the notes and apply the budget again once they have died away
+    for (int key = 60; key < 68; ++key) {
+        fluid_synth_noteoff(m_synth, 0, key);
+    }
+    for (int i = 0; i < 100 && fluid_synth_get_active_voice_count(m_synth) > 0; ++i) {
+        render();
+    }
+    ASSERT_EQ(fluid_synth_get_active_voice_count(m_synth), 0);
+
+    polyphony = fluid_synth_limit_polyphony(m_synth, allowed);
+
+    //! CHECK The polyphony follows the budget now, new notes get only the allowed voices
+    EXPECT_EQ(polyphony, 2);
+    EXPECT_EQ(fluid_synth_get_polyphony(m_synth), 2);
+
+    for (int key = 60; key < 64; ++key) {
+        fluid_synth_noteon(m_synth, 0, key, 100);
+    }
+    EXPECT_GT(render(), 0.f);
+    EXPECT_EQ(fluid_synth_get_active_voice_count(m_synth), 2);
+}
+
+TEST_F(Audio_FluidSynthPolyphonyTests, PolyphonyIsNotRaisedAboveCreatedVoices)
+{
+    //! [GIVEN] The synth was created with MAX_POLYPHONY voices and is limited to a few of them
+    EXPECT_EQ(fluid_synth_limit_polyphony(m_synth, 4), 4);
+
+    //! DO Raise the limit above the voices the synth has
+    int polyphony = fluid_synth_limit_polyphony(m_synth, MAX_POLYPHONY * 2);
+
+    //! CHECK No voices are added, the limit is all the created voices
+    EXPECT_EQ(polyphony, MAX_POLYPHONY);
+    EXPECT_EQ(fluid_synth_get_polyphony(m_synth), MAX_POLYPHONY);
+}
+
+TEST_F(Audio_FluidSynthPolyphonyTests, BudgetIsSplitBetweenPartitions)
+{
+    //! [GIVEN] The track is rendered by 3 voice partitions, each of them holds 2 notes
+    VoiceBudget budget;
+    budget.setMaxVoices(16);
+    budget.setRenderThreadsPerSynth(3);
+    VoiceBudget::EntryPtr track = budget.registerSynth();
+
+    struct Partition {
+        fluid_settings_t* settings = nullptr;
+        fluid_synth_t* synth = nullptr;
+    };
+
+    std::vector<Partition> partitions;
+    for (int i = 0; i < budget.renderThreadsPerSynth(); ++i) {
+        Partition partition;
+        partition.settings = new_fluid_settings();
+        fluid_settings_setint(partition.settings, "synth.polyphony", MAX_POLYPHONY);
+        fluid_settings_setnum(partition.settings, "synth.sample-rate", SAMPLE_RATE);
+        partition.synth = new_fluid_synth(partition.settings);
+        ASSERT_NE(m_font.load(partition.settings, partition.synth), FLUID_FAILED);
+        partitions.push_back(partition);
+    }
+
+    auto renderAll = [&partitions]() {
+        std::vector<float> buffer(BLOCK_SIZE * 2);
+        int activeVoices = 0;
+        for (const Partition& partition : partitions) {
+            fluid_synth_write_float(partition.synth, BLOCK_SIZE, buffer.data(), 0, 2, buffer.data(), 1, 2);
+            activeVoices += fluid_synth_get_active_voice_count(partition.synth);
+        }
+        return activeVoices;
+    };
+
+    for (const Partition& partition : partitions) {
+        fluid_synth_noteon(partition.synth, 0, 60, 100);
+        fluid_synth_noteon(partition.synth, 0, 61, 100);
+    }
+    int activeVoices = renderAll();
+    ASSERT_EQ(activeVoices, 6);
+
+    //! DO Limit the partitions like FluidSynth::updatePolyphony() does
+    int allowed = budget.allowedVoices(track, activeVoices);
+    ASSERT_EQ(allowed, 16);
+
+    int freeVoices = allowed - activeVoices;
+    int partitionsCount = static_cast<int>(partitions.size());
+    for (int i = 0; i < partitionsCount; ++i) {
+        int active = fluid_synth_get_active_voice_count(partitions[i].synth);
+        fluid_synth_limit_polyphony(partitions[i].synth, active + VoiceBudget::splitVoices(freeVoices, i, partitionsCount));
+    }
+
+    //! DO Every partition gets many new notes in one block
+    for (const Partition& partition : partitions) {
+        for (int key = 62; key < 72; ++key) {
+            fluid_synth_noteon(partition.synth, 0, key, 100);
+        }
+    }
+
+    //! CHECK The track as a whole doesn't exceed its allowance
+    EXPECT_EQ(renderAll(), allowed);
+
+    //! DO Release all the notes
+    for (const Partition& partition : partitions) {
+        for (int key = 60; key < 72; ++key) {
+            fluid_synth_noteoff(partition.synth, 0, key);
+        }
+    }
+    for (int i = 0; i < 100 && activeVoices > 0; ++i) {
+        activeVoices = renderAll();
+    }
+
+    //! CHECK The voices stolen for the new notes don't stay in the active voices
+    EXPECT_EQ(activeVoices, 0);
+
+    for (const Partition& partition : partitions) {
+        delete_fluid_synth(partition.synth);
+        delete_fluid_settings(partition.settings);
+    }
+}
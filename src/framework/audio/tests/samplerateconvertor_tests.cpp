@@ -0,0 +1,209 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "internal/worker/samplerateconvertor.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio;
+
+static const std::vector<std::pair<unsigned int, unsigned int> > COMMON_RATES = {
+    { 44100, 48000 }, { 48000, 44100 }, { 48000, 96000 }, { 96000, 48000 }, { 44100, 96000 }, { 96000, 44100 }
+};
+
+class Audio_SampleRateConvertorTests : public ::testing::Test
+{
+public:
+    static std::vector<float> sine(unsigned int sampleRate, samples_t frames, unsigned int channels, double frequency)
+    {
+        std::vector<float> data(frames * channels);
+        for (samples_t frame = 0; frame < frames; ++frame) {
+            for (unsigned int channel = 0; channel < channels; ++channel) {
+                double phase = 2 * M_PI * frequency * frame / sampleRate + channel;
+                data[frame * channels + channel] = static_cast<float>(0.5 * std::sin(phase));
+            }
+        }
+        return data;
+    }
+};
+
+TEST_F(Audio_SampleRateConvertorTests, ConvertKeepsSine)
+{
+    constexpr unsigned int channels = 2;
+    constexpr double frequency = 1000;
+
+    for (const auto& rates : COMMON_RATES) {
+        std::vector<float> input = sine(rates.first, rates.first / 2, channels, frequency);
+
+        SampleRateConvertor src(channels, rates.first, rates.second);
+        std::vector<float> output = src.convert(input);
+
+        samples_t outputFrames = output.size() / channels;
+        EXPECT_EQ(outputFrames, rates.second / 2);
+
+        std::vector<float> expected = sine(rates.second, outputFrames, channels, frequency);
+
+        // the edges are smoothed by the silence around the data
+        for (samples_t frame = 200; frame < outputFrames - 200; ++frame) {
+            for (unsigned int channel = 0; channel < channels; ++channel) {
+                size_t idx = frame * channels + channel;
+                ASSERT_NEAR(output[idx], expected[idx], 1e-3) << rates.first << " -> " << rates.second << " frame " << frame;
+            }
+        }
+    }
+}
+
+TEST_F(Audio_SampleRateConvertorTests, StreamingMatchesOffline)
+{
+    constexpr unsigned int channels = 2;
+
+    for (const auto& rates : COMMON_RATES) {
+        std::vector<float> input = sine(rates.first, 10000, channels, 440);
+
+        SampleRateConvertor offline(channels, rates.first, rates.second);
+        std::vector<float> expected = offline.convert(input);
+
+        // odd block sizes on both sides
+        SampleRateConvertor src(channels, rates.first, rates.second);
+        std::vector<float> output(expected.size());
+        samples_t inputFrame = 0;
+        samples_t outputFrame = 0;
+        samples_t totalInputFrames = input.size() / channels;
+        samples_t totalOutputFrames = output.size() / channels;
+
+        while (inputFrame < totalInputFrames && outputFrame < totalOutputFrames) {
+            samples_t used = 0;
+            samples_t generated = 0;
+            src.process(input.data() + inputFrame * channels, std::min<samples_t>(37, totalInputFrames - inputFrame), used,
+                        output.data() + outputFrame * channels, std::min<samples_t>(53, totalOutputFrames - outputFrame), generated);
+            inputFrame += used;
+            outputFrame += generated;
+        }
+
+        ASSERT_GT(outputFrame, 0u);
+        for (size_t i = 0; i < outputFrame * channels; ++i) {
+            ASSERT_FLOAT_EQ(output[i], expected[i]) << rates.first << " -> " << rates.second << " sample " << i;
+        }
+    }
+}
+
+TEST_F(Audio_SampleRateConvertorTests, FlushGivesLastFrames)
+{
+    constexpr unsigned int channels = 2;
+
+    for (const auto& rates : COMMON_RATES) {
+        std::vector<float> input = sine(rates.first, 10000, channels, 440);
+
+        SampleRateConvertor offline(channels, rates.first, rates.second);
+        std::vector<float> expected = offline.convert(input);
+
+        // the whole input is fed, then the rest is flushed in small blocks
+        SampleRateConvertor src(channels, rates.first, rates.second);
+        std::vector<float> output(expected.size());
+        samples_t totalOutputFrames = output.size() / channels;
+
+        samples_t used = 0;
+        samples_t outputFrame = 0;
+        src.process(input.data(), input.size() / channels, used, output.data(), totalOutputFrames, outputFrame);
+        ASSERT_EQ(used, input.size() / channels);
+        ASSERT_LT(outputFrame, totalOutputFrames);
+
+        while (outputFrame < totalOutputFrames) {
+            samples_t flushed = 0;
+            src.flush(output.data() + outputFrame * channels, std::min<samples_t>(7, totalOutputFrames - outputFrame), flushed);
+            outputFrame += flushed;
+        }
+
+        for (size_t i = 0; i < output.size(); ++i) {
+            ASSERT_FLOAT_EQ(output[i], expected[i]) << rates.first << " -> " << rates.second << " sample " << i;
+        }
+
+        // the last frames carry the end of the input, not silence
+        float tailPeak = 0.f;
+        for (size_t i = output.size() - 8 * channels; i < output.size(); ++i) {
+            tailPeak = std::max(tailPeak, std::abs(output[i]));
+        }
+        EXPECT_GT(tailPeak, 0.05f) << rates.first << " -> " << rates.second;
+    }
+}
+
+TEST_F(Audio_SampleRateConvertorTests, SeekMatchesOffline)
+{
+    constexpr unsigned int channels = 1;
+    constexpr samples_t seekFrame = 3001;
+
+    for (const auto& rates : COMMON_RATES) {
+        std::vector<float> input = sine(rates.first, 10000, channels, 440);
+
+        SampleRateConvertor offline(channels, rates.first, rates.second);
+        std::vector<float> expected = offline.convert(input);
+
+        SampleRateConvertor src(channels, rates.first, rates.second);
+        samples_t inputFrame = src.seek(seekFrame);
+
+        std::vector<float> output(1000);
+        samples_t used = 0;
+        samples_t generated = 0;
+        src.process(input.data() + inputFrame, input.size() - inputFrame, used, output.data(), output.size(), generated);
+
+        ASSERT_EQ(generated, output.size());
+        for (size_t i = 0; i < output.size(); ++i) {
+            ASSERT_FLOAT_EQ(output[i], expected[seekFrame + i]) << rates.first << " -> " << rates.second << " frame " << i;
+        }
+    }
+}
+
+TEST_F(Audio_SampleRateConvertorTests, DISABLED_Throughput)
+{
+    constexpr unsigned int channels = 2;
+    constexpr samples_t blockFrames = 512;
+    constexpr unsigned int seconds = 60;
+
+    for (const auto& rates : COMMON_RATES) {
+        std::vector<float> input = sine(rates.first, blockFrames, channels, 440);
+        std::vector<float> output(blockFrames * 4 * channels);
+
+        SampleRateConvertor src(channels, rates.first, rates.second);
+
+        samples_t totalFrames = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (samples_t frame = 0; frame < samples_t(rates.first) * seconds; frame += blockFrames) {
+            samples_t used = 0;
+            samples_t generated = 0;
+            src.process(input.data(), blockFrames, used, output.data(), output.size() / channels, generated);
+            totalFrames += generated;
+        }
+
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        LOGI() << rates.first << " -> " << rates.second << ": " << totalFrames << " frames in " << secs * 1000 << " ms, "
+               << seconds / secs << "x realtime";
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "internal/synthesizers/voicebudget.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+
+class Audio_VoiceBudgetTests : public ::testing::Test
+{
+};
+
+TEST_F(Audio_VoiceBudgetTests, UnlimitedByDefault)
+{
+    VoiceBudget budget;
+    VoiceBudget::EntryPtr synth = budget.registerSynth();
+
+    EXPECT_EQ(budget.allowedVoices(synth, 1000), VoiceBudget::UNLIMITED);
+}
+
+TEST_F(Audio_VoiceBudgetTests, SynthGetsWhatOthersLeave)
+{
+    VoiceBudget budget;
+    budget.setMaxVoices(100);
+
+    VoiceBudget::EntryPtr busy = budget.registerSynth();
+    VoiceBudget::EntryPtr quiet = budget.registerSynth();
+
+    EXPECT_EQ(budget.allowedVoices(quiet, 10), 100);
+    EXPECT_EQ(budget.allowedVoices(busy, 60), 90);
+    EXPECT_EQ(budget.allowedVoices(quiet, 10), 50);
+}
+
+TEST_F(Audio_VoiceBudgetTests, EvenShareIsGuaranteed)
+{
+    VoiceBudget budget;
+    budget.setMaxVoices(100);
+
+    VoiceBudget::EntryPtr first = budget.registerSynth();
+    VoiceBudget::EntryPtr second = budget.registerSynth();
+    VoiceBudget::EntryPtr third = budget.registerSynth();
+
+    budget.allowedVoices(first, 95);
+
+    //! the others can still start notes, the first one has to give its voices up
+    EXPECT_EQ(budget.allowedVoices(second, 0), 33);
+    EXPECT_EQ(budget.allowedVoices(third, 0), 33);
+}
+
+TEST_F(Audio_VoiceBudgetTests, RemovedSynthFreesItsVoices)
+{
+    VoiceBudget budget;
+    budget.setMaxVoices(100);
+
+    VoiceBudget::EntryPtr remaining = budget.registerSynth();
+    VoiceBudget::EntryPtr removed = budget.registerSynth();
+
+    budget.allowedVoices(removed, 80);
+    EXPECT_EQ(budget.allowedVoices(remaining, 0), 50);
+
+    removed.reset();
+    EXPECT_EQ(budget.allowedVoices(remaining, 0), 100);
+}
+
+TEST_F(Audio_VoiceBudgetTests, RenderThreads)
+{
+    VoiceBudget budget;
+    EXPECT_EQ(budget.renderThreadsPerSynth(), 1);
+
+    budget.setRenderThreadsPerSynth(4);
+    EXPECT_EQ(budget.renderThreadsPerSynth(), 4);
+
+    budget.setRenderThreadsPerSynth(0);
+    EXPECT_EQ(budget.renderThreadsPerSynth(), 1);
+}
+
+TEST_F(Audio_VoiceBudgetTests, VoicesAreSplitBetweenPartitions)
+{
+    EXPECT_EQ(VoiceBudget::splitVoices(10, 0, 1), 10);
+
+    EXPECT_EQ(VoiceBudget::splitVoices(10, 0, 3), 4);
+    EXPECT_EQ(VoiceBudget::splitVoices(10, 1, 3), 3);
+    EXPECT_EQ(VoiceBudget::splitVoices(10, 2, 3), 3);
+
+    EXPECT_EQ(VoiceBudget::splitVoices(1, 0, 2), 1);
+    EXPECT_EQ(VoiceBudget::splitVoices(1, 1, 2), 0);
+}
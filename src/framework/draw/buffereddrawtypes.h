@@ -105,6 +105,16 @@ struct DrawData
         bool operator!=(const State& o) const { return !this->operator==(o); }
     };
 
+    //! NOTE The kinds of primitives, in the order they were drawn (see Data::order)
+    enum class Primitive : char {
+        Path,
+        Polygon,
+        Text,
+        RectText,
+        Pixmap,
+        TiledPixmap
+    };
+
     struct Data {
         State state;
 
@@ -115,6 +125,10 @@ struct DrawData
         std::vector<DrawPixmap> pixmaps;
         std::vector<DrawTiledPixmap> tiledPixmap;
 
+        //! NOTE Each kind of primitives is kept in its own list,
+        //! this keeps the order in which they were drawn, as overlapping primitives depend on it
+        std::vector<Primitive> order;
+
         bool empty() const
         {
             return paths.empty()
@@ -206,7 +206,9 @@ void BufferedPaintProvider::drawPath(const PainterPath& path)
     } else if (st.brush.style() == BrushStyle::NoBrush) {
         mode = DrawMode::Stroke;
     }
-    editableData().paths.push_back({ path, st.pen, st.brush, mode });
+    DrawData::Data& data = editableData();
+    data.paths.push_back({ path, st.pen, st.brush, mode });
+    data.order.push_back(DrawData::Primitive::Path);
 }
 
 void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount, PolygonMode mode)
@@ -215,17 +217,23 @@ void BufferedPaintProvider::drawPolygon(const PointF* points, size_t pointCount,
     for (size_t i = 0; i < pointCount; ++i) {
         pol[i] = PointF(points[i].x(), points[i].y());
     }
-    editableData().polygons.push_back(DrawPolygon { pol, mode });
+    DrawData::Data& data = editableData();
+    data.polygons.push_back(DrawPolygon { pol, mode });
+    data.order.push_back(DrawData::Primitive::Polygon);
 }
 
 void BufferedPaintProvider::drawText(const PointF& point, const String& text)
 {
-    editableData().texts.push_back(DrawText { point, text });
+    DrawData::Data& data = editableData();
+    data.texts.push_back(DrawText { point, text });
+    data.order.push_back(DrawData::Primitive::Text);
 }
 
 void BufferedPaintProvider::drawText(const RectF& rect, int flags, const String& text)
 {
-    editableData().rectTexts.push_back(DrawRectText { rect, flags, text });
+    DrawData::Data& data = editableData();
+    data.rectTexts.push_back(DrawRectText { rect, flags, text });
+    data.order.push_back(DrawData::Primitive::RectText);
 }
 
 void BufferedPaintProvider::drawTextWorkaround(const Font& f, const PointF& pos, const String& text)
@@ -241,23 +249,31 @@ void BufferedPaintProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
 
 void BufferedPaintProvider::drawPixmap(const PointF& p, const Pixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { p, pm });
+    DrawData::Data& data = editableData();
+    data.pixmaps.push_back(DrawPixmap { p, pm });
+    data.order.push_back(DrawData::Primitive::Pixmap);
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset)
 {
-    editableData().tiledPixmap.push_back(DrawTiledPixmap { rect, pm, offset });
+    DrawData::Data& data = editableData();
+    data.tiledPixmap.push_back(DrawTiledPixmap { rect, pm, offset });
+    data.order.push_back(DrawData::Primitive::TiledPixmap);
 }
 
 #ifndef NO_QT_SUPPORT
 void BufferedPaintProvider::drawPixmap(const PointF& p, const QPixmap& pm)
 {
-    editableData().pixmaps.push_back(DrawPixmap { p, Pixmap::fromQPixmap(pm) });
+    DrawData::Data& data = editableData();
+    data.pixmaps.push_back(DrawPixmap { p, Pixmap::fromQPixmap(pm) });
+    data.order.push_back(DrawData::Primitive::Pixmap);
 }
 
 void BufferedPaintProvider::drawTiledPixmap(const RectF& rect, const QPixmap& pm, const PointF& offset)
 {
-    editableData().tiledPixmap.push_back(DrawTiledPixmap { rect, Pixmap::fromQPixmap(pm), offset });
+    DrawData::Data& data = editableData();
+    data.tiledPixmap.push_back(DrawTiledPixmap { rect, Pixmap::fromQPixmap(pm), offset });
+    data.order.push_back(DrawData::Primitive::TiledPixmap);
 }
 
 #endif
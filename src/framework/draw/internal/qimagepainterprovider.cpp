@@ -30,7 +30,7 @@ namespace mu::draw {
 QImagePainterProvider::QImagePainterProvider(std::shared_ptr<Pixmap> px)
     : QPainterProvider(new QPainter()), m_px(px)
 {
-    m_image = Pixmap::toQPixmap(*px.get()).toImage();
+    m_image = Pixmap::toQImage(*px.get());
     m_painter->begin(&m_image);
 }
 
@@ -42,10 +42,23 @@ QImagePainterProvider::~QImagePainterProvider()
 bool QImagePainterProvider::endTarget(bool endDraw)
 {
     UNUSED(endDraw)
-    * m_px = Pixmap::fromQPixmap(QPixmap::fromImage(m_image));
+    * m_px = Pixmap::fromQImage(m_image);
     return true;
 }
 
+//! NOTE Images are drawn without QPixmap, so the painter can be used outside the GUI thread
+void QImagePainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
+{
+    m_painter->drawImage(QPointF(point.x(), point.y()), Pixmap::toQImage(pm));
+}
+
+void QImagePainterProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset)
+{
+    QBrush brush(Pixmap::toQImage(pm));
+    brush.setTransform(QTransform::fromTranslate(rect.x() - offset.x(), rect.y() - offset.y()));
+    m_painter->fillRect(rect.toQRectF(), brush);
+}
+
 IPaintProviderPtr QImagePainterProvider::make(std::shared_ptr<Pixmap> px)
 {
     return std::make_shared<QImagePainterProvider>(px);
@@ -34,6 +34,11 @@ public:
     ~QImagePainterProvider();
     bool endTarget(bool endDraw) override;
 
+    using QPainterProvider::drawPixmap;
+    using QPainterProvider::drawTiledPixmap;
+    void drawPixmap(const PointF& point, const Pixmap& pm) override;
+    void drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset = PointF()) override;
+
     static IPaintProviderPtr make(std::shared_ptr<Pixmap> px);
 
 private:
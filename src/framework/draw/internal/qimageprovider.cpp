@@ -1,5 +1,7 @@
 #include "qimageprovider.h"
 
+#include <cstring>
+
 #include <QBuffer>
 
 #include "qimagepainterprovider.h"
@@ -16,7 +18,7 @@ std::shared_ptr<Pixmap> QImageProvider::createPixmap(const ByteArray& data) cons
     QImage image;
     image.loadFromData(data.toQByteArrayNoCopy());
 
-    return std::make_shared<Pixmap>(Pixmap::fromQPixmap(QPixmap::fromImage(image)));
+    return std::make_shared<Pixmap>(Pixmap::fromQImage(image));
 }
 
 std::shared_ptr<Pixmap> QImageProvider::createPixmap(int w, int h, int dpm, const Color& color) const
@@ -26,15 +28,15 @@ std::shared_ptr<Pixmap> QImageProvider::createPixmap(int w, int h, int dpm, cons
     image.setDotsPerMeterY(dpm);
     image.fill(color.toQColor());
 
-    return std::make_shared<Pixmap>(Pixmap::fromQPixmap(QPixmap::fromImage(image)));
+    return std::make_shared<Pixmap>(Pixmap::fromQImage(image));
 }
 
 Pixmap QImageProvider::scaled(const Pixmap& origin, const Size& s) const
 {
-    QPixmap qtPixmap = Pixmap::toQPixmap(origin);
-    qtPixmap = qtPixmap.scaled(s.width(), s.height());
+    QImage qtImage = Pixmap::toQImage(origin);
+    qtImage = qtImage.scaled(s.width(), s.height());
 
-    return Pixmap::fromQPixmap(qtPixmap);
+    return Pixmap::fromQImage(qtImage);
 }
 
 std::shared_ptr<IPaintProvider> QImageProvider::painterForImage(std::shared_ptr<Pixmap> pixmap)
@@ -44,8 +46,16 @@ std::shared_ptr<IPaintProvider> QImageProvider::painterForImage(std::shared_ptr<
 
 void QImageProvider::saveAsPng(std::shared_ptr<Pixmap> px, io::IODevice* device)
 {
+    //! NOTE The pixmap data is usually png already, so there is no need to decode and encode it again
+    static const ByteArray PNG_SIGNATURE("\x89PNG\r\n\x1a\n", 8);
+    const ByteArray data = px->data();
+    if (data.size() >= PNG_SIGNATURE.size() && std::memcmp(data.constData(), PNG_SIGNATURE.constData(), PNG_SIGNATURE.size()) == 0) {
+        device->write(data);
+        return;
+    }
+
     QBuffer buf;
     buf.open(QIODevice::WriteOnly);
-    Pixmap::toQPixmap(*px).save(&buf, FILE_FORMAT);
+    Pixmap::toQImage(*px).save(&buf, FILE_FORMAT);
     device->write(buf.data());
 }
@@ -0,0 +1,121 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <functional>
+
+#include <QImage>
+#include <QPixmap>
+
+#include "draw/painter.h"
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
+
+using namespace mu;
+using namespace mu::draw;
+
+class Draw_DrawDataPaintTests : public ::testing::Test
+{
+public:
+};
+
+using DrawFunc = std::function<void (Painter&)>;
+
+static QImage makeImage()
+{
+    QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    return image;
+}
+
+static QImage paintDirectly(const DrawFunc& draw)
+{
+    QImage image = makeImage();
+    {
+        Painter painter(&image, "direct");
+        draw(painter);
+        painter.endDraw();
+    }
+    return image;
+}
+
+static QImage paintRecorded(const DrawFunc& draw)
+{
+    auto buffer = std::make_shared<BufferedPaintProvider>();
+    {
+        Painter painter(buffer, "recorded");
+        draw(painter);
+        painter.endDraw();
+    }
+
+    QImage image = makeImage();
+    {
+        Painter painter(&image, "replay");
+        DrawDataPaint::paint(&painter, buffer->drawData());
+        painter.endDraw();
+    }
+    return image;
+}
+
+TEST_F(Draw_DrawDataPaintTests, ReplayKeepsDrawOrder)
+{
+    //! GIVEN Overlapping primitives of different kinds, drawn with the same state
+    QPixmap red(60, 60);
+    red.fill(Qt::red);
+
+    DrawFunc draw = [&red](Painter& painter) {
+        painter.setNoPen();
+        painter.setBrush(Brush(Color::blueColor));
+
+        painter.drawPixmap(PointF(0.0, 0.0), red);
+        painter.drawRect(RectF(20.0, 20.0, 60.0, 60.0));
+        painter.drawPolygon(PolygonF(std::vector<PointF> { PointF(40.0, 40.0), PointF(100.0, 40.0), PointF(40.0, 100.0) }));
+        painter.drawPixmap(PointF(50.0, 50.0), red);
+    };
+
+    //! DO Paint them directly and through the recorded draw data
+    QImage direct = paintDirectly(draw);
+    QImage replayed = paintRecorded(draw);
+
+    //! CHECK The images are the same
+    EXPECT_EQ(direct.pixelColor(30, 30), QColor(Qt::blue));
+    EXPECT_EQ(direct.pixelColor(55, 55), QColor(Qt::red));
+    EXPECT_TRUE(direct == replayed);
+}
+
+TEST_F(Draw_DrawDataPaintTests, ReplayRestoresStateAfterPath)
+{
+    //! GIVEN A path drawn with its own brush, followed by a polygon drawn with the state brush
+    DrawFunc draw = [](Painter& painter) {
+        painter.setNoPen();
+        painter.setBrush(Brush(Color::greenColor));
+        painter.fillRect(RectF(0.0, 0.0, 50.0, 50.0), Brush(Color::redColor));
+        painter.drawPolygon(PolygonF(std::vector<PointF> { PointF(25.0, 25.0), PointF(75.0, 25.0), PointF(75.0, 75.0), PointF(25.0, 75.0) }));
+    };
+
+    //! DO Paint them directly and through the recorded draw data
+    QImage direct = paintDirectly(draw);
+    QImage replayed = paintRecorded(draw);
+
+    //! CHECK The images are the same
+    EXPECT_TRUE(direct == replayed);
+}
@@ -27,6 +27,7 @@
 
 #ifndef NO_QT_SUPPORT
 #include <QPixmap>
+#include <QImage>
 #include <QBuffer>
 #endif
 
@@ -70,6 +71,28 @@ public:
         return qtPixMap;
     }
 
+    //! NOTE Unlike QPixmap, QImage can be used outside the GUI thread
+    static Pixmap fromQImage(const QImage& qtImage)
+    {
+        QByteArray bytes;
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::WriteOnly);
+        qtImage.save(&buffer, "PNG");
+
+        Pixmap result({ qtImage.width(), qtImage.height() });
+        result.setData(ByteArray::fromQByteArray(bytes));
+
+        return result;
+    }
+
+    static QImage toQImage(const Pixmap& pixmap)
+    {
+        QImage qtImage;
+        qtImage.loadFromData(pixmap.data().toQByteArrayNoCopy());
+
+        return qtImage;
+    }
+
 #endif
 
 private:
@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "drawdatapaint.h"
+
+#include "../painter.h"
+
+using namespace mu::draw;
+
+static void applyState(Painter* painter, const DrawData::State& st)
+{
+    painter->setWorldTransform(st.transform);
+    painter->setAntialiasing(st.isAntialiasing);
+    painter->setCompositionMode(st.compositionMode);
+    painter->setFont(st.font);
+    painter->setPen(st.pen);
+    painter->setBrush(st.brush);
+}
+
+static void paintPath(Painter* painter, const DrawPath& path)
+{
+    painter->setPen(path.pen);
+    painter->setBrush(path.brush);
+
+    switch (path.mode) {
+    case DrawMode::Stroke:
+        painter->setBrush(BrushStyle::NoBrush);
+        break;
+    case DrawMode::Fill:
+        painter->setNoPen();
+        break;
+    case DrawMode::StrokeAndFill:
+        break;
+    }
+
+    painter->drawPath(path.path);
+}
+
+static void paintPolygon(Painter* painter, const DrawPolygon& pol)
+{
+    switch (pol.mode) {
+    case PolygonMode::OddEven:
+        painter->drawPolygon(pol.polygon, FillRule::OddEvenFill);
+        break;
+    case PolygonMode::Winding:
+        painter->drawPolygon(pol.polygon, FillRule::WindingFill);
+        break;
+    case PolygonMode::Convex:
+        painter->drawConvexPolygon(pol.polygon);
+        break;
+    case PolygonMode::Polyline:
+        painter->drawPolyline(pol.polygon);
+        break;
+    }
+}
+
+static void paintInKindOrder(Painter* painter, const DrawData::Data& d)
+{
+    for (const DrawPath& path : d.paths) {
+        paintPath(painter, path);
+    }
+
+    if (!d.paths.empty()) {
+        painter->setPen(d.state.pen);
+        painter->setBrush(d.state.brush);
+    }
+
+    for (const DrawPolygon& pol : d.polygons) {
+        paintPolygon(painter, pol);
+    }
+
+    for (const DrawText& text : d.texts) {
+        painter->drawText(text.pos, text.text);
+    }
+
+    for (const DrawRectText& text : d.rectTexts) {
+        painter->drawText(text.rect, text.flags, text.text);
+    }
+
+    for (const DrawPixmap& pm : d.pixmaps) {
+        painter->drawPixmap(pm.pos, pm.pm);
+    }
+
+    for (const DrawTiledPixmap& pm : d.tiledPixmap) {
+        painter->drawTiledPixmap(pm.rect, pm.pm, pm.offset);
+    }
+}
+
+static void paintInDrawOrder(Painter* painter, const DrawData::Data& d)
+{
+    size_t path = 0;
+    size_t polygon = 0;
+    size_t text = 0;
+    size_t rectText = 0;
+    size_t pixmap = 0;
+    size_t tiledPixmap = 0;
+
+    for (DrawData::Primitive primitive : d.order) {
+        switch (primitive) {
+        case DrawData::Primitive::Path:
+            paintPath(painter, d.paths.at(path++));
+            painter->setPen(d.state.pen);
+            painter->setBrush(d.state.brush);
+            break;
+        case DrawData::Primitive::Polygon:
+            paintPolygon(painter, d.polygons.at(polygon++));
+            break;
+        case DrawData::Primitive::Text: {
+            const DrawText& t = d.texts.at(text++);
+            painter->drawText(t.pos, t.text);
+            break;
+        }
+        case DrawData::Primitive::RectText: {
+            const DrawRectText& t = d.rectTexts.at(rectText++);
+            painter->drawText(t.rect, t.flags, t.text);
+            break;
+        }
+        case DrawData::Primitive::Pixmap: {
+            const DrawPixmap& pm = d.pixmaps.at(pixmap++);
+            painter->drawPixmap(pm.pos, pm.pm);
+            break;
+        }
+        case DrawData::Primitive::TiledPixmap: {
+            const DrawTiledPixmap& pm = d.tiledPixmap.at(tiledPixmap++);
+            painter->drawTiledPixmap(pm.rect, pm.pm, pm.offset);
+            break;
+        }
+        }
+    }
+}
+
+void DrawDataPaint::paint(Painter* painter, const DrawData& data)
+{
+    for (const DrawData::Object& obj : data.objects) {
+        for (const DrawData::Data& d : obj.datas) {
+            applyState(painter, d.state);
+
+            size_t count = d.paths.size() + d.polygons.size() + d.texts.size() + d.rectTexts.size()
+                           + d.pixmaps.size() + d.tiledPixmap.size();
+
+            //! NOTE Data which is not recorded by BufferedPaintProvider (e.g. read from json) has no order
+            if (d.order.size() == count) {
+                paintInDrawOrder(painter, d);
+            } else {
+                paintInKindOrder(painter, d);
+            }
+        }
+    }
+}
@@ -111,6 +111,25 @@ void ObjectAllocator::free(void* chunk, size_t size)
     m_statistic.totalFreeCount++;
 }
 
+void* ObjectAllocator::allocUnpooled(size_t size, MemoryTag tag)
+{
+    if (!m_chunkSize) {
+        m_chunkSize = size;
+    }
+
+    m_statistic.totalAllocatedCount++;
+
+    MemoryTagScope scope(tag);
+    return ::operator new(size);
+}
+
+void ObjectAllocator::freeUnpooled(void* ptr, size_t size)
+{
+    m_statistic.totalFreeCount++;
+
+    ::operator delete(ptr, size);
+}
+
 void ObjectAllocator::cleanup()
 {
     if (m_blocks.empty()) {
@@ -160,6 +179,9 @@ ObjectAllocator::Block ObjectAllocator::allocateBlock(size_t chunkSize) const
 
     Block b;
     b.begin = reinterpret_cast<Chunk*>(malloc(blockSize));
+
+    //! NOTE Blocks are never freed, so they stay charged to the tag that was current when they were allocated
+    MemoryAccounting::addAllocation(MemoryAccounting::currentTag(), blockSize);
     b.chunkCount = chunkCount;
     b.chunkSize = chunkSize;
 
@@ -221,6 +243,11 @@ void AllocatorsRegister::unreg(ObjectAllocator* a)
     m_allocators.remove(a);
 }
 
+const std::list<ObjectAllocator*>& AllocatorsRegister::allocators() const
+{
+    return m_allocators;
+}
+
 void AllocatorsRegister::cleanupAll(const std::string& module)
 {
     for (ObjectAllocator* a : m_allocators) {
@@ -26,8 +26,20 @@
 #include <vector>
 #include <list>
 #include <string>
+#include <atomic>
+
+#include "memoryaccounting.h"
 
 namespace mu {
+//! NOTE With memory accounting, objects that are not pooled are charged to the memory tag
+//! returned by `objectMemoryTag()`. By default it is the tag of the allocating thread;
+//! a class can define its own static `objectMemoryTag()` to charge all its objects
+//! (and those of its subclasses) to a fixed tag.
+inline MemoryTag objectMemoryTag()
+{
+    return MemoryAccounting::currentTag();
+}
+
 #define OBJECT_ALLOCATOR(Module, ClassName) \
 public: \
     static ObjectAllocator& allocator() { \
@@ -35,11 +47,19 @@ public: \
         return a; \
     } \
     static void* operator new(size_t sz) { \
-        return ObjectAllocator::enabled() ? allocator().alloc(sz) : ::operator new(sz); \
+        if (ObjectAllocator::enabled()) { \
+            return allocator().alloc(sz); \
+        } \
+        if (MemoryAccounting::enabled()) { \
+            return allocator().allocUnpooled(sz, objectMemoryTag()); \
+        } \
+        return ::operator new(sz); \
     } \
     static void operator delete(void* ptr, size_t sz) { \
         if (ObjectAllocator::enabled()) { \
             allocator().free(ptr, sz); \
+        } else if (MemoryAccounting::enabled()) { \
+            allocator().freeUnpooled(ptr, sz); \
         } else { \
             ::operator delete(ptr, sz); \
         } \
@@ -75,6 +95,11 @@ public:
 
     void* alloc(size_t size);
     void free(void* ptr, size_t size);
+
+    //! NOTE Used instead of the pool, when it is disabled but memory accounting is enabled
+    void* allocUnpooled(size_t size, MemoryTag tag);
+    void freeUnpooled(void* ptr, size_t size);
+
     void cleanup();
 
     template<class T>
@@ -99,6 +124,7 @@ public:
         uint64_t totalFreeCount = 0;
 
         uint64_t usedChunks() const { return totalChunks - freeChunks; }
+        uint64_t liveObjects() const { return totalAllocatedCount - totalFreeCount; }
         uint64_t allocatedBytes() const { return totalChunks * chunkSize; }
     };
 
@@ -144,8 +170,8 @@ private:
 
     struct Statistic
     {
-        uint64_t totalAllocatedCount = 0;
-        uint64_t totalFreeCount = 0;
+        std::atomic<uint64_t> totalAllocatedCount = 0;
+        std::atomic<uint64_t> totalFreeCount = 0;
     };
 
     Statistic m_statistic;
@@ -166,6 +192,8 @@ public:
 
     void cleanupAll(const std::string& module);
 
+    const std::list<ObjectAllocator*>& allocators() const;
+
     void printStatistic(const std::string& title);
     void printState(const std::string& title);
 
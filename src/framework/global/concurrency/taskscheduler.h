@@ -35,6 +35,7 @@
 #include <utility>
 
 #include "log.h"
+#include "runtime.h"
 
 namespace mu {
 typedef std::invoke_result_t<decltype(std::thread::hardware_concurrency)> thread_pool_size_t;
@@ -168,6 +169,8 @@ private:
 
     void th_workerLoop()
     {
+        runtime::setThreadName("task_scheduler");
+
         while (m_isActive) {
             std::unique_lock<std::mutex> lock(m_mutex);
             m_newTaskAvailableCv.wait(lock, [this] { return !m_taskQueue.empty() || !m_isActive; });
@@ -0,0 +1,408 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "editlatencyprobe.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+
+#include "io/file.h"
+#include "serialization/json.h"
+#include "stringutils.h"
+
+#include "log.h"
+
+using namespace mu;
+
+static const std::string ALL_ACTIONS("all");
+
+EditLatencyProbe* EditLatencyProbe::instance()
+{
+    static EditLatencyProbe p;
+    return &p;
+}
+
+const char* EditLatencyProbe::phaseName(Phase phase)
+{
+    switch (phase) {
+    case Phase::Command: return "command";
+    case Phase::EndCmd: return "endCmd";
+    case Phase::Layout: return "layout";
+    case Phase::Playback: return "playback";
+    case Phase::Repaint: return "repaint";
+    case Phase::Count: break;
+    }
+
+    return "unknown";
+}
+
+void EditLatencyProbe::setEnabled(bool arg)
+{
+    std::lock_guard<std::mutex> lock(m_actionMutex);
+    m_enabled = arg;
+    if (!arg) {
+        m_state = State::Idle;
+    }
+}
+
+bool EditLatencyProbe::enabled() const
+{
+    return m_enabled;
+}
+
+void EditLatencyProbe::setWindowSize(size_t size)
+{
+    std::lock_guard<std::mutex> lock(m_samplesMutex);
+    m_windowSize = std::max(size_t(1), size);
+    m_samples.clear();
+}
+
+void EditLatencyProbe::clear()
+{
+    std::lock_guard<std::mutex> lock(m_samplesMutex);
+    m_samples.clear();
+}
+
+int64_t EditLatencyProbe::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool EditLatencyProbe::isActionThread() const
+{
+    return m_actionThread == std::this_thread::get_id();
+}
+
+// ============================================
+// Action
+// ============================================
+void EditLatencyProbe::beginAction(const std::string& name)
+{
+    if (!m_enabled) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_actionMutex);
+    doBeginAction(name);
+}
+
+void EditLatencyProbe::doBeginAction(const std::string& name)
+{
+    State state = m_state;
+    if (state != State::Idle && !isActionThread()) {
+        return;
+    }
+
+    //! NOTE An action dispatched from inside an edit is a part of it
+    if (state == State::Editing) {
+        return;
+    }
+
+    //! NOTE The previous edit has not been repainted, so it is finished when it was applied
+    if (state == State::WaitingRepaint) {
+        finishAction(m_editEndNs);
+    }
+
+    m_actionThread = std::this_thread::get_id();
+    m_actionName = name;
+    m_actionBeginNs = nowNs();
+    m_editBeginNs = 0;
+    m_editEndNs = 0;
+    m_phasesNs.fill(0);
+    m_state = State::Started;
+}
+
+void EditLatencyProbe::leaveAction()
+{
+    if (m_state != State::Started) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_actionMutex);
+    if (m_state == State::Started && isActionThread()) {
+        m_state = State::Idle;
+    }
+}
+
+void EditLatencyProbe::beginEdit()
+{
+    if (!m_enabled) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_actionMutex);
+
+    State state = m_state;
+    if (state == State::Idle) {
+        doBeginAction("edit");
+        state = m_state;
+    }
+
+    if (!isActionThread()) {
+        return;
+    }
+
+    //! NOTE Several edits before a repaint are counted as one action
+    if (state == State::Started || state == State::WaitingRepaint) {
+        m_editBeginNs = nowNs();
+        m_state = State::Editing;
+    }
+}
+
+void EditLatencyProbe::endEdit(bool rollback)
+{
+    if (m_state != State::Editing) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_actionMutex);
+    if (m_state != State::Editing || !isActionThread()) {
+        return;
+    }
+
+    if (rollback) {
+        m_state = State::Idle;
+        return;
+    }
+
+    m_editEndNs = nowNs();
+    m_phasesNs[static_cast<size_t>(Phase::Command)] += m_editEndNs - m_editBeginNs;
+    m_state = State::WaitingRepaint;
+}
+
+void EditLatencyProbe::addPhaseTime(Phase phase, int64_t ns)
+{
+    if (m_state == State::Idle) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_actionMutex);
+
+    State state = m_state;
+    if (state == State::Idle || !isActionThread()) {
+        return;
+    }
+
+    m_phasesNs[static_cast<size_t>(phase)] += ns;
+
+    //! NOTE Undo/redo change the score without starting an edit
+    if (phase == Phase::EndCmd && state == State::Started) {
+        m_editEndNs = nowNs();
+        m_state = State::WaitingRepaint;
+    }
+}
+
+//! NOTE The notation may be painted on the render thread, so any thread can finish the action
+void EditLatencyProbe::repainted(int64_t repaintNs)
+{
+    if (m_state != State::WaitingRepaint) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_actionMutex);
+    if (m_state != State::WaitingRepaint) {
+        return;
+    }
+
+    m_phasesNs[static_cast<size_t>(Phase::Repaint)] += repaintNs;
+    finishAction(nowNs());
+}
+
+void EditLatencyProbe::finishAction(int64_t endNs)
+{
+    Sample sample;
+    sample.totalMs = static_cast<double>(endNs - m_actionBeginNs) / 1000000.0;
+    for (size_t i = 0; i < PHASE_COUNT; ++i) {
+        sample.phasesMs[i] = static_cast<double>(m_phasesNs[i]) / 1000000.0;
+    }
+
+    addSample(m_actionName, sample);
+
+    m_state = State::Idle;
+}
+
+void EditLatencyProbe::addSample(const std::string& action, const Sample& sample)
+{
+    std::lock_guard<std::mutex> lock(m_samplesMutex);
+
+    Samples& samples = m_samples[action];
+    size_t windowSize = m_windowSize;
+    if (samples.ring.size() < windowSize) {
+        samples.ring.push_back(sample);
+    } else {
+        samples.ring[samples.next] = sample;
+    }
+
+    samples.next = (samples.next + 1) % windowSize;
+}
+
+// ============================================
+// Statistic
+// ============================================
+EditLatencyProbe::Percentiles EditLatencyProbe::percentiles(std::vector<double>& values)
+{
+    Percentiles p;
+    p.count = values.size();
+    if (values.empty()) {
+        return p;
+    }
+
+    std::sort(values.begin(), values.end());
+
+    //! NOTE Nearest-rank method
+    auto rank = [&values](double percent) {
+        size_t idx = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(values.size())));
+        return values.at(std::clamp(idx, size_t(1), values.size()) - 1);
+    };
+
+    p.p50 = rank(50.0);
+    p.p95 = rank(95.0);
+    p.p99 = rank(99.0);
+    p.max = values.back();
+
+    return p;
+}
+
+EditLatencyProbe::ActionStats EditLatencyProbe::makeStats(const std::string& action, const std::vector<const Sample*>& samples)
+{
+    ActionStats stats;
+    stats.action = action;
+
+    std::vector<double> values;
+    values.reserve(samples.size());
+
+    for (const Sample* s : samples) {
+        values.push_back(s->totalMs);
+    }
+    stats.total = percentiles(values);
+
+    for (size_t i = 0; i < PHASE_COUNT; ++i) {
+        values.clear();
+        for (const Sample* s : samples) {
+            values.push_back(s->phasesMs[i]);
+        }
+        stats.phases[i] = percentiles(values);
+    }
+
+    return stats;
+}
+
+std::vector<EditLatencyProbe::ActionStats> EditLatencyProbe::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_samplesMutex);
+
+    std::vector<ActionStats> result;
+    std::vector<const Sample*> all;
+
+    for (const auto& p : m_samples) {
+        std::vector<const Sample*> samples;
+        for (const Sample& s : p.second.ring) {
+            samples.push_back(&s);
+            all.push_back(&s);
+        }
+
+        result.push_back(makeStats(p.first, samples));
+    }
+
+    result.insert(result.begin(), makeStats(ALL_ACTIONS, all));
+
+    return result;
+}
+
+#define FORMAT(str, width) mu::strings::leftJustified(str, width)
+#define TITLE(str) FORMAT(std::string(str), 14)
+
+static std::string formatMs(double ms)
+{
+    std::stringstream stream;
+    stream.precision(2);
+    stream << std::fixed << ms;
+    return FORMAT(stream.str(), 14);
+}
+
+std::string EditLatencyProbe::printableReport() const
+{
+    std::stringstream stream;
+    stream << "\n\n";
+    stream << "Edit latency (ms, p50 / p95 / p99 / max over the last " << m_windowSize.load() << " samples of each action)\n";
+    stream << FORMAT("Action", 30) << TITLE("Phase") << TITLE("Count") << TITLE("p50") << TITLE("p95") << TITLE("p99") << TITLE("max")
+           << "\n";
+
+    auto printPercentiles = [&stream](const std::string& action, const std::string& phase, const Percentiles& p) {
+        stream << FORMAT(action, 30) << FORMAT(phase, 14) << FORMAT(std::to_string(p.count), 14)
+               << formatMs(p.p50) << formatMs(p.p95) << formatMs(p.p99) << formatMs(p.max) << "\n";
+    };
+
+    for (const ActionStats& s : stats()) {
+        printPercentiles(s.action, "total", s.total);
+        for (size_t i = 0; i < PHASE_COUNT; ++i) {
+            printPercentiles("", phaseName(static_cast<Phase>(i)), s.phases[i]);
+        }
+    }
+
+    return stream.str();
+}
+
+ByteArray EditLatencyProbe::jsonReport() const
+{
+    auto percentilesToJson = [](const Percentiles& p) {
+        JsonObject obj;
+        obj["count"] = static_cast<int>(p.count);
+        obj["p50"] = p.p50;
+        obj["p95"] = p.p95;
+        obj["p99"] = p.p99;
+        obj["max"] = p.max;
+        return obj;
+    };
+
+    JsonArray actions;
+    for (const ActionStats& s : stats()) {
+        JsonObject phases;
+        for (size_t i = 0; i < PHASE_COUNT; ++i) {
+            phases[phaseName(static_cast<Phase>(i))] = percentilesToJson(s.phases[i]);
+        }
+
+        JsonObject action;
+        action["action"] = s.action;
+        action["total"] = percentilesToJson(s.total);
+        action["phases"] = phases;
+        actions.append(action);
+    }
+
+    JsonObject root;
+    root["unit"] = "ms";
+    root["windowSize"] = static_cast<int>(m_windowSize.load());
+    root["actions"] = actions;
+
+    return JsonDocument(root).toJson(JsonDocument::Format::Indented);
+}
+
+Ret EditLatencyProbe::saveReport(const io::path_t& filePath) const
+{
+    Ret ret = io::File::writeFile(filePath, jsonReport());
+    if (!ret) {
+        LOGE() << "failed save edit latency report: " << filePath << ", err: " << ret.toString();
+    }
+
+    return ret;
+}
@@ -0,0 +1,209 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_GLOBAL_EDITLATENCYPROBE_H
+#define MU_GLOBAL_EDITLATENCYPROBE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "io/path.h"
+#include "types/bytearray.h"
+#include "types/ret.h"
+
+//! NOTE Measures how long an edit takes, from the user action to the repaint of the notation.
+//! An action is started by the actions dispatcher (or by the edit itself, for mouse edits),
+//! becomes an edit when the notation undo stack starts changes (or does undo/redo)
+//! and finishes when the main notation view has been repainted (the paint may happen on the render thread).
+//! An edit that is not repainted before the next action is finished at the time it was applied.
+//! The phases are measured inside the action:
+//!     command  - from the start of the changes to their commit (includes endCmd)
+//!     endCmd   - Score::endCmd or Score::undoRedo (includes layout and playback)
+//!     layout   - Layout::doLayoutRange
+//!     playback - PlaybackModel::updateEvents
+//!     repaint  - the paint of the main notation view
+//! The last samples of every action are kept to calculate p50/p95/p99.
+//! Disabled by default, see `--diagnostic-edit-latency` and `api.diagnostics`.
+
+namespace mu {
+class EditLatencyProbe
+{
+public:
+
+    static EditLatencyProbe* instance();
+
+    enum class Phase {
+        Command = 0,
+        EndCmd,
+        Layout,
+        Playback,
+        Repaint,
+
+        Count
+    };
+
+    static constexpr size_t PHASE_COUNT = static_cast<size_t>(Phase::Count);
+    static constexpr size_t DEFAULT_WINDOW_SIZE = 1000;
+
+    static const char* phaseName(Phase phase);
+
+    void setEnabled(bool arg);
+    bool enabled() const;
+
+    void setWindowSize(size_t size);
+    void clear();
+
+    // Action
+    void beginAction(const std::string& name);
+    void leaveAction();
+    void beginEdit();
+    void endEdit(bool rollback);
+    void addPhaseTime(Phase phase, int64_t ns);
+    void repainted(int64_t repaintNs);
+
+    static int64_t nowNs();
+
+    // Statistic
+    struct Percentiles
+    {
+        size_t count = 0;
+        double p50 = 0.0; // ms
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    struct ActionStats
+    {
+        std::string action;
+        Percentiles total;
+        std::array<Percentiles, PHASE_COUNT> phases;
+    };
+
+    //! NOTE The first item is the summary over all actions
+    std::vector<ActionStats> stats() const;
+
+    std::string printableReport() const;
+    ByteArray jsonReport() const;
+    Ret saveReport(const io::path_t& filePath) const;
+
+private:
+    EditLatencyProbe() = default;
+
+    enum class State {
+        Idle = 0,
+        Started,        // the action has been dispatched, but it has not edited anything (yet)
+        Editing,        // between the start of the edit and its apply
+        WaitingRepaint  // the edit has been applied, waiting for the notation to be repainted
+    };
+
+    struct Sample
+    {
+        double totalMs = 0.0;
+        std::array<double, PHASE_COUNT> phasesMs = {};
+    };
+
+    struct Samples
+    {
+        std::vector<Sample> ring;
+        size_t next = 0;
+    };
+
+    bool isActionThread() const;
+    void doBeginAction(const std::string& name);
+    void finishAction(int64_t endNs);
+    void addSample(const std::string& action, const Sample& sample);
+
+    static Percentiles percentiles(std::vector<double>& values);
+    static ActionStats makeStats(const std::string& action, const std::vector<const Sample*>& samples);
+
+    std::atomic<bool> m_enabled = false;
+
+    // Current action, changed from the action thread and finished by the repaint from any thread
+    mutable std::mutex m_actionMutex;
+    std::atomic<State> m_state = State::Idle;
+    std::atomic<std::thread::id> m_actionThread;
+    std::string m_actionName;
+    int64_t m_actionBeginNs = 0;
+    int64_t m_editBeginNs = 0;
+    int64_t m_editEndNs = 0;
+    std::array<int64_t, PHASE_COUNT> m_phasesNs = {};
+
+    mutable std::mutex m_samplesMutex;
+    std::atomic<size_t> m_windowSize = DEFAULT_WINDOW_SIZE;
+    std::map<std::string, Samples> m_samples;
+};
+
+class EditLatencyPhaseScope
+{
+public:
+    explicit EditLatencyPhaseScope(EditLatencyProbe::Phase phase)
+        : m_phase(phase)
+    {
+        if (EditLatencyProbe::instance()->enabled()) {
+            m_beginNs = EditLatencyProbe::nowNs();
+        }
+    }
+
+    ~EditLatencyPhaseScope()
+    {
+        if (m_beginNs) {
+            EditLatencyProbe::instance()->addPhaseTime(m_phase, EditLatencyProbe::nowNs() - m_beginNs);
+        }
+    }
+
+private:
+    EditLatencyProbe::Phase m_phase = EditLatencyProbe::Phase::Command;
+    int64_t m_beginNs = 0;
+};
+
+class EditLatencyRepaintScope
+{
+public:
+    explicit EditLatencyRepaintScope(bool isMainView)
+    {
+        if (isMainView && EditLatencyProbe::instance()->enabled()) {
+            m_beginNs = EditLatencyProbe::nowNs();
+        }
+    }
+
+    ~EditLatencyRepaintScope()
+    {
+        if (m_beginNs) {
+            EditLatencyProbe::instance()->repainted(EditLatencyProbe::nowNs() - m_beginNs);
+        }
+    }
+
+private:
+    int64_t m_beginNs = 0;
+};
+}
+
+#define EDIT_LATENCY_PHASE(phase) mu::EditLatencyPhaseScope __editLatencyPhase(mu::EditLatencyProbe::Phase::phase)
+#define EDIT_LATENCY_REPAINT(isMainView) mu::EditLatencyRepaintScope __editLatencyRepaint(isMainView)
+
+#endif // MU_GLOBAL_EDITLATENCYPROBE_H
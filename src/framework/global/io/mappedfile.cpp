@@ -0,0 +1,202 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "mappedfile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#define MU_MAPPEDFILE_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "log.h"
+
+using namespace mu::io;
+
+MappedFile::MappedFile(const path_t& filePath)
+    : m_filePath(filePath)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+    unmap();
+}
+
+path_t MappedFile::filePath() const
+{
+    return m_filePath;
+}
+
+bool MappedFile::exists() const
+{
+    return fileSystem()->exists(m_filePath);
+}
+
+bool MappedFile::isMapped() const
+{
+    return m_mapped != nullptr;
+}
+
+bool MappedFile::doOpen(OpenMode m)
+{
+    if (m != IODevice::ReadOnly) {
+        NOT_SUPPORTED << "only read mode supported";
+        return false;
+    }
+
+    if (m_mapped || !m_data.empty()) {
+        return true;
+    }
+
+    if (map()) {
+        return true;
+    }
+
+    //! NOTE Fallback, for example for empty files or on platforms without mapping
+    if (!exists()) {
+        return false;
+    }
+
+    return fileSystem()->readFile(m_filePath, m_data);
+}
+
+#if defined(_WIN32)
+bool MappedFile::map()
+{
+    std::u16string path = m_filePath.toString().toStdU16String();
+    HANDLE file = CreateFileW(reinterpret_cast<LPCWSTR>(path.c_str()), GENERIC_READ, FILE_SHARE_READ,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) {
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_mapped = static_cast<const uint8_t*>(view);
+    m_mappedSize = static_cast<size_t>(size.QuadPart);
+    m_mappingHandle = mapping;
+    return true;
+}
+
+void MappedFile::unmap()
+{
+    if (m_mapped) {
+        UnmapViewOfFile(m_mapped);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    }
+
+    m_mapped = nullptr;
+    m_mappedSize = 0;
+    m_mappingHandle = nullptr;
+}
+
+#elif defined(MU_MAPPEDFILE_POSIX)
+bool MappedFile::map()
+{
+    int fd = ::open(m_filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    //! NOTE The mapping keeps its own reference to the file
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+
+    m_mapped = static_cast<const uint8_t*>(addr);
+    m_mappedSize = size;
+    return true;
+}
+
+void MappedFile::unmap()
+{
+    if (m_mapped) {
+        ::munmap(const_cast<uint8_t*>(m_mapped), m_mappedSize);
+    }
+
+    m_mapped = nullptr;
+    m_mappedSize = 0;
+}
+
+#else
+bool MappedFile::map()
+{
+    return false;
+}
+
+void MappedFile::unmap()
+{
+}
+
+#endif
+
+size_t MappedFile::dataSize() const
+{
+    return m_mapped ? m_mappedSize : m_data.size();
+}
+
+const uint8_t* MappedFile::rawData() const
+{
+    return m_mapped ? m_mapped : m_data.constData();
+}
+
+bool MappedFile::resizeData(size_t)
+{
+    NOT_SUPPORTED;
+    return false;
+}
+
+size_t MappedFile::writeData(const uint8_t*, size_t)
+{
+    NOT_SUPPORTED;
+    return 0;
+}
@@ -0,0 +1,405 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "memoryaccounting.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <vector>
+
+#include "allocator.h"
+#include "stringutils.h"
+#include "serialization/json.h"
+
+using namespace mu;
+
+static constexpr size_t TOP_OBJECTS_COUNT = 20;
+
+struct alignas(64) TagCounters
+{
+    std::atomic<int64_t> liveBytes = 0;
+    std::atomic<int64_t> peakBytes = 0;
+    std::atomic<uint64_t> allocatedBytes = 0;
+    std::atomic<uint64_t> allocationCount = 0;
+    std::atomic<uint64_t> deallocationCount = 0;
+};
+
+static TagCounters s_counters[MemoryAccounting::TAG_COUNT];
+static thread_local MemoryTag s_currentTag = MemoryTag::Untagged;
+static const std::chrono::steady_clock::time_point s_startTime = std::chrono::steady_clock::now();
+
+// ============================================
+// Global operator new/delete
+// ============================================
+#ifdef MEMORY_ACCOUNTING_ENABLED
+
+#ifdef _WIN32
+#error "Memory accounting is not supported on Windows, where every DLL has its own operator new/delete"
+#endif
+
+//! NOTE Every block starts with a header that remembers its size and tag,
+//! so that it is freed back to the tag it was charged to. This requires that every block
+//! is freed by the replaced operator delete, which is not the case on Windows (see above).
+//! The aligned (std::align_val_t) versions are not replaced, so they are not accounted.
+struct alignas(alignof(std::max_align_t)) AllocationHeader
+{
+    size_t size = 0;
+    MemoryTag tag = MemoryTag::Untagged;
+};
+
+static void* accountedAlloc(std::size_t size) noexcept
+{
+    void* block = std::malloc(sizeof(AllocationHeader) + size);
+    if (!block) {
+        return nullptr;
+    }
+
+    MemoryTag tag = s_currentTag;
+    AllocationHeader* header = new (block) AllocationHeader { size, tag };
+    MemoryAccounting::addAllocation(tag, size);
+
+    return header + 1;
+}
+
+static void accountedFree(void* ptr) noexcept
+{
+    if (!ptr) {
+        return;
+    }
+
+    AllocationHeader* header = static_cast<AllocationHeader*>(ptr) - 1;
+    MemoryAccounting::addDeallocation(header->tag, header->size);
+    std::free(header);
+}
+
+static void* accountedNew(std::size_t size)
+{
+    while (true) {
+        if (void* ptr = accountedAlloc(size)) {
+            return ptr;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+
+        handler();
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return accountedNew(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return accountedNew(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return accountedNew(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return accountedNew(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr) noexcept
+{
+    accountedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    accountedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    accountedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    accountedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    accountedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    accountedFree(ptr);
+}
+
+#endif
+
+// ============================================
+// MemoryAccounting
+// ============================================
+MemoryTag MemoryAccounting::currentTag()
+{
+    return s_currentTag;
+}
+
+void MemoryAccounting::setCurrentTag(MemoryTag tag)
+{
+    s_currentTag = tag;
+}
+
+const char* MemoryAccounting::tagName(MemoryTag tag)
+{
+    switch (tag) {
+    case MemoryTag::Untagged: return "untagged";
+    case MemoryTag::Layout: return "layout";
+    case MemoryTag::Undo: return "undo";
+    case MemoryTag::Playback: return "playback";
+    case MemoryTag::Import: return "import";
+    case MemoryTag::Audio: return "audio";
+    case MemoryTag::Count: break;
+    }
+
+    return "unknown";
+}
+
+void MemoryAccounting::addAllocation(MemoryTag tag, size_t bytes)
+{
+    TagCounters& c = s_counters[static_cast<size_t>(tag)];
+
+    int64_t live = c.liveBytes.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) + static_cast<int64_t>(bytes);
+    int64_t peak = c.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !c.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+
+    c.allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    c.allocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::addDeallocation(MemoryTag tag, size_t bytes)
+{
+    TagCounters& c = s_counters[static_cast<size_t>(tag)];
+    c.liveBytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    c.deallocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+MemoryAccounting::TagStats MemoryAccounting::Snapshot::total() const
+{
+    TagStats total;
+    for (const TagStats& s : tags) {
+        total.liveBytes += s.liveBytes;
+        total.peakBytes += s.peakBytes; // upper bound, the tags don't peak at the same time
+        total.allocatedBytes += s.allocatedBytes;
+        total.allocationCount += s.allocationCount;
+        total.deallocationCount += s.deallocationCount;
+    }
+
+    return total;
+}
+
+MemoryAccounting::Snapshot MemoryAccounting::snapshot()
+{
+    Snapshot snap;
+    snap.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - s_startTime).count();
+
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        const TagCounters& c = s_counters[i];
+        TagStats& s = snap.tags[i];
+        s.tag = static_cast<MemoryTag>(i);
+        s.liveBytes = c.liveBytes.load(std::memory_order_relaxed);
+        s.peakBytes = c.peakBytes.load(std::memory_order_relaxed);
+        s.allocatedBytes = c.allocatedBytes.load(std::memory_order_relaxed);
+        s.allocationCount = c.allocationCount.load(std::memory_order_relaxed);
+        s.deallocationCount = c.deallocationCount.load(std::memory_order_relaxed);
+    }
+
+    return snap;
+}
+
+void MemoryAccounting::resetPeaks()
+{
+    for (TagCounters& c : s_counters) {
+        c.peakBytes.store(c.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+MemoryAccounting::Rates MemoryAccounting::rates(const TagStats& current, const TagStats& previous, int64_t elapsedMs)
+{
+    Rates r;
+    if (elapsedMs <= 0) {
+        return r;
+    }
+
+    double elapsedSec = static_cast<double>(elapsedMs) / 1000.0;
+    r.allocationsPerSec = static_cast<double>(current.allocationCount - previous.allocationCount) / elapsedSec;
+    r.bytesPerSec = static_cast<double>(current.allocatedBytes - previous.allocatedBytes) / elapsedSec;
+
+    return r;
+}
+
+static std::vector<ObjectAllocator::Info> topObjects()
+{
+    std::vector<ObjectAllocator::Info> infos;
+    for (const ObjectAllocator* a : AllocatorsRegister::instance()->allocators()) {
+        ObjectAllocator::Info info = a->stateInfo();
+        if (info.liveObjects() > 0) {
+            infos.push_back(info);
+        }
+    }
+
+    std::sort(infos.begin(), infos.end(), [](const ObjectAllocator::Info& i1, const ObjectAllocator::Info& i2) {
+        return i1.liveObjects() * i1.chunkSize > i2.liveObjects() * i2.chunkSize;
+    });
+
+    if (infos.size() > TOP_OBJECTS_COUNT) {
+        infos.resize(TOP_OBJECTS_COUNT);
+    }
+
+    return infos;
+}
+
+#define FORMAT(str, width) mu::strings::leftJustified(str, width)
+#define TITLE(str) FORMAT(std::string(str), 16)
+#define VALUE(val) FORMAT(std::to_string(val), 16)
+
+std::string MemoryAccounting::printableReport(const Snapshot& current)
+{
+    return printableReport(current, Snapshot());
+}
+
+std::string MemoryAccounting::printableReport(const Snapshot& current, const Snapshot& previous)
+{
+    std::stringstream stream;
+    stream << "\n\n";
+
+    if (!enabled()) {
+        stream << "Memory accounting is disabled, build with BUILD_MEMORY_ACCOUNTING to enable it\n";
+        return stream.str();
+    }
+
+    int64_t elapsedMs = current.timeMs - previous.timeMs;
+
+    stream << "Memory accounting (uptime: " << current.timeMs << " ms, rates over the last " << elapsedMs << " ms)\n";
+    stream << TITLE("Tag") << TITLE("Live (bytes)") << TITLE("Peak (bytes)") << TITLE("Allocated") << TITLE("Allocs")
+           << TITLE("Frees") << TITLE("Allocs/s") << TITLE("Bytes/s") << "\n";
+
+    auto printStats = [&stream, elapsedMs](const std::string& name, const TagStats& s, const TagStats& prev) {
+        Rates r = rates(s, prev, elapsedMs);
+        stream << FORMAT(name, 16)
+               << VALUE(s.liveBytes)
+               << VALUE(s.peakBytes)
+               << VALUE(s.allocatedBytes)
+               << VALUE(s.allocationCount)
+               << VALUE(s.deallocationCount)
+               << VALUE(static_cast<uint64_t>(r.allocationsPerSec))
+               << VALUE(static_cast<uint64_t>(r.bytesPerSec))
+               << "\n";
+    };
+
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        printStats(tagName(current.tags[i].tag), current.tags[i], previous.tags[i]);
+    }
+
+    stream << "--------------------------------------------------------------------------------------------------------------------------------\n";
+    printStats("Total", current.total(), previous.total());
+
+    std::vector<ObjectAllocator::Info> objects = topObjects();
+    if (!objects.empty()) {
+        stream << "\n" << TITLE("Object") << TITLE("Live objects") << TITLE("Object size") << TITLE("Live (bytes)") << "\n";
+        for (const ObjectAllocator::Info& info : objects) {
+            stream << FORMAT(info.name, 16)
+                   << VALUE(info.liveObjects())
+                   << VALUE(info.chunkSize)
+                   << VALUE(info.liveObjects() * info.chunkSize)
+                   << "\n";
+        }
+    }
+
+    return stream.str();
+}
+
+ByteArray MemoryAccounting::jsonReport(const Snapshot& current)
+{
+    return jsonReport(current, Snapshot());
+}
+
+ByteArray MemoryAccounting::jsonReport(const Snapshot& current, const Snapshot& previous)
+{
+    int64_t elapsedMs = current.timeMs - previous.timeMs;
+
+    auto statsToJson = [elapsedMs](const std::string& name, const TagStats& s, const TagStats& prev) {
+        Rates r = rates(s, prev, elapsedMs);
+
+        JsonObject obj;
+        obj["tag"] = name;
+        obj["liveBytes"] = static_cast<double>(s.liveBytes);
+        obj["peakBytes"] = static_cast<double>(s.peakBytes);
+        obj["allocatedBytes"] = static_cast<double>(s.allocatedBytes);
+        obj["allocations"] = static_cast<double>(s.allocationCount);
+        obj["deallocations"] = static_cast<double>(s.deallocationCount);
+        obj["allocationsPerSec"] = r.allocationsPerSec;
+        obj["bytesPerSec"] = r.bytesPerSec;
+        return obj;
+    };
+
+    JsonArray tags;
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        tags.append(statsToJson(tagName(current.tags[i].tag), current.tags[i], previous.tags[i]));
+    }
+
+    JsonArray objects;
+    for (const ObjectAllocator::Info& info : topObjects()) {
+        JsonObject obj;
+        obj["module"] = info.module;
+        obj["name"] = info.name;
+        obj["liveObjects"] = static_cast<double>(info.liveObjects());
+        obj["objectSize"] = static_cast<double>(info.chunkSize);
+        obj["liveBytes"] = static_cast<double>(info.liveObjects() * info.chunkSize);
+        objects.append(obj);
+    }
+
+    JsonObject root;
+    root["enabled"] = enabled();
+    root["uptimeMs"] = static_cast<double>(current.timeMs);
+    root["intervalMs"] = static_cast<double>(elapsedMs);
+    root["tags"] = tags;
+    root["total"] = statsToJson("total", current.total(), previous.total());
+    root["objects"] = objects;
+
+    return JsonDocument(root).toJson(JsonDocument::Format::Indented);
+}
@@ -0,0 +1,141 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_GLOBAL_MEMORYACCOUNTING_H
+#define MU_GLOBAL_MEMORYACCOUNTING_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//! NOTE Opt-in accounting of heap memory per subsystem (BUILD_MEMORY_ACCOUNTING).
+//! When enabled, the global operator new/delete are replaced: every allocation
+//! is charged to the memory tag that is current on the allocating thread,
+//! and freed back to the same tag, whatever thread frees it.
+//! Objects with OBJECT_ALLOCATOR are also counted per class (see AllocatorsRegister).
+//!
+//! Usage:
+//!     void Layout::doLayoutRange(...)
+//!     {
+//!         MEMORY_TAG_SCOPE(Layout);
+//!         ...
+//!     }
+
+namespace mu {
+class ByteArray;
+
+enum class MemoryTag : uint8_t {
+    Untagged = 0,
+    Layout,
+    Undo,
+    Playback,
+    Import,
+    Audio,
+
+    Count
+};
+
+class MemoryAccounting
+{
+public:
+
+    static constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::Count);
+
+    static constexpr bool enabled()
+    {
+    #ifdef MEMORY_ACCOUNTING_ENABLED
+        return true;
+    #else
+        return false;
+    #endif
+    }
+
+    static MemoryTag currentTag();
+    static void setCurrentTag(MemoryTag tag);
+    static const char* tagName(MemoryTag tag);
+
+    static void addAllocation(MemoryTag tag, size_t bytes);
+    static void addDeallocation(MemoryTag tag, size_t bytes);
+
+    struct TagStats
+    {
+        MemoryTag tag = MemoryTag::Untagged;
+        int64_t liveBytes = 0;
+        int64_t peakBytes = 0;
+        uint64_t allocatedBytes = 0;
+        uint64_t allocationCount = 0;
+        uint64_t deallocationCount = 0;
+    };
+
+    struct Snapshot
+    {
+        int64_t timeMs = 0; // since the start of the process
+        std::array<TagStats, TAG_COUNT> tags;
+
+        TagStats total() const;
+    };
+
+    static Snapshot snapshot();
+    static void resetPeaks();
+
+    struct Rates
+    {
+        double allocationsPerSec = 0.0;
+        double bytesPerSec = 0.0;
+    };
+
+    static Rates rates(const TagStats& current, const TagStats& previous, int64_t elapsedMs);
+
+    //! NOTE Rates are calculated since the previous snapshot,
+    //! or since the start of the process if there is none
+    static std::string printableReport(const Snapshot& current);
+    static std::string printableReport(const Snapshot& current, const Snapshot& previous);
+    static ByteArray jsonReport(const Snapshot& current);
+    static ByteArray jsonReport(const Snapshot& current, const Snapshot& previous);
+};
+
+class MemoryTagScope
+{
+public:
+    explicit MemoryTagScope(MemoryTag tag)
+        : m_prevTag(MemoryAccounting::currentTag())
+    {
+        MemoryAccounting::setCurrentTag(tag);
+    }
+
+    ~MemoryTagScope()
+    {
+        MemoryAccounting::setCurrentTag(m_prevTag);
+    }
+
+private:
+    MemoryTag m_prevTag = MemoryTag::Untagged;
+};
+}
+
+#ifdef MEMORY_ACCOUNTING_ENABLED
+#define MEMORY_TAG_SCOPE(tag) mu::MemoryTagScope __memoryTagScope(mu::MemoryTag::tag)
+#else
+#define MEMORY_TAG_SCOPE(tag)
+#endif
+
+#endif // MU_GLOBAL_MEMORYACCOUNTING_H
@@ -22,11 +22,14 @@
 
 #include "runtime.h"
 
+#include "thirdparty/haw_profiler/src/profiler.h"
+
 static thread_local std::string s_threadName;
 
 void mu::runtime::setThreadName(const std::string& name)
 {
     s_threadName = name;
+    haw::profiler::Profiler::instance()->setThreadName(name);
 }
 
 const std::string& mu::runtime::threadName()
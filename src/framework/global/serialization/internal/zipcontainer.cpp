@@ -21,6 +21,7 @@
  */
 #include "zipcontainer.h"
 
+#include <algorithm>
 #include <ctime>
 #include <cstring>
 #include <zlib.h>
@@ -391,6 +392,7 @@ struct ZipContainer::Impl {
 
     void scanFiles();
     ZipContainer::FileInfo fillFileInfo(int index) const;
+    ByteArray readFileData(const std::string& fileName, bool allowView);
 };
 
 void ZipContainer::Impl::scanFiles()
@@ -685,61 +687,83 @@ int ZipContainer::count() const
 
 ByteArray ZipContainer::fileData(const std::string& fileName) const
 {
-    p->scanFiles();
+    return p->readFileData(fileName, false);
+}
+
+ByteArray ZipContainer::fileDataView(const std::string& fileName) const
+{
+    return p->readFileData(fileName, true);
+}
 
-    size_t i;
-    for (i = 0; i < p->fileHeaders.size(); ++i) {
-        if (p->fileHeaders.at(i).file_name == ByteArray::fromRawData(fileName.c_str(), fileName.size())) {
+ByteArray ZipContainer::Impl::readFileData(const std::string& fileName, bool allowView)
+{
+    scanFiles();
+
+    const ByteArray name = ByteArray::fromRawData(fileName.c_str(), fileName.size());
+    const FileHeader* header = nullptr;
+    for (const FileHeader& h : fileHeaders) {
+        if (h.file_name == name) {
+            header = &h;
             break;
         }
     }
 
-    if (i == p->fileHeaders.size()) {
+    if (!header) {
         return ByteArray();
     }
 
-    FileHeader header = p->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
+    ushort version_needed = readUShort(header->h.version_needed);
     if (version_needed > ZIP_VERSION) {
         LOGW("Zip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
         return ByteArray();
     }
 
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-
-    p->device->seek(start);
-    LocalFileHeader lh;
-    p->device->read((uint8_t*)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    p->device->seek(p->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
+    ushort general_purpose_bits = readUShort(header->h.general_purpose_bits);
+    size_t compressed_size = readUInt(header->h.compressed_size);
+    int uncompressed_size = readUInt(header->h.uncompressed_size);
+    size_t start = readUInt(header->h.offset_local_header);
 
     if ((general_purpose_bits & Encrypted) != 0) {
         LOGW("Zip: Unsupported encryption method is needed to extract the data.");
         return ByteArray();
     }
 
-    ByteArray compressed = p->device->read(compressed_size);
+    //! NOTE All our devices are memory backed (a buffer or a mapped file),
+    //! so the entry is read in place, without copying the compressed data
+    const uint8_t* base = device->readData();
+    const size_t deviceSize = device->size();
+    if (!base || start + sizeof(LocalFileHeader) > deviceSize) {
+        LOGW("Zip: local header is out of range");
+        return ByteArray();
+    }
+
+    LocalFileHeader lh;
+    std::memcpy(&lh, base + start, sizeof(LocalFileHeader));
+    size_t dataStart = start + sizeof(LocalFileHeader) + readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+    if (dataStart > deviceSize) {
+        LOGW("Zip: entry data is out of range");
+        return ByteArray();
+    }
+
+    compressed_size = std::min(compressed_size, deviceSize - dataStart);
+    const uint8_t* compressed = base + dataStart;
+
+    int compression_method = readUShort(lh.compression_method);
     if (compression_method == CompressionMethodStored) {
         // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
+        size_t size = std::min(compressed_size, static_cast<size_t>(uncompressed_size));
+        if (allowView) {
+            return ByteArray::fromRawData(compressed, size);
+        }
+        return ByteArray(compressed, size);
     } else if (compression_method == CompressionMethodDeflated) {
         // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
         ByteArray baunzip;
         ulong len = std::max(uncompressed_size,  1);
         int res;
         do {
             baunzip.resize(len);
-            res = inflate((uint8_t*)baunzip.data(), &len,
-                          (const uint8_t*)compressed.constData(), compressed_size);
+            res = inflate((uint8_t*)baunzip.data(), &len, compressed, (ulong)compressed_size);
 
             switch (res) {
             case Z_OK:
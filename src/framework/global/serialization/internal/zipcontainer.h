@@ -63,6 +63,9 @@ public:
     int count() const;
 
     ByteArray fileData(const std::string& fileName) const;
+    //! NOTE Stored (not compressed) entries are not copied,
+    //! the result refers to the device data and is valid while the device is alive
+    ByteArray fileDataView(const std::string& fileName) const;
 
     // Write
     enum CompressionPolicy {
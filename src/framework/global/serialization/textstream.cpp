@@ -20,6 +20,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "textstream.h"
+
+#include <charconv>
+#include <cstring>
 #include <sstream>
 
 using namespace mu;
@@ -57,57 +60,52 @@ TextStream& TextStream::operator<<(char ch)
 
 TextStream& TextStream::operator<<(int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(unsigned int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(double val)
 {
+#if defined(__cpp_lib_to_chars)
+    //! NOTE Same as the default formatting of std::ostream (%g with precision 6)
+    char buf[32];
+    std::to_chars_result res = std::to_chars(buf, buf + sizeof(buf), val, std::chars_format::general, 6);
+    write(buf, res.ptr - buf);
+#else
     std::stringstream ss;
     ss << val;
     write(ss.str().c_str(), ss.str().size());
+#endif
     return *this;
 }
 
 TextStream& TextStream::operator<<(signed long int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(unsigned long int val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(signed long long val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
 TextStream& TextStream::operator<<(unsigned long long val)
 {
-    std::stringstream ss;
-    ss << val;
-    write(ss.str().c_str(), ss.str().size());
+    writeInteger(val);
     return *this;
 }
 
@@ -152,8 +150,20 @@ TextStream& TextStream::operator<<(const String& s)
     return *this;
 }
 
+template<typename T>
+void TextStream::writeInteger(T val)
+{
+    char buf[24];
+    std::to_chars_result res = std::to_chars(buf, buf + sizeof(buf), val);
+    write(buf, res.ptr - buf);
+}
+
 void TextStream::write(const char* ch, size_t len)
 {
+    if (m_buf.empty()) {
+        m_buf.reserve(TEXTSTREAM_BUFFERSIZE + 1);
+    }
+
     m_buf.push_back(reinterpret_cast<const uint8_t*>(ch), len);
     if (m_device && m_buf.size() > TEXTSTREAM_BUFFERSIZE) {
         flush();
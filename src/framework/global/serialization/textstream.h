@@ -60,8 +60,12 @@ public:
     TextStream& operator<<(const QString& s);
 #endif
 
-private:
     void write(const char* ch, size_t len);
+
+private:
+    template<typename T>
+    void writeInteger(T val);
+
     io::IODevice* m_device = nullptr;
     ByteArray m_buf;
 };
@@ -21,6 +21,9 @@
  */
 #include "xmlstreamwriter.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "containers.h"
 #include "textstream.h"
 
@@ -28,19 +31,93 @@
 
 using namespace mu;
 
+static constexpr size_t MAX_INDENT = 64;
+
 struct XmlStreamWriter::Impl {
-    std::list<std::string> stack;
+    std::vector<std::string> stack;
     TextStream stream;
 
     void putLevel()
     {
-        size_t level = stack.size();
-        for (size_t i = 0; i < level * 2; ++i) {
-            stream << ' ';
+        static const std::string spaces(MAX_INDENT, ' ');
+
+        size_t count = stack.size() * 2;
+        while (count > 0) {
+            size_t n = std::min(count, MAX_INDENT);
+            stream.write(spaces.c_str(), n);
+            count -= n;
         }
     }
 };
 
+//! NOTE Most of the written values are ascii tokens and numbers, which don't need to be escaped,
+//! so at first they are checked 8 bytes at once, and only then are escaped char by char
+static inline bool isXmlSafe(char16_t c)
+{
+    switch (c) {
+    case u'<':
+    case u'>':
+    case u'&':
+    case u'\"':
+        return false;
+    default:
+        return c >= 0x0020 || c == 0x0009 || c == 0x000A || c == 0x000D;
+    }
+}
+
+static inline uint64_t hasByteLess(uint64_t x, uint8_t n)
+{
+    return (x - 0x0101010101010101ULL * n) & ~x & 0x8080808080808080ULL;
+}
+
+static inline uint64_t hasByte(uint64_t x, uint8_t n)
+{
+    return hasByteLess(x ^ (0x0101010101010101ULL * n), 1);
+}
+
+static bool needsXmlEscaping(const char* str, size_t len)
+{
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t chunk;
+        std::memcpy(&chunk, str + i, sizeof(uint64_t));
+
+        // bytes >= 0x80 (utf8 sequences) are safe, but they confuse the check below, so just check them one by one
+        if (!(chunk & 0x8080808080808080ULL)
+            && !hasByteLess(chunk, 0x20)
+            && !hasByte(chunk, '<')
+            && !hasByte(chunk, '>')
+            && !hasByte(chunk, '&')
+            && !hasByte(chunk, '\"')) {
+            continue;
+        }
+
+        for (size_t j = i; j < i + sizeof(uint64_t); ++j) {
+            if (!isXmlSafe(static_cast<unsigned char>(str[j]))) {
+                return true;
+            }
+        }
+    }
+
+    for (; i < len; ++i) {
+        if (!isXmlSafe(static_cast<unsigned char>(str[i]))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool needsXmlEscaping(const String& str)
+{
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (!isXmlSafe(str.at(i).unicode())) {
+            return true;
+        }
+    }
+    return false;
+}
+
 XmlStreamWriter::XmlStreamWriter()
 {
     m_impl = new Impl();
@@ -114,11 +191,11 @@ void XmlStreamWriter::writeValue(const Value& v)
         break;
     case 7: m_impl->stream << std::get<double>(v);
         break;
-    case 8: m_impl->stream << escapeString(AsciiStringView(std::get<const char*>(v)));
+    case 8: writeEscaped(AsciiStringView(std::get<const char*>(v)));
         break;
-    case 9: m_impl->stream << escapeString(std::get<AsciiStringView>(v));
+    case 9: writeEscaped(std::get<AsciiStringView>(v));
         break;
-    case 10: m_impl->stream << escapeString(std::get<String>(v));
+    case 10: writeEscaped(std::get<String>(v));
         break;
     default:
         LOGI() << "index: " << v.index();
@@ -127,6 +204,59 @@ void XmlStreamWriter::writeValue(const Value& v)
     }
 }
 
+void XmlStreamWriter::writeEscaped(const AsciiStringView& s)
+{
+    if (!needsXmlEscaping(s.ascii(), s.size())) {
+        m_impl->stream << s;
+        return;
+    }
+
+    m_impl->stream << escapeString(s);
+}
+
+void XmlStreamWriter::writeEscaped(const String& s)
+{
+    if (!needsXmlEscaping(s)) {
+        m_impl->stream << s;
+        return;
+    }
+
+    m_impl->stream << escapeString(s);
+}
+
+void XmlStreamWriter::writeInteger(const AsciiStringView& name, long long body)
+{
+    IF_ASSERT_FAILED(!name.contains(' ')) {
+    }
+
+    m_impl->putLevel();
+    m_impl->stream << '<' << name << '>';
+    m_impl->stream << body;
+    m_impl->stream << "</" << name << '>' << '\n';
+}
+
+void XmlStreamWriter::writeUnsignedInteger(const AsciiStringView& name, unsigned long long body)
+{
+    IF_ASSERT_FAILED(!name.contains(' ')) {
+    }
+
+    m_impl->putLevel();
+    m_impl->stream << '<' << name << '>';
+    m_impl->stream << body;
+    m_impl->stream << "</" << name << '>' << '\n';
+}
+
+void XmlStreamWriter::writeDouble(const AsciiStringView& name, double body)
+{
+    IF_ASSERT_FAILED(!name.contains(' ')) {
+    }
+
+    m_impl->putLevel();
+    m_impl->stream << '<' << name << '>';
+    m_impl->stream << body;
+    m_impl->stream << "</" << name << '>' << '\n';
+}
+
 void XmlStreamWriter::startElement(const AsciiStringView& name, const Attributes& attrs)
 {
     IF_ASSERT_FAILED(!name.contains(' ')) {
@@ -160,7 +290,11 @@ void XmlStreamWriter::endElement()
 {
     m_impl->putLevel();
     m_impl->stream << "</" << mu::takeLast(m_impl->stack) << '>' << '\n';
-    flush();
+
+    //! NOTE The stream has its own buffer, so flush only when the document is completed
+    if (m_impl->stack.empty()) {
+        flush();
+    }
 }
 
 // <element attr="value" />
@@ -23,6 +23,7 @@
 #define MU_GLOBAL_XMLSTREAMWRITER_H
 
 #include <list>
+#include <type_traits>
 #include <variant>
 
 #include "types/string.h"
@@ -59,6 +60,16 @@ public:
     void element(const AsciiStringView& name, const Value& body);                           // <element>body</element>
     void element(const AsciiStringView& name, const Attributes& attrs, const Value& body);  // <element attr="value" >body</element>
 
+    //! NOTE Numbers are written directly, without Value
+    template<typename T, std::enable_if_t<std::is_integral_v<T> && std::is_signed_v<T>, int> = 0>
+    void element(const AsciiStringView& name, T body) { writeInteger(name, static_cast<long long>(body)); }
+
+    template<typename T, std::enable_if_t<std::is_integral_v<T> && std::is_unsigned_v<T>, int> = 0>
+    void element(const AsciiStringView& name, T body) { writeUnsignedInteger(name, static_cast<unsigned long long>(body)); }
+
+    template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    void element(const AsciiStringView& name, T body) { writeDouble(name, static_cast<double>(body)); }
+
     void comment(const String& text);
 
     static String escapeSymbol(char16_t c);
@@ -73,6 +84,12 @@ protected:
 private:
 
     void writeValue(const Value& v);
+    void writeEscaped(const AsciiStringView& s);
+    void writeEscaped(const String& s);
+
+    void writeInteger(const AsciiStringView& name, long long body);
+    void writeUnsignedInteger(const AsciiStringView& name, unsigned long long body);
+    void writeDouble(const AsciiStringView& name, double body);
 
     struct Impl;
     Impl* m_impl = nullptr;
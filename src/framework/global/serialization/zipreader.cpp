@@ -23,6 +23,7 @@
 
 #include "internal/zipcontainer.h"
 #include "io/file.h"
+#include "io/mappedfile.h"
 
 using namespace mu;
 using namespace mu::io;
@@ -38,7 +39,7 @@ ZipReader::ZipReader(const io::path_t& filePath)
     : m_filePath(filePath)
 {
     m_impl = new Impl();
-    m_impl->device = new File(filePath);
+    m_impl->device = new MappedFile(filePath);
     m_impl->isSelfDevice = true;
     if (m_impl->device->open(IODevice::ReadOnly)) {
     }
@@ -100,3 +101,8 @@ ByteArray ZipReader::fileData(const std::string& fileName) const
 {
     return m_impl->zip->fileData(fileName);
 }
+
+ByteArray ZipReader::fileDataView(const std::string& fileName) const
+{
+    return m_impl->zip->fileDataView(fileName);
+}
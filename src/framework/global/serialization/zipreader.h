@@ -53,6 +53,9 @@ public:
 
     std::vector<FileInfo> fileInfoList() const;
     ByteArray fileData(const std::string& fileName) const;
+    //! NOTE Stored (not compressed) entries are not copied,
+    //! the result is valid while the reader (or the given device) is alive
+    ByteArray fileDataView(const std::string& fileName) const;
 
 private:
     struct Impl;
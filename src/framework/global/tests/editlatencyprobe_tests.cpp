@@ -0,0 +1,232 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "editlatencyprobe.h"
+
+using namespace mu;
+
+static constexpr int64_t MS = 1000000;
+
+class Global_EditLatencyProbeTests : public ::testing::Test
+{
+public:
+
+    void SetUp() override
+    {
+        probe()->setEnabled(true);
+        probe()->setWindowSize(EditLatencyProbe::DEFAULT_WINDOW_SIZE);
+        probe()->clear();
+    }
+
+    void TearDown() override
+    {
+        probe()->setEnabled(false);
+    }
+
+    EditLatencyProbe* probe() const
+    {
+        return EditLatencyProbe::instance();
+    }
+
+    //! NOTE Like the actions dispatcher, the undo stack and the paint view do it
+    void dispatchEdit(const std::string& action, int64_t layoutNs)
+    {
+        probe()->beginAction(action);
+        probe()->beginEdit();
+        probe()->addPhaseTime(EditLatencyProbe::Phase::EndCmd, layoutNs);
+        probe()->addPhaseTime(EditLatencyProbe::Phase::Layout, layoutNs);
+        probe()->endEdit(false);
+        probe()->leaveAction();
+        probe()->repainted(1 * MS);
+    }
+
+    const EditLatencyProbe::ActionStats* findStats(const std::vector<EditLatencyProbe::ActionStats>& stats, const std::string& action)
+    {
+        for (const EditLatencyProbe::ActionStats& s : stats) {
+            if (s.action == action) {
+                return &s;
+            }
+        }
+
+        return nullptr;
+    }
+};
+
+TEST_F(Global_EditLatencyProbeTests, DispatchedEdit)
+{
+    //! DO
+    dispatchEdit("note-c", 2 * MS);
+
+    //! CHECK
+    std::vector<EditLatencyProbe::ActionStats> stats = probe()->stats();
+    ASSERT_EQ(stats.size(), 2);
+    EXPECT_EQ(stats.at(0).action, "all");
+    EXPECT_EQ(stats.at(0).total.count, 1);
+
+    const EditLatencyProbe::ActionStats* noteC = findStats(stats, "note-c");
+    ASSERT_TRUE(noteC);
+    EXPECT_EQ(noteC->total.count, 1);
+    EXPECT_DOUBLE_EQ(noteC->phases[size_t(EditLatencyProbe::Phase::Layout)].p50, 2.0);
+    EXPECT_DOUBLE_EQ(noteC->phases[size_t(EditLatencyProbe::Phase::Repaint)].p50, 1.0);
+    EXPECT_GE(noteC->total.p50, noteC->phases[size_t(EditLatencyProbe::Phase::Command)].p50);
+}
+
+TEST_F(Global_EditLatencyProbeTests, NotRecorded)
+{
+    //! DO An action without edit
+    probe()->beginAction("zoom-in");
+    probe()->leaveAction();
+    probe()->repainted(1 * MS);
+
+    //! DO A rolled back edit
+    probe()->beginAction("note-c");
+    probe()->beginEdit();
+    probe()->endEdit(true);
+    probe()->leaveAction();
+    probe()->repainted(1 * MS);
+
+    //! DO An edit while disabled
+    probe()->setEnabled(false);
+    dispatchEdit("note-d", 1 * MS);
+
+    //! CHECK Only the summary, without samples
+    std::vector<EditLatencyProbe::ActionStats> stats = probe()->stats();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_EQ(stats.at(0).total.count, 0);
+}
+
+TEST_F(Global_EditLatencyProbeTests, EditWithoutAction)
+{
+    //! DO For example, dragging with the mouse
+    probe()->beginEdit();
+    probe()->endEdit(false);
+    probe()->repainted(1 * MS);
+
+    //! CHECK
+    std::vector<EditLatencyProbe::ActionStats> stats = probe()->stats();
+    const EditLatencyProbe::ActionStats* edit = findStats(stats, "edit");
+    ASSERT_TRUE(edit);
+    EXPECT_EQ(edit->total.count, 1);
+}
+
+TEST_F(Global_EditLatencyProbeTests, UndoWithoutEdit)
+{
+    //! DO Undo changes the score without starting an edit
+    probe()->beginAction("undo");
+    probe()->addPhaseTime(EditLatencyProbe::Phase::EndCmd, 3 * MS);
+    probe()->leaveAction();
+    probe()->repainted(1 * MS);
+
+    //! CHECK
+    std::vector<EditLatencyProbe::ActionStats> stats = probe()->stats();
+    const EditLatencyProbe::ActionStats* undo = findStats(stats, "undo");
+    ASSERT_TRUE(undo);
+    EXPECT_DOUBLE_EQ(undo->phases[size_t(EditLatencyProbe::Phase::EndCmd)].p50, 3.0);
+}
+
+TEST_F(Global_EditLatencyProbeTests, RepaintedOnRenderThread)
+{
+    //! GIVEN An applied edit
+    probe()->beginAction("note-c");
+    probe()->beginEdit();
+    probe()->endEdit(false);
+    probe()->leaveAction();
+
+    //! DO The notation is painted on another thread, like the threaded render loop of Qt Quick does
+    std::thread renderThread([this]() {
+        probe()->repainted(2 * MS);
+    });
+    renderThread.join();
+
+    //! CHECK
+    std::vector<EditLatencyProbe::ActionStats> stats = probe()->stats();
+    const EditLatencyProbe::ActionStats* noteC = findStats(stats, "note-c");
+    ASSERT_TRUE(noteC);
+    EXPECT_EQ(noteC->total.count, 1);
+    EXPECT_DOUBLE_EQ(noteC->phases[size_t(EditLatencyProbe::Phase::Repaint)].p50, 2.0);
+}
+
+TEST_F(Global_EditLatencyProbeTests, NotRepaintedEditFinishesWhenApplied)
+{
+    //! GIVEN An applied edit, that is not repainted
+    probe()->beginAction("note-c");
+    probe()->beginEdit();
+    probe()->endEdit(false);
+    probe()->leaveAction();
+
+    //! DO The next action starts much later
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    dispatchEdit("note-d", 1 * MS);
+
+    //! CHECK The idle time is not a part of the first edit
+    std::vector<EditLatencyProbe::ActionStats> stats = probe()->stats();
+    const EditLatencyProbe::ActionStats* noteC = findStats(stats, "note-c");
+    ASSERT_TRUE(noteC);
+    EXPECT_EQ(noteC->total.count, 1);
+    EXPECT_LT(noteC->total.max, 50.0);
+    EXPECT_DOUBLE_EQ(noteC->phases[size_t(EditLatencyProbe::Phase::Repaint)].max, 0.0);
+}
+
+TEST_F(Global_EditLatencyProbeTests, Percentiles)
+{
+    //! DO Layout takes 1..100 ms
+    for (int i = 100; i > 0; --i) {
+        dispatchEdit("note-c", i * MS);
+    }
+
+    //! CHECK
+    std::vector<EditLatencyProbe::ActionStats> stats = probe()->stats();
+    const EditLatencyProbe::ActionStats* noteC = findStats(stats, "note-c");
+    ASSERT_TRUE(noteC);
+
+    const EditLatencyProbe::Percentiles& layout = noteC->phases[size_t(EditLatencyProbe::Phase::Layout)];
+    EXPECT_EQ(layout.count, 100);
+    EXPECT_DOUBLE_EQ(layout.p50, 50.0);
+    EXPECT_DOUBLE_EQ(layout.p95, 95.0);
+    EXPECT_DOUBLE_EQ(layout.p99, 99.0);
+    EXPECT_DOUBLE_EQ(layout.max, 100.0);
+}
+
+TEST_F(Global_EditLatencyProbeTests, RollingWindow)
+{
+    //! GIVEN Only the last 10 samples are kept
+    probe()->setWindowSize(10);
+
+    //! DO Layout takes 1..30 ms
+    for (int i = 1; i <= 30; ++i) {
+        dispatchEdit("note-c", i * MS);
+    }
+
+    //! CHECK Only 21..30 ms are left
+    std::vector<EditLatencyProbe::ActionStats> stats = probe()->stats();
+    const EditLatencyProbe::ActionStats* noteC = findStats(stats, "note-c");
+    ASSERT_TRUE(noteC);
+
+    const EditLatencyProbe::Percentiles& layout = noteC->phases[size_t(EditLatencyProbe::Phase::Layout)];
+    EXPECT_EQ(layout.count, 10);
+    EXPECT_DOUBLE_EQ(layout.p50, 25.0);
+    EXPECT_DOUBLE_EQ(layout.max, 30.0);
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "io/file.h"
+#include "io/mappedfile.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_IO_MappedFileTests : public ::testing::Test
+{
+public:
+};
+
+static ByteArray makeData(const std::string& str)
+{
+    return ByteArray(reinterpret_cast<const uint8_t*>(str.c_str()), str.size());
+}
+
+TEST_F(Global_IO_MappedFileTests, ReadFile)
+{
+    //! GIVEN Some file
+    path_t filePath("MappedFileTests_Read.txt");
+    ByteArray ref = makeData("Hello World!");
+    ASSERT_TRUE(File::writeFile(filePath, ref));
+
+    {
+        MappedFile f(filePath);
+
+        //! DO Open file
+        EXPECT_TRUE(f.open(IODevice::ReadOnly));
+
+        //! CHECK
+#ifndef __EMSCRIPTEN__
+        EXPECT_TRUE(f.isMapped());
+#endif
+        EXPECT_EQ(f.size(), ref.size());
+        EXPECT_EQ(f.readAll(), ref);
+
+        //! DO Read again from the start
+        f.seek(0);
+
+        //! CHECK
+        EXPECT_EQ(f.read(5), makeData("Hello"));
+    }
+
+    File::remove(filePath);
+}
+
+TEST_F(Global_IO_MappedFileTests, ReadEmptyFile)
+{
+    //! GIVEN Empty file, it cannot be mapped
+    path_t filePath("MappedFileTests_Empty.txt");
+    ASSERT_TRUE(File::writeFile(filePath, ByteArray()));
+
+    {
+        MappedFile f(filePath);
+
+        //! DO Open file
+        EXPECT_TRUE(f.open(IODevice::ReadOnly));
+
+        //! CHECK It is read as usual
+        EXPECT_FALSE(f.isMapped());
+        EXPECT_EQ(f.size(), 0);
+        EXPECT_TRUE(f.readAll().empty());
+    }
+
+    File::remove(filePath);
+}
+
+TEST_F(Global_IO_MappedFileTests, NotExistingFile)
+{
+    //! GIVEN Not existing file
+    MappedFile f("MappedFileTests_NotExisting.txt");
+
+    //! CHECK
+    EXPECT_FALSE(f.exists());
+    EXPECT_FALSE(f.open(IODevice::ReadOnly));
+    EXPECT_FALSE(f.isMapped());
+}
+
+TEST_F(Global_IO_MappedFileTests, WriteNotSupported)
+{
+    //! GIVEN Some file
+    path_t filePath("MappedFileTests_Write.txt");
+    ByteArray ref = makeData("Hello World!");
+    ASSERT_TRUE(File::writeFile(filePath, ref));
+
+    {
+        MappedFile f(filePath);
+
+        //! CHECK Only read mode is supported
+        EXPECT_FALSE(f.open(IODevice::WriteOnly));
+        EXPECT_FALSE(f.open(IODevice::ReadWrite));
+        EXPECT_FALSE(f.open(IODevice::Append));
+        EXPECT_FALSE(f.isMapped());
+    }
+
+    //! CHECK The file is not changed
+    File f(filePath);
+    EXPECT_TRUE(f.open(IODevice::ReadOnly));
+    EXPECT_EQ(f.readAll(), ref);
+    f.close();
+
+    File::remove(filePath);
+}
@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "memoryaccounting.h"
+#include "serialization/json.h"
+#include "types/bytearray.h"
+
+using namespace mu;
+
+class Global_MemoryAccountingTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_MemoryAccountingTests, Scope_SetsAndRestoresTag)
+{
+    //! CHECK Nothing is tagged by default
+    EXPECT_EQ(MemoryAccounting::currentTag(), MemoryTag::Untagged);
+
+    {
+        //! DO Nested scopes
+        MemoryTagScope layout(MemoryTag::Layout);
+        EXPECT_EQ(MemoryAccounting::currentTag(), MemoryTag::Layout);
+
+        {
+            MemoryTagScope undo(MemoryTag::Undo);
+            EXPECT_EQ(MemoryAccounting::currentTag(), MemoryTag::Undo);
+        }
+
+        //! CHECK The outer tag is restored
+        EXPECT_EQ(MemoryAccounting::currentTag(), MemoryTag::Layout);
+    }
+
+    EXPECT_EQ(MemoryAccounting::currentTag(), MemoryTag::Untagged);
+}
+
+TEST_F(Global_MemoryAccountingTests, Counters_LivePeakAndCounts)
+{
+    MemoryAccounting::Snapshot before = MemoryAccounting::snapshot();
+    const MemoryAccounting::TagStats& b = before.tags[static_cast<size_t>(MemoryTag::Import)];
+
+    //! DO Allocate 100 + 50 bytes, then free 100
+    MemoryAccounting::addAllocation(MemoryTag::Import, 100);
+    MemoryAccounting::addAllocation(MemoryTag::Import, 50);
+    MemoryAccounting::addDeallocation(MemoryTag::Import, 100);
+
+    //! CHECK
+    MemoryAccounting::Snapshot after = MemoryAccounting::snapshot();
+    const MemoryAccounting::TagStats& a = after.tags[static_cast<size_t>(MemoryTag::Import)];
+
+    EXPECT_EQ(a.tag, MemoryTag::Import);
+    EXPECT_EQ(a.liveBytes - b.liveBytes, 50);
+    EXPECT_GE(a.peakBytes, b.liveBytes + 150);
+    EXPECT_EQ(a.allocatedBytes - b.allocatedBytes, 150);
+    EXPECT_EQ(a.allocationCount - b.allocationCount, 2);
+    EXPECT_EQ(a.deallocationCount - b.deallocationCount, 1);
+
+    //! DO Reset peaks
+    MemoryAccounting::resetPeaks();
+
+    //! CHECK The peak drops to the live bytes
+    MemoryAccounting::Snapshot reset = MemoryAccounting::snapshot();
+    const MemoryAccounting::TagStats& r = reset.tags[static_cast<size_t>(MemoryTag::Import)];
+    EXPECT_EQ(r.peakBytes, r.liveBytes);
+
+    MemoryAccounting::addDeallocation(MemoryTag::Import, 50);
+}
+
+TEST_F(Global_MemoryAccountingTests, Rates)
+{
+    MemoryAccounting::TagStats previous;
+    previous.allocationCount = 100;
+    previous.allocatedBytes = 1000;
+
+    MemoryAccounting::TagStats current;
+    current.allocationCount = 300;
+    current.allocatedBytes = 5000;
+
+    //! CHECK Over two seconds
+    MemoryAccounting::Rates rates = MemoryAccounting::rates(current, previous, 2000);
+    EXPECT_DOUBLE_EQ(rates.allocationsPerSec, 100.0);
+    EXPECT_DOUBLE_EQ(rates.bytesPerSec, 2000.0);
+
+    //! CHECK No time elapsed
+    rates = MemoryAccounting::rates(current, previous, 0);
+    EXPECT_DOUBLE_EQ(rates.allocationsPerSec, 0.0);
+    EXPECT_DOUBLE_EQ(rates.bytesPerSec, 0.0);
+}
+
+TEST_F(Global_MemoryAccountingTests, JsonReport)
+{
+    //! DO
+    ByteArray data = MemoryAccounting::jsonReport(MemoryAccounting::snapshot());
+
+    //! CHECK
+    std::string err;
+    JsonObject root = JsonDocument::fromJson(data, &err).rootObject();
+    EXPECT_TRUE(err.empty());
+    EXPECT_EQ(root.value("enabled").toBool(), MemoryAccounting::enabled());
+
+    JsonArray tags = root.value("tags").toArray();
+    ASSERT_EQ(tags.size(), MemoryAccounting::TAG_COUNT);
+    EXPECT_EQ(tags.at(static_cast<size_t>(MemoryTag::Layout)).toObject().value("tag").toStdString(), "layout");
+    EXPECT_TRUE(root.value("total").toObject().contains("liveBytes"));
+}
+
+#ifdef MEMORY_ACCOUNTING_ENABLED
+TEST_F(Global_MemoryAccountingTests, OperatorNew_ChargedToCurrentTag)
+{
+    MemoryAccounting::Snapshot before = MemoryAccounting::snapshot();
+
+    //! DO Allocate under the playback tag, free outside of it
+    std::vector<char>* buffer = nullptr;
+    {
+        MEMORY_TAG_SCOPE(Playback);
+        buffer = new std::vector<char>(4096 - sizeof(std::vector<char>));
+    }
+
+    MemoryAccounting::Snapshot allocated = MemoryAccounting::snapshot();
+    EXPECT_EQ(buffer->size(), 4096 - sizeof(std::vector<char>));
+    delete buffer;
+    MemoryAccounting::Snapshot freed = MemoryAccounting::snapshot();
+
+    //! CHECK
+    const size_t playback = static_cast<size_t>(MemoryTag::Playback);
+    EXPECT_EQ(allocated.tags[playback].liveBytes - before.tags[playback].liveBytes, 4096);
+    EXPECT_EQ(freed.tags[playback].liveBytes, before.tags[playback].liveBytes);
+    EXPECT_EQ(freed.tags[playback].deallocationCount - before.tags[playback].deallocationCount, 2);
+}
+#endif
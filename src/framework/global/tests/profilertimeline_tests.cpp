@@ -0,0 +1,169 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "thirdparty/haw_profiler/src/profiler.h"
+
+using namespace haw::profiler;
+
+class Global_ProfilerTimelineTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_options = Profiler::options();
+
+        Profiler::Options options = m_options;
+        options.timelineEnabled = true;
+        options.timelineEventsPerThread = 5; // rounded up to 8
+        Profiler::instance()->setup(options);
+        Profiler::instance()->clearTimeline();
+    }
+
+    void TearDown() override
+    {
+        Profiler::instance()->setup(m_options);
+        Profiler::instance()->clearTimeline();
+    }
+
+    //! NOTE The timeline keeps pointers to the names, so they are all created once and never move
+    static const std::string& eventName(size_t i)
+    {
+        static const std::vector<std::string> names = []() {
+            std::vector<std::string> result;
+            for (size_t n = 0; n < 100; ++n) {
+                result.push_back("event" + std::to_string(n));
+            }
+            return result;
+        }();
+        return names.at(i);
+    }
+
+    static void addEvents(size_t from, size_t to)
+    {
+        for (size_t i = from; i < to; ++i) {
+            Profiler::instance()->addTimelineEvent(eventName(i), static_cast<int64_t>(i) * 1000, static_cast<int64_t>(i) * 1000 + 500);
+        }
+    }
+
+    static bool hasEvent(const std::string& trace, size_t i)
+    {
+        return trace.find("\"name\":\"" + eventName(i) + "\",") != std::string::npos;
+    }
+
+    static bool hasThread(const std::string& trace, const std::string& name)
+    {
+        return trace.find("\"args\":{\"name\":\"" + name + "\"}") != std::string::npos;
+    }
+
+private:
+    Profiler::Options m_options;
+};
+
+TEST_F(Global_ProfilerTimelineTests, Ring_KeepsNewestEvents)
+{
+    //! DO A thread writes more events than its ring holds
+    std::thread th([]() {
+        Profiler::instance()->setThreadName("ring_test");
+        addEvents(0, 20);
+    });
+    th.join();
+
+    //! CHECK The thread has finished, so the newest 8 events are all intact, the older ones were overwritten
+    std::string trace = Profiler::instance()->timelineToChromeTrace();
+    EXPECT_TRUE(hasThread(trace, "ring_test"));
+
+    for (size_t i = 0; i < 12; ++i) {
+        EXPECT_FALSE(hasEvent(trace, i)) << i;
+    }
+    for (size_t i = 12; i < 20; ++i) {
+        EXPECT_TRUE(hasEvent(trace, i)) << i;
+    }
+}
+
+TEST_F(Global_ProfilerTimelineTests, Ring_DropsEventMaybeOverwrittenByRunningThread)
+{
+    //! DO This thread, which keeps running, writes more events than its ring holds
+    Profiler::instance()->clearTimeline();
+    addEvents(50, 70);
+
+    //! CHECK The oldest event of the ring is dropped too, the thread could be overwriting it while the trace is made
+    std::string trace = Profiler::instance()->timelineToChromeTrace();
+    for (size_t i = 50; i < 63; ++i) {
+        EXPECT_FALSE(hasEvent(trace, i)) << i;
+    }
+    for (size_t i = 63; i < 70; ++i) {
+        EXPECT_TRUE(hasEvent(trace, i)) << i;
+    }
+}
+
+TEST_F(Global_ProfilerTimelineTests, Clear_DropsEventsOfRunningThread)
+{
+    //! [GIVEN] This thread has written events
+    addEvents(30, 34);
+    std::string trace = Profiler::instance()->timelineToChromeTrace();
+    EXPECT_TRUE(hasEvent(trace, 33));
+
+    //! DO Clear the timeline and write one more event
+    Profiler::instance()->clearTimeline();
+    addEvents(34, 35);
+
+    //! CHECK Only the event written after the clear is in the trace
+    trace = Profiler::instance()->timelineToChromeTrace();
+    for (size_t i = 30; i < 34; ++i) {
+        EXPECT_FALSE(hasEvent(trace, i)) << i;
+    }
+    EXPECT_TRUE(hasEvent(trace, 34));
+}
+
+TEST_F(Global_ProfilerTimelineTests, Clear_FreesTimelinesOfFinishedThreads)
+{
+    //! [GIVEN] A finished thread that has written events
+    std::thread th([]() {
+        Profiler::instance()->setThreadName("finished_test");
+        addEvents(40, 41);
+    });
+    th.join();
+    EXPECT_TRUE(hasThread(Profiler::instance()->timelineToChromeTrace(), "finished_test"));
+
+    //! DO Clear the timeline
+    Profiler::instance()->clearTimeline();
+
+    //! CHECK The timeline of the finished thread is gone
+    EXPECT_FALSE(hasThread(Profiler::instance()->timelineToChromeTrace(), "finished_test"));
+}
+
+TEST_F(Global_ProfilerTimelineTests, ThreadName_DoesNotCreateTimeline)
+{
+    //! DO A thread only sets its name
+    std::thread th([]() {
+        Profiler::instance()->setThreadName("named_test");
+    });
+    th.join();
+
+    //! CHECK It has no timeline
+    EXPECT_FALSE(hasThread(Profiler::instance()->timelineToChromeTrace(), "named_test"));
+}
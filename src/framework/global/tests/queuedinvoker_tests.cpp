@@ -0,0 +1,187 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "thirdparty/deto_async/async/internal/queuedinvoker.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace deto::async;
+
+class Global_Async_QueuedInvokerTests : public ::testing::Test
+{
+public:
+    //! processes the calls queued for the worker until stopped
+    class Worker
+    {
+    public:
+        Worker()
+        {
+            m_thread = std::thread([this]() {
+                while (!m_stop) {
+                    QueuedInvoker::instance()->processEvents();
+                    std::this_thread::yield();
+                }
+                QueuedInvoker::instance()->processEvents();
+            });
+        }
+
+        ~Worker()
+        {
+            m_stop = true;
+            m_thread.join();
+        }
+
+        std::thread::id id() const { return m_thread.get_id(); }
+
+    private:
+        std::atomic<bool> m_stop = false;
+        std::thread m_thread;
+    };
+};
+
+TEST_F(Global_Async_QueuedInvokerTests, InlineFunctor)
+{
+    // [GIVEN] A small and a big functor
+    int calls = 0;
+    auto small = [&calls]() { ++calls; };
+    std::array<char, 256> big {};
+    big[0] = 1;
+    auto large = [&calls, big]() { calls += big[0]; };
+
+    // [WHEN] Both are stored, moved and called
+    InlineFunctor f1(small);
+    InlineFunctor f2(large);
+    InlineFunctor f3(std::move(f1));
+    f2 = std::move(f3);
+
+    // [THEN] The functors are moved with their state
+    EXPECT_FALSE(f1);
+    EXPECT_FALSE(f3);
+    ASSERT_TRUE(f2);
+    f2();
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(Global_Async_QueuedInvokerTests, KeepsOrder)
+{
+    // [GIVEN] More calls than fit into the ring of a thread pair
+    constexpr int count = 5000;
+    std::vector<int> received;
+    received.reserve(count);
+    std::atomic<int> receivedCount = 0;
+    std::atomic<int> done = 0;
+
+    {
+        Worker worker;
+
+        // [WHEN] They are queued from two producers
+        std::thread other([&worker, &done]() {
+            for (int i = 0; i < count; ++i) {
+                QueuedInvoker::instance()->invoke(worker.id(), [&done]() { ++done; });
+            }
+        });
+
+        for (int i = 0; i < count; ++i) {
+            QueuedInvoker::instance()->invoke(worker.id(), [&received, &receivedCount, i]() {
+                received.push_back(i);
+                ++receivedCount;
+            });
+        }
+
+        other.join();
+
+        while (receivedCount < count || done < count) {
+            std::this_thread::yield();
+        }
+    }
+
+    // [THEN] Every call is made once, in the order of its producer
+    EXPECT_EQ(done, count);
+    ASSERT_EQ(received.size(), size_t(count));
+    EXPECT_TRUE(std::is_sorted(received.begin(), received.end()));
+    EXPECT_EQ(received.back(), count - 1);
+}
+
+TEST_F(Global_Async_QueuedInvokerTests, OnQueued)
+{
+    // [GIVEN] A thread that is notified about queued calls
+    std::thread::id th;
+    std::thread dummy([&th]() { th = std::this_thread::get_id(); });
+    dummy.join();
+
+    int notified = 0;
+    QueuedInvoker::instance()->onQueued(th, [&notified]() { ++notified; });
+
+    // [WHEN] Calls are queued for it
+    QueuedInvoker::instance()->invoke(th, []() {});
+    QueuedInvoker::instance()->invoke(th, []() {});
+
+    // [THEN] It is notified for each of them
+    EXPECT_EQ(notified, 2);
+
+    QueuedInvoker::instance()->onQueued(th, nullptr);
+    QueuedInvoker::instance()->invoke(th, []() {});
+    EXPECT_EQ(notified, 2);
+}
+
+TEST_F(Global_Async_QueuedInvokerTests, DISABLED_MessageLatency)
+{
+    // [GIVEN] A worker thread, like the audio worker
+    constexpr int count = 10000;
+    Worker worker;
+    std::thread::id mainId = std::this_thread::get_id();
+
+    std::vector<double> latencies;
+    latencies.reserve(count);
+
+    // [WHEN] Calls go to the worker and back
+    for (int i = 0; i < count; ++i) {
+        std::atomic<bool> answered = false;
+        auto start = std::chrono::steady_clock::now();
+
+        QueuedInvoker::instance()->invoke(worker.id(), [mainId, &answered]() {
+            QueuedInvoker::instance()->invoke(mainId, [&answered]() { answered = true; });
+        });
+
+        while (!answered) {
+            QueuedInvoker::instance()->processEvents();
+            std::this_thread::yield();
+        }
+
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    // [THEN] Print the round trip times
+    std::sort(latencies.begin(), latencies.end());
+    LOGI() << "round trip us, median: " << latencies[count / 2]
+           << ", p99: " << latencies[count * 99 / 100]
+           << ", max: " << latencies.back();
+}
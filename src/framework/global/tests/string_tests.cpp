@@ -895,3 +895,39 @@ TEST_F(Global_Types_StringTests, String_Remove)
     //! CHECK
     EXPECT_EQ(s, "13abc");
 }
+
+TEST_F(Global_Types_StringTests, String_Utf8RoundTrip)
+{
+    {
+        //! GIVEN Long ascii string
+        const std::string ascii = "<Articulation>staccato</Articulation>";
+        //! DO
+        String str = String::fromUtf8(ascii.c_str());
+        //! CHECK
+        EXPECT_EQ(str, String(u"<Articulation>staccato</Articulation>"));
+        EXPECT_EQ(str.toUtf8().size(), ascii.size());
+        EXPECT_EQ(str.toStdString(), ascii);
+    }
+
+    {
+        //! GIVEN String with ascii prefix and non ascii tail
+        const std::string utf8 = "Allegro non troppo — ♩ = 120";
+        //! DO
+        String str = String::fromUtf8(utf8.c_str());
+        //! CHECK
+        EXPECT_EQ(str, String(u"Allegro non troppo — ♩ = 120"));
+        EXPECT_EQ(str.toUtf8().size(), utf8.size());
+        EXPECT_EQ(str.toStdString(), utf8);
+    }
+
+    {
+        //! GIVEN Empty strings
+        String str1;
+        String str2 = str1;
+        //! DO
+        str2.append(u'a');
+        //! CHECK
+        EXPECT_TRUE(str1.empty());
+        EXPECT_EQ(str2, String(u"a"));
+    }
+}
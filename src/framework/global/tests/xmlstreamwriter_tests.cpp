@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "io/buffer.h"
+#include "serialization/xmlstreamwriter.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_Ser_XmlStreamWriterTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_Ser_XmlStreamWriterTests, WriteElements)
+{
+    //! GIVEN Writer to buffer
+    Buffer buf;
+    buf.open(IODevice::WriteOnly);
+
+    {
+        XmlStreamWriter xml(&buf);
+
+        //! DO Write typed and escaped values
+        xml.startElement("root", { { "version", "4.00" } });
+        xml.element("int", 42);
+        xml.element("negative", -7L);
+        xml.element("unsigned", 3000000000U);
+        xml.element("bool", true);
+        xml.element("real", 0.125);
+        xml.element("realRounded", 1.0 / 3.0);
+        xml.element("value", XmlStreamWriter::Value(12));
+        xml.element("ascii", AsciiStringView("staccatissimoAbove"));
+        xml.element("escaped", AsciiStringView("a < b && c > \"d\""));
+        xml.element("text", String(u"Allegro — ♩ = 120"));
+        xml.element("textEscaped", String(u"<sym>\u0001"));
+        xml.element("point", { { "x", 1.5 }, { "y", -2 } });
+        xml.endElement();
+    }
+
+    //! CHECK
+    const std::string expected
+        = "<root version=\"4.00\">\n"
+          "  <int>42</int>\n"
+          "  <negative>-7</negative>\n"
+          "  <unsigned>3000000000</unsigned>\n"
+          "  <bool>1</bool>\n"
+          "  <real>0.125</real>\n"
+          "  <realRounded>0.333333</realRounded>\n"
+          "  <value>12</value>\n"
+          "  <ascii>staccatissimoAbove</ascii>\n"
+          "  <escaped>a &lt; b &amp;&amp; c &gt; &quot;d&quot;</escaped>\n"
+          "  <text>Allegro — ♩ = 120</text>\n"
+          "  <textEscaped>&lt;sym&gt;</textEscaped>\n"
+          "  <point x=\"1.5\" y=\"-2\"/>\n"
+          "  </root>\n";
+
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(buf.data().constData()), buf.data().size()), expected);
+}
@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "io/buffer.h"
+#include "io/file.h"
+#include "io/mappedfile.h"
+#include "serialization/zipreader.h"
+#include "serialization/internal/zipcontainer.h"
+#include "serialization/zipwriter.h"
+
+using namespace mu;
+using namespace mu::io;
+
+class Global_Ser_ZipReaderTests : public ::testing::Test
+{
+public:
+};
+
+static ByteArray makeData(const std::string& str, size_t repeat)
+{
+    ByteArray data;
+    for (size_t i = 0; i < repeat; ++i) {
+        data.push_back(reinterpret_cast<const uint8_t*>(str.c_str()), str.size());
+    }
+    return data;
+}
+
+TEST_F(Global_Ser_ZipReaderTests, ReadWrittenFiles)
+{
+    //! GIVEN Zip archive with a couple of files
+    ByteArray score = makeData("<museScore version=\"4.00\"></museScore>\n", 1000);
+    ByteArray style = makeData("<Style/>", 1);
+
+    ByteArray zipData;
+    {
+        Buffer buf(&zipData);
+        buf.open(IODevice::WriteOnly);
+        ZipWriter writer(&buf);
+        writer.addFile("score.mscx", score);
+        writer.addFile("META-INF/style.mss", style);
+        writer.close();
+    }
+
+    //! DO Read archive
+    Buffer buf(&zipData);
+    buf.open(IODevice::ReadOnly);
+    ZipReader reader(&buf);
+
+    //! CHECK
+    std::vector<ZipReader::FileInfo> files = reader.fileInfoList();
+    ASSERT_EQ(files.size(), 2);
+    EXPECT_EQ(files.at(0).filePath, "score.mscx");
+    EXPECT_EQ(files.at(0).size, score.size());
+
+    EXPECT_EQ(reader.fileData("score.mscx"), score);
+    EXPECT_EQ(reader.fileData("META-INF/style.mss"), style);
+    EXPECT_EQ(reader.fileDataView("score.mscx"), score);
+    EXPECT_TRUE(reader.fileData("unknown.mscx").empty());
+    EXPECT_FALSE(reader.hasError());
+}
+
+TEST_F(Global_Ser_ZipReaderTests, ViewStoredFileOfMappedArchive)
+{
+    //! GIVEN Zip archive file with a stored (not compressed) file, like images are saved
+    path_t filePath("ZipReaderTests_ViewStoredFile.zip");
+    ByteArray image = makeData("\x89PNG not compressed", 100);
+    ByteArray score = makeData("<museScore version=\"4.00\"></museScore>\n", 100);
+    {
+        File file(filePath);
+        file.open(IODevice::WriteOnly);
+        ZipContainer zip(&file);
+        zip.setCompressionPolicy(ZipContainer::NeverCompress);
+        zip.addFile("Pictures/image.png", image);
+        zip.setCompressionPolicy(ZipContainer::AlwaysCompress);
+        zip.addFile("score.mscx", score);
+        zip.close();
+        file.close();
+    }
+
+    {
+        //! DO Read archive through the mapped file
+        MappedFile file(filePath);
+        ASSERT_TRUE(file.open(IODevice::ReadOnly));
+        const uint8_t* begin = file.readData();
+        const uint8_t* end = begin + file.size();
+
+        ZipContainer zip(&file);
+        ByteArray view = zip.fileDataView("Pictures/image.png");
+
+        //! CHECK The stored file is not copied, the view refers to the mapped data
+        EXPECT_EQ(view, image);
+        EXPECT_GE(view.constData(), begin);
+        EXPECT_LE(view.constData() + view.size(), end);
+
+        //! CHECK The compressed file is read as usual
+        EXPECT_EQ(zip.fileDataView("score.mscx"), score);
+    }
+
+    {
+        //! DO Read archive by the path
+        ZipReader reader(filePath);
+
+        //! CHECK
+        EXPECT_EQ(reader.fileDataView("Pictures/image.png"), image);
+        EXPECT_EQ(reader.fileData("Pictures/image.png"), image);
+        EXPECT_EQ(reader.fileData("score.mscx"), score);
+        EXPECT_FALSE(reader.hasError());
+    }
+
+    File::remove(filePath);
+}
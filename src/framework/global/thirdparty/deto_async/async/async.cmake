@@ -11,6 +11,8 @@ set (ASYNC_SRC
     ${CMAKE_CURRENT_LIST_DIR}/internal/abstractinvoker.h
     ${CMAKE_CURRENT_LIST_DIR}/internal/queuedinvoker.cpp
     ${CMAKE_CURRENT_LIST_DIR}/internal/queuedinvoker.h
+    ${CMAKE_CURRENT_LIST_DIR}/internal/inlinefunctor.h
+    ${CMAKE_CURRENT_LIST_DIR}/internal/spscqueue.h
     ${CMAKE_CURRENT_LIST_DIR}/internal/asyncimpl.cpp
     ${CMAKE_CURRENT_LIST_DIR}/internal/asyncimpl.h
 )
@@ -76,6 +76,7 @@ public:
 
     static void processEvents();
     static void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
+    static void onQueued(const std::thread::id& th, const std::function<void()>& f);
 
 protected:
     explicit AbstractInvoker();
@@ -168,6 +169,11 @@ inline void onMainThreadInvoke(const std::function<void(const std::function<void
 {
     AbstractInvoker::onMainThreadInvoke(f);
 }
+
+inline void onQueued(const std::thread::id& th, const std::function<void()>& f)
+{
+    AbstractInvoker::onQueued(th, f);
+}
 }
 }
 
@@ -0,0 +1,117 @@
+#ifndef DETO_ASYNC_INLINEFUNCTOR_H
+#define DETO_ASYNC_INLINEFUNCTOR_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace deto {
+namespace async {
+//! Move-only void() callable that keeps small functors inside itself,
+//! so queuing a call doesn't allocate. Bigger functors are moved to the heap.
+class InlineFunctor
+{
+public:
+    static constexpr size_t INLINE_SIZE = 48;
+
+    InlineFunctor() = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineFunctor> > >
+    InlineFunctor(F&& f)
+    {
+        using Fn = std::decay_t<F>;
+        if constexpr (sizeof(Fn) <= INLINE_SIZE && alignof(Fn) <= alignof(std::max_align_t)
+                      && std::is_nothrow_move_constructible_v<Fn>) {
+            new (m_storage) Fn(std::forward<F>(f));
+            m_ops = &InlineOps<Fn>::ops;
+        } else {
+            *reinterpret_cast<Fn**>(m_storage) = new Fn(std::forward<F>(f));
+            m_ops = &HeapOps<Fn>::ops;
+        }
+    }
+
+    InlineFunctor(InlineFunctor&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    InlineFunctor& operator=(InlineFunctor&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InlineFunctor(const InlineFunctor&) = delete;
+    InlineFunctor& operator=(const InlineFunctor&) = delete;
+
+    ~InlineFunctor()
+    {
+        reset();
+    }
+
+    explicit operator bool() const
+    {
+        return m_ops != nullptr;
+    }
+
+    void operator()()
+    {
+        m_ops->call(m_storage);
+    }
+
+    void reset()
+    {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (* call)(void* storage);
+        void (* move)(void* dst, void* src);
+        void (* destroy)(void* storage);
+    };
+
+    template<typename Fn>
+    struct InlineOps {
+        static void call(void* s) { (*reinterpret_cast<Fn*>(s))(); }
+        static void move(void* dst, void* src)
+        {
+            new (dst) Fn(std::move(*reinterpret_cast<Fn*>(src)));
+            reinterpret_cast<Fn*>(src)->~Fn();
+        }
+
+        static void destroy(void* s) { reinterpret_cast<Fn*>(s)->~Fn(); }
+        static constexpr Ops ops = { &call, &move, &destroy };
+    };
+
+    template<typename Fn>
+    struct HeapOps {
+        static void call(void* s) { (**reinterpret_cast<Fn**>(s))(); }
+        static void move(void* dst, void* src) { *reinterpret_cast<Fn**>(dst) = *reinterpret_cast<Fn**>(src); }
+        static void destroy(void* s) { delete *reinterpret_cast<Fn**>(s); }
+        static constexpr Ops ops = { &call, &move, &destroy };
+    };
+
+    void moveFrom(InlineFunctor& other)
+    {
+        if (other.m_ops) {
+            other.m_ops->move(m_storage, other.m_storage);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[INLINE_SIZE];
+    const Ops* m_ops = nullptr;
+};
+}
+}
+
+#endif // DETO_ASYNC_INLINEFUNCTOR_H
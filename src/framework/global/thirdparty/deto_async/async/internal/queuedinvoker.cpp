@@ -8,30 +8,85 @@ QueuedInvoker* QueuedInvoker::instance()
     return &i;
 }
 
-void QueuedInvoker::invoke(const std::thread::id& th, const Functor& f, bool isAlwaysQueued)
+QueuedInvoker::ProducerChannels::~ProducerChannels()
 {
-    if (m_onMainThreadInvoke) {
-        if (th == m_mainThreadID) {
-            m_onMainThreadInvoke(f, isAlwaysQueued);
+    for (auto& it : channels) {
+        if (it.second.second) {
+            it.second.second->released.store(true, std::memory_order_release);
         }
     }
+}
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    m_queues[th].push(f);
+QueuedInvoker::Mailbox* QueuedInvoker::mailbox(const std::thread::id& th)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_ptr<Mailbox>& box = m_mailboxes[th];
+    if (!box) {
+        box = std::make_unique<Mailbox>();
+    }
+    return box.get();
 }
 
-void QueuedInvoker::processEvents()
+std::pair<QueuedInvoker::Mailbox*, QueuedInvoker::Channel*> QueuedInvoker::producerChannel(const std::thread::id& th)
 {
-    Queue q;
+    static thread_local ProducerChannels producer;
+
+    auto it = producer.channels.find(th);
+    if (it != producer.channels.end()) {
+        return it->second;
+    }
+
+    Mailbox* box = mailbox(th);
+    Channel* channel = nullptr;
     {
-        std::lock_guard<std::recursive_mutex> lock(m_mutex);
-        auto n = m_queues.extract(std::this_thread::get_id());
-        if (!n.empty()) {
-            q = n.mapped();
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // take over a channel of a finished thread
+        for (const std::unique_ptr<Channel>& c : box->ownedChannels) {
+            if (c->released.load(std::memory_order_acquire)) {
+                c->released.store(false, std::memory_order_relaxed);
+                channel = c.get();
+                break;
+            }
+        }
+
+        size_t count = box->channelsCount.load(std::memory_order_relaxed);
+        if (!channel && count < MAX_CHANNELS) {
+            box->ownedChannels.push_back(std::make_unique<Channel>());
+            channel = box->ownedChannels.back().get();
+            box->channels[count].store(channel, std::memory_order_release);
+            box->channelsCount.store(count + 1, std::memory_order_release);
         }
     }
+
+    std::pair<Mailbox*, Channel*> result(box, channel);
+    producer.channels[th] = result;
+    return result;
+}
+
+void QueuedInvoker::push(const std::thread::id& th, InlineFunctor&& f)
+{
+    auto [box, channel] = producerChannel(th);
+
+    if (!channel) {
+        std::lock_guard<std::mutex> lock(box->sharedMutex);
+        box->shared.push(std::move(f));
+    } else if (channel->overflowed.load(std::memory_order_acquire) || !channel->queue.push(std::move(f))) {
+        std::lock_guard<std::mutex> lock(channel->overflowMutex);
+        channel->overflow.push(std::move(f));
+        channel->overflowed.store(true, std::memory_order_release);
+    }
+
+    Functor* onQueued = box->onQueued.load(std::memory_order_acquire);
+    if (onQueued) {
+        (*onQueued)();
+    }
+}
+
+static void processQueue(std::queue<InlineFunctor>& q)
+{
     while (!q.empty()) {
-        const auto& f = q.front();
+        InlineFunctor& f = q.front();
         if (f) {
             f();
         }
@@ -39,8 +94,62 @@ void QueuedInvoker::processEvents()
     }
 }
 
+void QueuedInvoker::processEvents()
+{
+    static thread_local Mailbox* box = nullptr;
+    if (!box) {
+        box = mailbox(std::this_thread::get_id());
+    }
+
+    size_t channelsCount = box->channelsCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < channelsCount; ++i) {
+        Channel* channel = box->channels[i].load(std::memory_order_acquire);
+
+        // only what is queued now, calls queued while processing go to the next round
+        InlineFunctor f;
+        for (size_t n = channel->queue.size(); n > 0 && channel->queue.pop(f); --n) {
+            if (f) {
+                f();
+            }
+            f.reset();
+        }
+
+        // the overflow holds the newest calls, it may only be taken once the ring is empty
+        if (channel->overflowed.load(std::memory_order_acquire) && channel->queue.size() == 0) {
+            Queue q;
+            {
+                std::lock_guard<std::mutex> lock(channel->overflowMutex);
+                std::swap(q, channel->overflow);
+                channel->overflowed.store(false, std::memory_order_release);
+            }
+            processQueue(q);
+        }
+    }
+
+    Queue shared;
+    {
+        std::lock_guard<std::mutex> lock(box->sharedMutex);
+        std::swap(shared, box->shared);
+    }
+    processQueue(shared);
+}
+
 void QueuedInvoker::onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f)
 {
     m_onMainThreadInvoke = f;
     m_mainThreadID = std::this_thread::get_id();
 }
+
+void QueuedInvoker::onQueued(const std::thread::id& th, const Functor& f)
+{
+    Mailbox* box = mailbox(th);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (f) {
+        //! NOTE Producers may still be calling the previous functor, so none of them are deleted
+        box->onQueuedFunctors.push_back(std::make_unique<Functor>(f));
+        box->onQueued.store(box->onQueuedFunctors.back().get(), std::memory_order_release);
+    } else {
+        box->onQueued.store(nullptr, std::memory_order_release);
+    }
+}
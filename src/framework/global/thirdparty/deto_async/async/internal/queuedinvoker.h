@@ -1,11 +1,18 @@
 #ifndef DETO_ASYNC_QUEUEDINVOKER_H
 #define DETO_ASYNC_QUEUEDINVOKER_H
 
+#include <atomic>
 #include <functional>
 #include <queue>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
+
+#include "inlinefunctor.h"
+#include "spscqueue.h"
 
 namespace deto {
 namespace async {
@@ -17,18 +24,71 @@ public:
 
     using Functor = std::function<void ()>;
 
-    void invoke(const std::thread::id& th, const Functor& f, bool isAlwaysQueued = false);
+    template<typename F>
+    void invoke(const std::thread::id& th, F&& f, bool isAlwaysQueued = false)
+    {
+        if (m_onMainThreadInvoke && th == m_mainThreadID) {
+            m_onMainThreadInvoke(Functor(std::forward<F>(f)), isAlwaysQueued);
+            return;
+        }
+
+        push(th, InlineFunctor(std::forward<F>(f)));
+    }
+
     void processEvents();
     void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
 
+    // called after a functor was queued for the thread, lets a sleeping thread wake up to process it
+    void onQueued(const std::thread::id& th, const Functor& f);
+
 private:
 
     QueuedInvoker() = default;
 
-    using Queue = std::queue<Functor>;
+    static constexpr size_t CHANNEL_CAPACITY = 512;
+    static constexpr size_t MAX_CHANNELS = 64;
+
+    using Queue = std::queue<InlineFunctor>;
+
+    // calls from one producer thread to one consumer thread
+    struct Channel {
+        SpscQueue<InlineFunctor, CHANNEL_CAPACITY> queue;
+
+        // used while the ring is full, stays in use until the consumer has emptied it to keep the order
+        std::mutex overflowMutex;
+        Queue overflow;
+        std::atomic<bool> overflowed = false;
+
+        // the producer thread has finished, another thread can take the channel over
+        std::atomic<bool> released = false;
+    };
+
+    // all calls to one consumer thread
+    struct Mailbox {
+        std::atomic<Channel*> channels[MAX_CHANNELS] = {};
+        std::atomic<size_t> channelsCount = 0;
+        std::vector<std::unique_ptr<Channel> > ownedChannels;
+
+        // for producers beyond MAX_CHANNELS
+        std::mutex sharedMutex;
+        Queue shared;
+
+        std::atomic<Functor*> onQueued = nullptr;
+        std::vector<std::unique_ptr<Functor> > onQueuedFunctors;
+    };
+
+    // channels of the current thread as a producer, released when the thread finishes
+    struct ProducerChannels {
+        std::map<std::thread::id, std::pair<Mailbox*, Channel*> > channels;
+        ~ProducerChannels();
+    };
+
+    void push(const std::thread::id& th, InlineFunctor&& f);
+    Mailbox* mailbox(const std::thread::id& th);
+    std::pair<Mailbox*, Channel*> producerChannel(const std::thread::id& th);
 
-    std::recursive_mutex m_mutex;
-    std::map<std::thread::id, Queue > m_queues;
+    std::mutex m_mutex;
+    std::map<std::thread::id, std::unique_ptr<Mailbox> > m_mailboxes;
 
     std::function<void(const std::function<void()>&, bool)> m_onMainThreadInvoke;
     std::thread::id m_mainThreadID;
@@ -0,0 +1,59 @@
+#ifndef DETO_ASYNC_SPSCQUEUE_H
+#define DETO_ASYNC_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace deto {
+namespace async {
+//! Preallocated lock-free ring for exactly one producer and one consumer thread
+template<typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    //! producer only, false if the queue is full
+    bool push(T&& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        m_items[tail & (Capacity - 1)] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! consumer only, false if the queue is empty
+    bool pop(T& value)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = std::move(m_items[head & (Capacity - 1)]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! consumer only, number of items that can be popped right now
+    size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    alignas(CACHE_LINE) std::atomic<size_t> m_head = 0;
+    alignas(CACHE_LINE) std::atomic<size_t> m_tail = 0;
+    alignas(CACHE_LINE) T m_items[Capacity];
+};
+}
+}
+
+#endif // DETO_ASYNC_SPSCQUEUE_H
@@ -170,6 +170,8 @@ void Profiler::clear()
         }
         m_steps.timers.clear();
     }
+
+    clearTimeline();
 }
 
 Profiler::Data Profiler::threadsData(Data::Mode mode) const
@@ -266,6 +268,209 @@ bool Profiler::save_file(const std::string& path, const std::string& content)
     return count > 0;
 }
 
+// Timeline
+
+static const std::chrono::steady_clock::time_point s_timelineEpoch = std::chrono::steady_clock::now();
+
+void Profiler::setTimelineEnabled(bool enabled)
+{
+    m_options.timelineEnabled = enabled;
+}
+
+Profiler::ThreadTimelineRef::~ThreadTimelineRef()
+{
+    if (timeline) {
+        timeline->finished.store(true, std::memory_order_release);
+    }
+}
+
+Profiler::ThreadTimelineRef& Profiler::threadTimelineRef()
+{
+    static thread_local ThreadTimelineRef ref;
+    return ref;
+}
+
+//! NOTE Created on the first event of the thread, so only threads that are traced while the timeline is enabled get one
+Profiler::ThreadTimeline* Profiler::threadTimeline()
+{
+    ThreadTimelineRef& ref = threadTimelineRef();
+    if (!ref.timeline) {
+        std::lock_guard<std::mutex> lock(m_timeline.mutex);
+
+        std::unique_ptr<ThreadTimeline> th = std::make_unique<ThreadTimeline>();
+        th->tid = ++m_timeline.lastTid;
+        th->name = ref.name.empty() ? "thread " + std::to_string(th->tid) : ref.name;
+
+        ref.timeline = th.get();
+        m_timeline.threads.push_back(std::move(th));
+    }
+
+    return ref.timeline;
+}
+
+void Profiler::setThreadName(const std::string& name)
+{
+    ThreadTimelineRef& ref = threadTimelineRef();
+    ref.name = name;
+
+    if (ref.timeline) {
+        std::lock_guard<std::mutex> lock(m_timeline.mutex);
+        ref.timeline->name = name;
+    }
+}
+
+int64_t Profiler::timelineNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_timelineEpoch).count();
+}
+
+void Profiler::addTimelineEvent(const std::string& func, int64_t beginNs, int64_t endNs)
+{
+    ThreadTimeline* timeline = threadTimeline();
+
+    if (!timeline->events) {
+        uint64_t capacity = 1;
+        while (capacity < m_options.timelineEventsPerThread) {
+            capacity <<= 1;
+        }
+
+        //! NOTE Only the owner thread writes the ring, the lock makes its allocation visible to the reader
+        std::lock_guard<std::mutex> lock(m_timeline.mutex);
+        timeline->events = std::make_unique<TimelineEvent[]>(capacity);
+        timeline->mask = capacity - 1;
+    }
+
+    uint64_t index = timeline->written.load(std::memory_order_relaxed);
+
+    TimelineEvent& event = timeline->events[index & timeline->mask];
+    event.func.store(&func, std::memory_order_relaxed);
+    event.beginNs.store(beginNs, std::memory_order_relaxed);
+    event.endNs.store(endNs, std::memory_order_relaxed);
+
+    timeline->written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::clearTimeline()
+{
+    std::lock_guard<std::mutex> lock(m_timeline.mutex);
+
+    //! NOTE A finished thread does not write anymore, so its ring can be freed;
+    //! the rings of the running threads are kept, they write without taking the lock
+    m_timeline.threads.remove_if([](const std::unique_ptr<ThreadTimeline>& timeline) {
+        return timeline->finished.load(std::memory_order_acquire);
+    });
+
+    for (const std::unique_ptr<ThreadTimeline>& timeline : m_timeline.threads) {
+        timeline->clearedAt.store(timeline->written.load(std::memory_order_acquire));
+    }
+}
+
+static std::string jsonEscaped(const std::string& str)
+{
+    std::string result;
+    result.reserve(str.size());
+
+    for (char c : str) {
+        switch (c) {
+        case '"': result.append("\\\""); break;
+        case '\\': result.append("\\\\"); break;
+        case '\n': result.append("\\n"); break;
+        case '\t': result.append("\\t"); break;
+        default:
+            if (static_cast<unsigned char>(c) >= 0x20) {
+                result.push_back(c);
+            }
+        }
+    }
+
+    return result;
+}
+
+static std::string formatMicroseconds(int64_t ns)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.3f", static_cast<double>(ns) / 1000.0);
+    return buf;
+}
+
+std::string Profiler::timelineToChromeTrace() const
+{
+    struct Event {
+        const std::string* func = nullptr;
+        int64_t beginNs = 0;
+        int64_t endNs = 0;
+    };
+
+    std::string str;
+    str.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    bool isFirst = true;
+    auto beginObject = [&str, &isFirst]() {
+        str.append(isFirst ? "\n{" : ",\n{");
+        isFirst = false;
+    };
+
+    std::lock_guard<std::mutex> lock(m_timeline.mutex);
+
+    std::vector<Event> events;
+    for (const std::unique_ptr<ThreadTimeline>& timeline : m_timeline.threads) {
+        const std::string tid = std::to_string(timeline->tid);
+
+        beginObject();
+        str.append("\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":").append(tid)
+        .append(",\"args\":{\"name\":\"").append(jsonEscaped(timeline->name)).append("\"}}");
+
+        if (!timeline->events) {
+            continue;
+        }
+
+        //! NOTE The owner thread keeps writing while we copy, so after the copy
+        //! we drop the entries that it may have overwritten in the meantime
+        const bool finished = timeline->finished.load(std::memory_order_acquire);
+        const uint64_t capacity = timeline->mask + 1;
+        const uint64_t written = timeline->written.load(std::memory_order_acquire);
+        const uint64_t from = std::max(timeline->clearedAt.load(), written > capacity ? written - capacity : 0);
+
+        events.clear();
+        for (uint64_t i = from; i < written; ++i) {
+            const TimelineEvent& event = timeline->events[i & timeline->mask];
+            events.push_back({ event.func.load(std::memory_order_relaxed),
+                               event.beginNs.load(std::memory_order_relaxed),
+                               event.endNs.load(std::memory_order_relaxed) });
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        const uint64_t writtenAfter = timeline->written.load(std::memory_order_relaxed);
+        const uint64_t firstIntact = writtenAfter >= capacity ? writtenAfter - capacity + 1 : 0;
+        if (!finished && firstIntact > from) {
+            events.erase(events.begin(), events.begin() + static_cast<ptrdiff_t>(std::min<uint64_t>(firstIntact - from, events.size())));
+        }
+
+        std::sort(events.begin(), events.end(), [](const Event& e1, const Event& e2) {
+            return e1.beginNs < e2.beginNs;
+        });
+
+        for (const Event& event : events) {
+            beginObject();
+            str.append("\"name\":\"").append(jsonEscaped(*event.func))
+            .append("\",\"ph\":\"X\",\"pid\":1,\"tid\":").append(tid)
+            .append(",\"ts\":").append(formatMicroseconds(event.beginNs))
+            .append(",\"dur\":").append(formatMicroseconds(event.endNs - event.beginNs))
+            .append("}");
+        }
+    }
+
+    str.append("\n]}\n");
+
+    return str;
+}
+
+bool Profiler::saveTimeline(const std::string& filePath)
+{
+    return save_file(filePath, timelineToChromeTrace());
+}
+
 std::string FuncMarker::formatSig(const std::string& sig)
 {
     static const std::string Coln("::");
@@ -3,12 +3,15 @@
 
 #include <string>
 #include <list>
+#include <memory>
+#include <atomic>
 #include <vector>
 #include <set>
 #include <unordered_map>
 #include <thread>
 #include <mutex>
 #include <chrono>
+#include <cstdint>
 #include <sstream>
 
 #ifndef FUNC_INFO
@@ -53,6 +56,10 @@
 #define PROFILER_PRINT haw::profiler::Profiler::instance()->printThreadsData();
 #endif
 
+#ifndef PROFILER_SAVE_TIMELINE
+#define PROFILER_SAVE_TIMELINE(filePath) haw::profiler::Profiler::instance()->saveTimeline(filePath);
+#endif
+
 #else
 
 #define TRACEFUNC
@@ -61,6 +68,7 @@
 #define STEP_TIME
 #define PROFILER_CLEAR
 #define PROFILER_PRINT
+#define PROFILER_SAVE_TIMELINE(filePath)
 
 #endif
 
@@ -77,6 +85,8 @@ public:
         bool funcsTraceEnabled{ false };
         size_t funcsMaxThreadCount{ 100 };
         int dataTopCount{ 150 };
+        bool timelineEnabled{ false };
+        size_t timelineEventsPerThread{ 65536 }; //! NOTE Rounded up to a power of two, the oldest events are overwritten
         Options() {}
     };
 
@@ -161,6 +171,18 @@ public:
 
     bool save(const std::string& filePath);
 
+    //! Timeline
+    void setTimelineEnabled(bool enabled);
+    void setThreadName(const std::string& name);
+
+    void addTimelineEvent(const std::string& func, int64_t beginNs, int64_t endNs);
+    static int64_t timelineNowNs();
+
+    void clearTimeline(); //! NOTE Also frees the timelines of the finished threads
+
+    std::string timelineToChromeTrace() const; //! NOTE Trace Event Format, opens in chrome://tracing and Perfetto
+    bool saveTimeline(const std::string& filePath);
+
 private:
     Profiler();
     ~Profiler();
@@ -197,12 +219,47 @@ private:
         int addThread(std::thread::id th);
     };
 
+    //! NOTE Every thread writes its own ring without locks, one complete event per call,
+    //! so overwritten entries never leave unbalanced begin/end pairs in the trace
+    struct TimelineEvent {
+        std::atomic<const std::string*> func{ nullptr };
+        std::atomic<int64_t> beginNs{ 0 };
+        std::atomic<int64_t> endNs{ 0 };
+    };
+
+    struct ThreadTimeline {
+        int tid{ 0 };
+        std::string name;
+        std::unique_ptr<TimelineEvent[]> events;
+        uint64_t mask{ 0 };
+        std::atomic<uint64_t> written{ 0 };
+        std::atomic<uint64_t> clearedAt{ 0 };
+        std::atomic<bool> finished{ false };
+    };
+
+    //! NOTE Owned by the thread, marks its timeline as finished when the thread exits
+    struct ThreadTimelineRef {
+        ThreadTimeline* timeline{ nullptr };
+        std::string name;
+        ~ThreadTimelineRef();
+    };
+
+    struct TimelineData {
+        mutable std::mutex mutex;
+        std::list<std::unique_ptr<ThreadTimeline> > threads;
+        int lastTid{ 0 };
+    };
+
+    static ThreadTimelineRef& threadTimelineRef();
+    ThreadTimeline* threadTimeline();
+
     bool save_file(const std::string& path, const std::string& content);
 
     Printer* m_printer{ nullptr };
 
     StepsData m_steps;
     mutable FuncsData m_funcs;
+    TimelineData m_timeline;
 
     size_t m_stackCounter{ 0 };
 };
@@ -215,6 +272,10 @@ struct FuncMarker
         if (Profiler::m_options.funcsTimeEnabled) {
             timer = Profiler::instance()->beginFunc(fn);
         }
+
+        if (Profiler::m_options.timelineEnabled) {
+            beginNs = Profiler::timelineNowNs();
+        }
     }
 
     ~FuncMarker()
@@ -222,11 +283,16 @@ struct FuncMarker
         if (Profiler::m_options.funcsTimeEnabled) {
             Profiler::instance()->endFunc(timer, func);
         }
+
+        if (beginNs >= 0) {
+            Profiler::instance()->addTimelineEvent(func, beginNs, Profiler::timelineNowNs());
+        }
     }
 
     static std::string formatSig(const std::string& sig);
 
     Profiler::FuncTimer* timer{ nullptr };
+    int64_t beginNs{ -1 };
     const std::string& func;
 };
 }
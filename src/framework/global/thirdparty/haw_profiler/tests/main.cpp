@@ -74,11 +74,16 @@ int main(int argc, char* argv[])
 {
     std::clog << "Hello World, I am Profiler\n";
 
+    haw::profiler::Profiler::instance()->setTimelineEnabled(true);
+
     Example t;
     t.example();
 
     PROFILER_PRINT;
 
+    //! NOTE Open in chrome://tracing or https://ui.perfetto.dev
+    PROFILER_SAVE_TIMELINE("timeline.json");
+
     /* Output:
         mark1 : 0.000/0.000 ms: Begin
         mark1 : 21.582/21.545 ms: end call func2 10 times
@@ -186,8 +186,58 @@ char16_t Char::toUpper(char16_t ch)
 // ============================
 // UtfCodec
 // ============================
+//! NOTE Most of the strings (xml tags, attributes, style and property values) are ASCII,
+//! so they are converted by a simple widening/narrowing without utf8 validation
+
+static size_t asciiPrefixSize(std::string_view src)
+{
+    const size_t size = src.size();
+    const char* data = src.data();
+
+    size_t i = 0;
+    // check 8 bytes at once
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t chunk;
+        std::memcpy(&chunk, data + i, sizeof(uint64_t));
+        if (chunk & 0x8080808080808080ULL) {
+            break;
+        }
+    }
+
+    for (; i < size; ++i) {
+        if (static_cast<unsigned char>(data[i]) & 0x80) {
+            break;
+        }
+    }
+    return i;
+}
+
+static size_t asciiPrefixSize(std::u16string_view src)
+{
+    size_t i = 0;
+    for (; i < src.size(); ++i) {
+        if (src[i] > 0x7f) {
+            break;
+        }
+    }
+    return i;
+}
+
 void UtfCodec::utf8to16(std::string_view src, std::u16string& dst)
 {
+    const size_t asciiSize = asciiPrefixSize(src);
+    const size_t offset = dst.size();
+    dst.resize(offset + asciiSize);
+    for (size_t i = 0; i < asciiSize; ++i) {
+        dst[offset + i] = static_cast<char16_t>(src[i]);
+    }
+
+    if (asciiSize == src.size()) {
+        return;
+    }
+
+    src.remove_prefix(asciiSize);
+    dst.reserve(dst.size() + src.size());
     try {
         utf8::utf8to16(src.begin(), src.end(), std::back_inserter(dst));
     } catch (const std::exception& e) {
@@ -197,6 +247,19 @@ void UtfCodec::utf8to16(std::string_view src, std::u16string& dst)
 
 void UtfCodec::utf16to8(std::u16string_view src, std::string& dst)
 {
+    const size_t asciiSize = asciiPrefixSize(src);
+    const size_t offset = dst.size();
+    dst.resize(offset + asciiSize);
+    for (size_t i = 0; i < asciiSize; ++i) {
+        dst[offset + i] = static_cast<char>(src[i]);
+    }
+
+    if (asciiSize == src.size()) {
+        return;
+    }
+
+    src.remove_prefix(asciiSize);
+    dst.reserve(dst.size() + src.size() * 2);
     try {
         utf8::utf16to8(src.begin(), src.end(), std::back_inserter(dst));
     } catch (const std::exception& e) {
@@ -226,9 +289,18 @@ void UtfCodec::utf32to8(std::u32string_view src, std::string& dst)
 // String
 // ============================
 
+//! NOTE All empty strings share the same data,
+//! so creating an empty string (for example, a member of an engraving item) doesn't allocate.
+//! The data is detached (copied) on the first modification.
+static const std::shared_ptr<std::u16string>& emptyData()
+{
+    static const std::shared_ptr<std::u16string> empty = std::make_shared<std::u16string>();
+    return empty;
+}
+
 String::String()
+    : m_data(emptyData())
 {
-    m_data = std::make_shared<std::u16string>();
 }
 
 String::String(const char16_t* str)
@@ -300,12 +372,14 @@ void String::reserve(size_t i)
 
 bool String::operator ==(const AsciiStringView& s) const
 {
-    if (size() != s.size()) {
+    const std::u16string& str = constStr();
+    if (str.size() != s.size()) {
         return false;
     }
 
-    for (size_t i = 0; i < s.size(); ++i) {
-        if (at(i).toAscii() != s.at(i).ascii()) {
+    const char* ascii = s.ascii();
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] != static_cast<char16_t>(static_cast<unsigned char>(ascii[i]))) {
             return false;
         }
     }
@@ -343,6 +417,11 @@ void String::detach()
         return;
     }
 
+    if (m_data->empty()) {
+        m_data = std::make_shared<std::u16string>();
+        return;
+    }
+
     m_data = std::make_shared<std::u16string>(*m_data);
 }
 
@@ -404,14 +483,19 @@ String String::fromUtf8(const char* str)
 
 ByteArray String::toUtf8() const
 {
-    ByteArray ba;
     std::u16string_view v(constStr());
-    try {
-        utf8::utf16to8(v.begin(), v.end(), std::back_inserter(ba));
-    } catch (const std::exception& e) {
-        LOGE() << e.what();
+    if (asciiPrefixSize(v) == v.size()) {
+        ByteArray ba(v.size());
+        uint8_t* data = ba.data();
+        for (size_t i = 0; i < v.size(); ++i) {
+            data[i] = static_cast<uint8_t>(v[i]);
+        }
+        return ba;
     }
-    return ba;
+
+    std::string s;
+    UtfCodec::utf16to8(v, s);
+    return ByteArray(s.c_str(), s.size());
 }
 
 String String::fromAscii(const char* str, size_t size)
@@ -1,11 +1,76 @@
 #include "gp67dombuilder.h"
 
+#include <algorithm>
 #include <set>
+#include <thread>
 
+#include "concurrency/taskscheduler.h"
 #include "global/log.h"
 #include "types/constants.h"
 
 namespace mu::engraving {
+//! NOTE Sections with fewer elements than this are built on the calling thread
+static constexpr size_t PARALLEL_BUILD_THRESHOLD = 512;
+
+//! NOTE Creates the objects for all children named `childName` of `parentNode`.
+//! Every child is a separate subtree of the document, so large sections are split
+//! into chunks that are read on the task scheduler threads. The results are merged
+//! in document order, so the result is the same as for the serial build
+template<typename T>
+static std::unordered_map<int, T> createGPElements(XmlDomNode* parentNode, const String& childName,
+                                                   const std::function<std::pair<int, T>(XmlDomNode*)>& create)
+{
+    std::vector<XmlDomNode> nodes;
+    for (XmlDomNode node = parentNode->firstChild(); !node.isNull(); node = node.nextSibling()) {
+        if (node.nodeName() == childName) {
+            nodes.push_back(node);
+        }
+    }
+
+    std::unordered_map<int, T> result;
+    result.reserve(nodes.size());
+
+    TaskScheduler* scheduler = TaskScheduler::instance();
+    size_t chunkCount = std::min(static_cast<size_t>(scheduler->threadPoolSize()), nodes.size() / PARALLEL_BUILD_THRESHOLD);
+
+    //! NOTE Don't wait for the pool from one of its own threads
+    if (chunkCount <= 1 || scheduler->containsThread(std::this_thread::get_id())) {
+        for (XmlDomNode& node : nodes) {
+            result.insert(create(&node));
+        }
+
+        return result;
+    }
+
+    using Chunk = std::vector<std::pair<int, T> >;
+
+    auto createChunk = [&nodes, &create](size_t begin, size_t end) {
+        Chunk chunk;
+        chunk.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            chunk.push_back(create(&nodes[i]));
+        }
+
+        return chunk;
+    };
+
+    size_t chunkSize = (nodes.size() + chunkCount - 1) / chunkCount;
+
+    std::vector<std::future<Chunk> > futures;
+    futures.reserve(chunkCount);
+    for (size_t begin = 0; begin < nodes.size(); begin += chunkSize) {
+        futures.push_back(scheduler->submit(createChunk, begin, std::min(begin + chunkSize, nodes.size())));
+    }
+
+    for (std::future<Chunk>& future : futures) {
+        for (std::pair<int, T>& element : future.get()) {
+            result.insert(std::move(element));
+        }
+    }
+
+    return result;
+}
+
 GP67DomBuilder::GP67DomBuilder()
 {
     _gpDom = std::make_unique<GPDomModel>();
@@ -216,54 +281,23 @@ void GP67DomBuilder::buildGPVoices(XmlDomNode* voicesNode)
 
 void GP67DomBuilder::buildGPBeats(XmlDomNode* beatsNode)
 {
-    std::unordered_map<int, std::shared_ptr<GPBeat> > beats;
-
-    XmlDomNode innerNode = beatsNode->firstChild();
-    while (!innerNode.isNull()) {
-        String nodeName = innerNode.nodeName();
-        if (nodeName == u"Beat") {
-            beats.insert(createGPBeat(&innerNode));
-        }
-
-        innerNode = innerNode.nextSibling();
-    }
-
-    _beats.swap(beats);
+    _beats = createGPElements<std::shared_ptr<GPBeat> >(beatsNode, u"Beat", [this](XmlDomNode* node) {
+        return createGPBeat(node);
+    });
 }
 
 void GP67DomBuilder::buildGPNotes(XmlDomNode* notesNode)
 {
-    std::unordered_map<int, std::shared_ptr<GPNote> > notes;
-
-    XmlDomNode innerNode = notesNode->firstChild();
-
-    while (!innerNode.isNull()) {
-        String nodeName = innerNode.nodeName();
-        if (nodeName == u"Note") {
-            notes.insert(createGPNote(&innerNode));
-        }
-
-        innerNode = innerNode.nextSibling();
-    }
-
-    _notes.swap(notes);
+    _notes = createGPElements<std::shared_ptr<GPNote> >(notesNode, u"Note", [this](XmlDomNode* node) {
+        return createGPNote(node);
+    });
 }
 
 void GP67DomBuilder::buildGPRhythms(XmlDomNode* rhythmsNode)
 {
-    std::unordered_map<int, std::shared_ptr<GPRhythm> > rhythms;
-
-    XmlDomNode innerNode = rhythmsNode->firstChild();
-    while (!innerNode.isNull()) {
-        String nodeName = innerNode.nodeName();
-        if (nodeName == u"Rhythm") {
-            rhythms.insert(createGPRhythm(&innerNode));
-        }
-
-        innerNode = innerNode.nextSibling();
-    }
-
-    _rhythms.swap(rhythms);
+    _rhythms = createGPElements<std::shared_ptr<GPRhythm> >(rhythmsNode, u"Rhythm", [this](XmlDomNode* node) {
+        return createGPRhythm(node);
+    });
 }
 
 std::vector<GPMasterTracks::Automation> GP67DomBuilder::readTempoMap(XmlDomNode* currentNode)
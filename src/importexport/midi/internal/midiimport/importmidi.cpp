@@ -22,6 +22,7 @@
 
 #include <set>
 
+#include <QElapsedTimer>
 #include <QFile>
 
 #include "engraving/engravingerrors.h"
@@ -89,6 +90,35 @@ using namespace mu::engraving;
 namespace mu::iex::midi {
 extern void updateNoteLines(Segment*, int track);
 
+//---------------------------------------------------------
+//   ImportStageTimer
+//    logs the time of each import stage
+//---------------------------------------------------------
+
+class ImportStageTimer
+{
+public:
+    ImportStageTimer()
+    {
+        _timer.start();
+        _total.start();
+    }
+
+    void stageDone(const char* stage)
+    {
+        LOGI() << "MIDI import stage \"" << stage << "\": " << _timer.restart() << " ms";
+    }
+
+    void allDone()
+    {
+        LOGI() << "MIDI import total: " << _total.elapsed() << " ms";
+    }
+
+private:
+    QElapsedTimer _timer;
+    QElapsedTimer _total;
+};
+
 void lengthenTooShortNotes(std::multimap<int, MTrack>& tracks)
 {
     for (auto& track: tracks) {
@@ -237,23 +267,28 @@ void quantizeAllTracks(std::multimap<int, MTrack>& tracks,
 {
     auto& opers = midiImportOperations;
 
-    for (auto& track: tracks) {
-        MTrack& mtrack = track.second;
-        if (mtrack.chords.empty()) {
-            continue;
-        }
-        // pass current track index through MidiImportOperations
-        // for further usage
-        MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
-
-        if (opers.data()->processingsOfOpenedFile == 0) {
+    // for newly opened MIDI file; operations are changed before
+    // the tracks are processed concurrently, and then only read
+    if (opers.data()->processingsOfOpenedFile == 0) {
+        for (auto& track: tracks) {
+            MTrack& mtrack = track.second;
+            if (mtrack.chords.empty()) {
+                continue;
+            }
             opers.data()->trackOpers.isDrumTrack.setValue(
-                opers.currentTrack(), mtrack.mtrack->drumTrack());
+                mtrack.indexOfOperation, mtrack.mtrack->drumTrack());
             if (mtrack.mtrack->drumTrack()) {
                 opers.data()->trackOpers.maxVoiceCount.setValue(
-                    opers.currentTrack(), MidiOperations::VoiceCount::V_1);
+                    mtrack.indexOfOperation, MidiOperations::VoiceCount::V_1);
             }
         }
+    }
+
+    MidiTracks::processInParallel(tracks, [&opers, sigmap, &lastTick](MTrack& mtrack) {
+        // pass current track index through MidiImportOperations
+        // for further usage
+        MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
+
         const auto basicQuant = Quantize::quantValueToFraction(
             opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
 #ifdef QT_DEBUG
@@ -268,7 +303,7 @@ void quantizeAllTracks(std::multimap<int, MTrack>& tracks,
             MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
         }
 #ifdef QT_DEBUG
-        Q_ASSERT_X(!doNotesOverlap(track.second),
+        Q_ASSERT_X(!doNotesOverlap(mtrack),
                    "quantizeAllTracks",
                    "There are overlapping notes of the same voice that is incorrect");
 #endif
@@ -282,7 +317,7 @@ void quantizeAllTracks(std::multimap<int, MTrack>& tracks,
                    "quantizeAllTracks", "Tuplet chord/note is outside tuplet "
                                         "or non-tuplet chord/note is inside tuplet");
 #endif
-    }
+    });
 }
 
 //---------------------------------------------------------
@@ -1123,9 +1158,14 @@ ReducedFraction findLastChordTick(const std::multimap<int, MTrack>& tracks)
 
 QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
 {
+    TRACEFUNC;
+
+    ImportStageTimer stageTimer;
+
     auto* sigmap = score->sigmap();
 
     auto tracks = createMTrackList(sigmap, mf);
+    stageTimer.stageDone("create tracks");
 
     auto& opers = midiImportOperations;
     if (opers.data()->processingsOfOpenedFile == 0) {         // for newly opened MIDI file
@@ -1150,6 +1190,7 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
     } else {      // user value
         MidiBeat::setTimeSignature(sigmap);
     }
+    stageTimer.stageDone("beat detection");
 
     Q_ASSERT_X((opers.data()->trackOpers.isHumanPerformance.value())
                ? Meter::userTimeSigToFraction(opers.data()->trackOpers.timeSigNumerator.value(),
@@ -1160,6 +1201,7 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
     MChord::collectChords(tracks, { 2, 1 }, { 1, 2 });
     MidiBeat::adjustChordsToBeats(tracks);
     MChord::mergeChordsWithEqualOnTimeAndVoice(tracks);
+    stageTimer.stageDone("chord collection");
 
     // for newly opened MIDI file
     if (opers.data()->processingsOfOpenedFile == 0
@@ -1175,9 +1217,12 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
     LRHand::splitIntoLeftRightHands(tracks);
     MidiDrum::splitDrumVoices(tracks);
     MidiDrum::splitDrumTracks(tracks);
+    stageTimer.stageDone("left/right hand and drum split");
+
     ReducedFraction lastTick = findLastChordTick(tracks);
     quantizeAllTracks(tracks, sigmap, lastTick);
     MChord::removeOverlappingNotes(tracks);
+    stageTimer.stageDone("quantization and tuplets");
 #ifdef QT_DEBUG
     Q_ASSERT_X(!doNotesOverlap(tracks),
                "convertMidi", "There are overlapping notes of the same voice that is incorrect");
@@ -1191,12 +1236,14 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
     }
     Simplify::simplifyDurationsForDrums(tracks, sigmap);
     MChord::splitUnequalChords(tracks);
+    stageTimer.stageDone("voices and simplification");
     // no more track insertion/reordering/deletion from now
     QList<MTrack> trackList = prepareTrackList(tracks);
     MidiInstr::setGrandStaffProgram(trackList);
     MidiInstr::findInstrumentsForAllTracks(trackList);
     MidiInstr::createInstruments(score, trackList);
     MidiDrum::setStaffBracketForDrums(trackList);
+    stageTimer.stageDone("instruments");
 
     const auto firstTick = findFirstChordTick(trackList);
 
@@ -1215,6 +1262,8 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
     MidiLyrics::setLyricsToScore(trackList);
     MidiTempo::setTempo(tracks, score);
     MidiChordName::setChordNames(trackList);
+    stageTimer.stageDone("score creation");
+    stageTimer.allDone();
 
     return trackList;
 }
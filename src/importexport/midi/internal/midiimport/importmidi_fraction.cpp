@@ -22,6 +22,7 @@
 #include "importmidi_fraction.h"
 #include "libmscore/mscore.h"
 
+#include <cstdint>
 #include <limits>
 #include <QtGlobal>
 
@@ -110,6 +111,22 @@ static unsigned lcm(int a, int b)
     const int l = (a / g) * b;   // Divide first to minimize overflow risk
     return l >= 0 ? l : -l;
 }
+
+//---------------------------------------------------------
+//   compare
+//    for positive denominators only; cross multiplication
+//    in 64 bits can't overflow and doesn't need gcd
+//---------------------------------------------------------
+
+static int compare(const ReducedFraction& a, const ReducedFraction& b)
+{
+    if (a.denominator() == b.denominator()) {
+        return (a.numerator() > b.numerator()) - (a.numerator() < b.numerator());
+    }
+    const int64_t lhs = static_cast<int64_t>(a.numerator()) * b.denominator();
+    const int64_t rhs = static_cast<int64_t>(b.numerator()) * a.denominator();
+    return (lhs > rhs) - (lhs < rhs);
+}
 }
 
 //-----------------------------------------------------------------------------
@@ -228,6 +245,12 @@ ReducedFraction& ReducedFraction::operator+=(const ReducedFraction& val)
     ReducedFraction value = val;
     value.preventOverflow();
 
+    // most of the values in the importer share the same denominator
+    if (denominator_ == val.denominator_ && denominator_ > 0) {
+        numerator_ += val.numerator_;
+        return *this;
+    }
+
     const int tmp = lcm(denominator_, val.denominator_);
     numerator_ = fractionPart(tmp, numerator_, denominator_)
                  + fractionPart(tmp, val.numerator_, val.denominator_);
@@ -241,6 +264,11 @@ ReducedFraction& ReducedFraction::operator-=(const ReducedFraction& val)
     ReducedFraction value = val;
     value.preventOverflow();
 
+    if (denominator_ == val.denominator_ && denominator_ > 0) {
+        numerator_ -= val.numerator_;
+        return *this;
+    }
+
     const int tmp = lcm(denominator_, val.denominator_);
     numerator_ = fractionPart(tmp, numerator_, denominator_)
                  - fractionPart(tmp, val.numerator_, val.denominator_);
@@ -305,6 +333,9 @@ ReducedFraction& ReducedFraction::operator/=(int val)
 
 bool ReducedFraction::operator<(const ReducedFraction& val) const
 {
+    if (denominator_ > 0 && val.denominator_ > 0) {
+        return compare(*this, val) < 0;
+    }
     const int v = lcm(denominator_, val.denominator_);
     return fractionPart(v, numerator_, denominator_)
            < fractionPart(v, val.numerator_, val.denominator_);
@@ -312,6 +343,9 @@ bool ReducedFraction::operator<(const ReducedFraction& val) const
 
 bool ReducedFraction::operator<=(const ReducedFraction& val) const
 {
+    if (denominator_ > 0 && val.denominator_ > 0) {
+        return compare(*this, val) <= 0;
+    }
     const int v = lcm(denominator_, val.denominator_);
     return fractionPart(v, numerator_, denominator_)
            <= fractionPart(v, val.numerator_, val.denominator_);
@@ -319,6 +353,9 @@ bool ReducedFraction::operator<=(const ReducedFraction& val) const
 
 bool ReducedFraction::operator>(const ReducedFraction& val) const
 {
+    if (denominator_ > 0 && val.denominator_ > 0) {
+        return compare(*this, val) > 0;
+    }
     const int v = lcm(denominator_, val.denominator_);
     return fractionPart(v, numerator_, denominator_)
            > fractionPart(v, val.numerator_, val.denominator_);
@@ -326,6 +363,9 @@ bool ReducedFraction::operator>(const ReducedFraction& val) const
 
 bool ReducedFraction::operator>=(const ReducedFraction& val) const
 {
+    if (denominator_ > 0 && val.denominator_ > 0) {
+        return compare(*this, val) >= 0;
+    }
     const int v = lcm(denominator_, val.denominator_);
     return fractionPart(v, numerator_, denominator_)
            >= fractionPart(v, val.numerator_, val.denominator_);
@@ -333,6 +373,9 @@ bool ReducedFraction::operator>=(const ReducedFraction& val) const
 
 bool ReducedFraction::operator==(const ReducedFraction& val) const
 {
+    if (denominator_ > 0 && val.denominator_ > 0) {
+        return compare(*this, val) == 0;
+    }
     const int v = lcm(denominator_, val.denominator_);
     return fractionPart(v, numerator_, denominator_)
            == fractionPart(v, val.numerator_, val.denominator_);
@@ -340,6 +383,9 @@ bool ReducedFraction::operator==(const ReducedFraction& val) const
 
 bool ReducedFraction::operator!=(const ReducedFraction& val) const
 {
+    if (denominator_ > 0 && val.denominator_ > 0) {
+        return compare(*this, val) != 0;
+    }
     const int v = lcm(denominator_, val.denominator_);
     return fractionPart(v, numerator_, denominator_)
            != fractionPart(v, val.numerator_, val.denominator_);
@@ -21,6 +21,10 @@
  */
 #include "importmidi_inner.h"
 
+#include <exception>
+#include <future>
+#include <thread>
+
 #include <QTextCodec>
 
 #include "importmidi_operations.h"
@@ -30,6 +34,8 @@
 #include "engraving/libmscore/durationtype.h"
 #include "engraving/libmscore/sig.h"
 
+#include "concurrency/taskscheduler.h"
+
 namespace mu::iex::midi {
 MTrack::MTrack()
     : program(0)
@@ -300,4 +306,44 @@ double durationCount(const QList<std::pair<ReducedFraction, engraving::TDuration
     return count;
 }
 } // namespace MidiDuration
+
+namespace MidiTracks {
+void processInParallel(std::multimap<int, MTrack>& tracks, const std::function<void(MTrack&)>& func)
+{
+    TaskScheduler* scheduler = TaskScheduler::instance();
+    if (scheduler->threadPoolSize() < 2 || scheduler->containsThread(std::this_thread::get_id())) {
+        for (auto& track: tracks) {
+            if (!track.second.chords.empty()) {
+                func(track.second);
+            }
+        }
+        return;
+    }
+
+    std::vector<std::future<void> > jobs;
+    for (auto& track: tracks) {
+        MTrack& mtrack = track.second;
+        if (mtrack.chords.empty()) {
+            continue;
+        }
+        jobs.push_back(scheduler->submit([&func, &mtrack]() { func(mtrack); }));
+    }
+
+    //! NOTE The jobs refer to func and the tracks, so wait for all of them
+    //! before the first exception is rethrown
+    std::exception_ptr error;
+    for (auto& job: jobs) {
+        try {
+            job.get();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+} // namespace MidiTracks
 } // namespace mu::iex::midi
@@ -31,6 +31,8 @@
 
 #include <vector>
 #include <cstddef>
+#include <functional>
+#include <map>
 #include <utility>
 
 // ---------------------------------------------------------------------------------------
@@ -162,6 +164,14 @@ ReducedFraction findBarStart(const ReducedFraction& time, const engraving::TimeS
 namespace MidiDuration {
 double durationCount(const QList<std::pair<ReducedFraction, engraving::TDuration> >& durations);
 } // namespace MidiDuration
+
+namespace MidiTracks {
+// call func for every track with chords, concurrently if possible
+// (serially if already running on a thread of the task scheduler);
+// func can modify its own track only and can only read the import operations;
+// the first exception thrown by func is rethrown after all tracks are processed
+void processInParallel(std::multimap<int, MTrack>& tracks, const std::function<void(MTrack&)>& func);
+} // namespace MidiTracks
 } // namespace mu::iex::midi
 
 #endif // IMPORTMIDI_INNER_H
@@ -310,6 +310,8 @@ bool Data::hasMidiFile(const QString& fileName)
     return _data.find(fileName) != _data.end();
 }
 
+thread_local int Data::_currentTrack = -1;
+
 int Data::currentTrack() const
 {
     Q_ASSERT_X(_currentTrack >= 0,
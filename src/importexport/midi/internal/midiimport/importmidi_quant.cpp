@@ -1101,6 +1101,17 @@ void applyDynamicProgramming(std::vector<QuantData>& quantData)
 
     for (size_t chordIndex = 0; chordIndex != quantData.size(); ++chordIndex) {
         QuantData& d = quantData[chordIndex];
+        const QuantData* dPrev = (chordIndex != 0) ? &quantData[chordIndex - 1] : nullptr;
+        const double mergePenalty = d.quant.toDouble() * MERGE_PENALTY_COEFF;
+
+        // positions of both chords are sorted by time, so the min penalty
+        // of the previous chord positions that are earlier than the current position
+        // can be accumulated while walking through the current positions:
+        // O(n) instead of O(n^2) time comparisons per chord
+        double minPrevPenalty = std::numeric_limits<double>::max();
+        int minPrevPos = -1;
+        size_t posPrev = 0;
+
         for (size_t pos = 0; pos != d.positions.size(); ++pos) {
             QuantPos& p = d.positions[pos];
 
@@ -1121,31 +1132,28 @@ void applyDynamicProgramming(std::vector<QuantData>& quantData)
                 }
             }
 
-            if (chordIndex == 0) {
+            if (!dPrev) {
                 continue;
             }
 
-            const QuantData& dPrev = quantData[chordIndex - 1];
-            double minPenalty = std::numeric_limits<double>::max();
-            int minPos = -1;
-
-            for (size_t posPrev = 0; posPrev != dPrev.positions.size(); ++posPrev) {
-                const QuantPos& pPrev = dPrev.positions[posPrev];
-                if (pPrev.time > p.time) {
-                    continue;
+            for (; posPrev != dPrev->positions.size() && dPrev->positions[posPrev].time < p.time; ++posPrev) {
+                if (dPrev->positions[posPrev].penalty < minPrevPenalty) {
+                    minPrevPenalty = dPrev->positions[posPrev].penalty;
+                    minPrevPos = static_cast<int>(posPrev);
                 }
+            }
+
+            double minPenalty = minPrevPenalty;
+            int minPos = minPrevPos;
 
-                double penalty = pPrev.penalty;
+            if (d.canMergeWithPrev && posPrev != dPrev->positions.size()) {
+                const QuantPos& pPrev = dPrev->positions[posPrev];
                 if (pPrev.time == p.time) {
-                    if (!d.canMergeWithPrev) {
-                        continue;
+                    const double penalty = pPrev.penalty + mergePenalty;
+                    if (penalty < minPenalty) {
+                        minPenalty = penalty;
+                        minPos = static_cast<int>(posPrev);
                     }
-                    penalty += d.quant.toDouble() * MERGE_PENALTY_COEFF;
-                }
-
-                if (penalty < minPenalty) {
-                    minPenalty = penalty;
-                    minPos = static_cast<int>(posPrev);
                 }
             }
 
@@ -285,15 +285,11 @@ void simplifyDurations(
 {
     auto& opers = midiImportOperations;
 
-    for (auto& track: tracks) {
-        MTrack& mtrack = track.second;
+    MidiTracks::processInParallel(tracks, [&opers, sigmap, simplifyDrumTracks](MTrack& mtrack) {
         if (mtrack.mtrack->drumTrack() != simplifyDrumTracks) {
-            continue;
-        }
-        auto& chords = track.second.chords;
-        if (chords.empty()) {
-            continue;
+            return;
         }
+        auto& chords = mtrack.chords;
 
         if (opers.data()->trackOpers.simplifyDurations.value(mtrack.indexOfOperation)) {
             MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
@@ -312,7 +308,7 @@ void simplifyDurations(
                                                       "or non-tuplet chord/note is inside tuplet after simplification");
 #endif
         }
-    }
+    });
 }
 
 void simplifyDurationsForDrums(std::multimap<int, MTrack>& tracks, const TimeSigMap* sigmap)
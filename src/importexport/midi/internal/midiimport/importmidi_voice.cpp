@@ -21,6 +21,8 @@
  */
 #include "importmidi_voice.h"
 
+#include <atomic>
+
 #include <QSet>
 
 #include "importmidi_tuplet.h"
@@ -1065,16 +1067,11 @@ void sortVoices(
 bool separateVoices(std::multimap<int, MTrack>& tracks, const TimeSigMap* sigmap)
 {
     auto& opers = midiImportOperations;
-    bool changed = false;
+    std::atomic<bool> changed { false };
 
-    for (auto& track: tracks) {
-        MTrack& mtrack = track.second;
+    MidiTracks::processInParallel(tracks, [&opers, sigmap, &changed](MTrack& mtrack) {
         if (mtrack.mtrack->drumTrack()) {
-            continue;
-        }
-        auto& chords = track.second.chords;
-        if (chords.empty()) {
-            continue;
+            return;
         }
         const auto userVoiceCount = toIntVoiceCount(
             opers.data()->trackOpers.maxVoiceCount.value(mtrack.indexOfOperation));
@@ -1115,7 +1112,7 @@ bool separateVoices(std::multimap<int, MTrack>& tracks, const TimeSigMap* sigmap
                                                     "after voice sort");
 #endif
         }
-    }
+    });
 
     return changed;
 }
@@ -39,6 +39,15 @@ public:
     virtual bool musicxmlImportLayout() const = 0;
     virtual void setMusicxmlImportLayout(bool value) = 0;
 
+    //! NOTE Schema - full validation against musicxml.xsd,
+    //! WellFormed - only check that the file is well-formed xml, No - no validation
+    enum class MusicxmlImportValidationMode {
+        Schema, WellFormed, No
+    };
+
+    virtual MusicxmlImportValidationMode musicxmlImportValidationMode() const = 0;
+    virtual void setMusicxmlImportValidationMode(MusicxmlImportValidationMode mode) = 0;
+
     virtual bool musicxmlExportLayout() const = 0;
     virtual void setMusicxmlExportLayout(bool value) = 0;
 
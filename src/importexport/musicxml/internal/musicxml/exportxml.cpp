@@ -40,11 +40,16 @@
 #include "exportxml.h"
 
 #include <math.h>
+#include <deque>
+#include <future>
+#include <memory>
+
 #include <QBuffer>
 #include <QDate>
 #include <QRegularExpression>
 
 #include "containers.h"
+#include "concurrency/taskscheduler.h"
 #include "io/iodevice.h"
 #include "io/buffer.h"
 #include "io/fileinfo.h"
@@ -278,6 +283,7 @@ class SlurHandler
 public:
     SlurHandler();
     void doSlurs(const ChordRest* chordRest, Notations& notations, XmlWriter& xml);
+    bool isEmpty() const;
 
 private:
     void doSlurStart(const Slur* s, Notations& notations, XmlWriter& xml);
@@ -298,6 +304,7 @@ public:
     GlissandoHandler();
     void doGlissandoStart(Glissando* gliss, Notations& notations, XmlWriter& xml);
     void doGlissandoStop(Glissando* gliss, Notations& notations, XmlWriter& xml);
+    bool isEmpty() const;
 };
 
 //---------------------------------------------------------
@@ -370,6 +377,8 @@ class ExportMusicXml
     TrillHash _trillStart;
     TrillHash _trillStop;
     MxmlInstrumentMap instrMap;
+    const KeySig* _defaultKeySig = nullptr;
+    bool _writePartsConcurrently = true;
 
     int findBracket(const TextLineBase* tl) const;
     int findDashes(const TextLineBase* tl) const;
@@ -405,7 +414,10 @@ class ExportMusicXml
                       const MeasurePrintContext& mpc, QSet<const Spanner*>& spannersStopped);
     void repeatAtMeasureStart(Attributes& attr, const Measure* const m, track_idx_t strack, track_idx_t etrack, track_idx_t track);
     void repeatAtMeasureStop(const Measure* const m, track_idx_t strack, track_idx_t etrack, track_idx_t track);
-    void writeParts();
+    void writePart(const size_t partIndex, const int staffCount);
+    void writePartToBuffer(const size_t partIndex, const int staffCount, std::unique_ptr<mu::io::Buffer>& buf);
+    bool hasPendingSpanners() const;
+    void writeParts(mu::io::IODevice* dev);
 
     static QString fermataPosition(const Fermata* const fermata);
     static QString elementPosition(const ExportMusicXml* const expMxml, const EngravingItem* const elm);
@@ -421,9 +433,18 @@ public:
         div = 1;
         tenths = 40;
         millimeters = _score->spatium() * tenths / (10 * DPMM);
+
+        for (int i = 0; i < MAX_NUMBER_LEVEL; ++i) {
+            brackets[i] = nullptr;
+            dashes[i] = nullptr;
+            hairpins[i] = nullptr;
+            ottavas[i] = nullptr;
+            trills[i] = nullptr;
+        }
     }
 
     void write(mu::io::IODevice* dev);
+    void setWritePartsConcurrently(bool arg) { _writePartsConcurrently = arg; }
     void credits(XmlWriter& xml);
     void moveToTick(const Fraction& t);
     void words(TextBase const* const text, staff_idx_t staff);
@@ -708,6 +729,20 @@ SlurHandler::SlurHandler()
     }
 }
 
+//---------------------------------------------------------
+//   isEmpty -- no slur is pending
+//---------------------------------------------------------
+
+bool SlurHandler::isEmpty() const
+{
+    for (int i = 0; i < MAX_NUMBER_LEVEL; ++i) {
+        if (slur[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static QString slurTieLineStyle(const SlurTie* s)
 {
     QString lineType;
@@ -963,6 +998,20 @@ GlissandoHandler::GlissandoHandler()
     }
 }
 
+//---------------------------------------------------------
+//   isEmpty -- no glissando or slide is pending
+//---------------------------------------------------------
+
+bool GlissandoHandler::isEmpty() const
+{
+    for (int i = 0; i < MAX_NUMBER_LEVEL; ++i) {
+        if (glissNote[i] || slideNote[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 //---------------------------------------------------------
 //   findNote -- get index of Note in note table for subtype type
 //   return -1 if not found
@@ -5926,12 +5975,7 @@ void ExportMusicXml::keysigTimesig(const Measure* m, const Part* p)
     } else {
         // always write a keysig at tick = 0
         if (m->tick().isZero()) {
-            //KeySigEvent kse;
-            //kse.setKey(Key::C);
-            KeySig* ks = Factory::createKeySig(_score->dummy()->segment());
-            ks->setKey(Key::C);
-            keysig(ks, p->staff(0)->clef(m->tick()));
-            delete ks;
+            keysig(_defaultKeySig, p->staff(0)->clef(m->tick()));
         }
     }
 
@@ -7173,75 +7217,273 @@ void MeasurePrintContext::measureWritten(const Measure* m)
 }
 
 //---------------------------------------------------------
-//  writeParts
+//  writePart
 //---------------------------------------------------------
 
 /**
- Write all parts.
+ Write part \a partIndex, whose first staff is \a staffCount.
  */
 
-void ExportMusicXml::writeParts()
+void ExportMusicXml::writePart(const size_t partIndex, const int staffCount)
 {
-    int staffCount = 0;
-    const auto& parts = _score->parts();
-
-    for (size_t partIndex = 0; partIndex < parts.size(); ++partIndex) {
-        const auto part = parts.at(partIndex);
-        _tick = { 0, 1 };
-        _xml.startElementRaw(QString("part id=\"P%1\"").arg(partIndex + 1));
+    const auto part = _score->parts().at(partIndex);
+    _tick = { 0, 1 };
+    _xml.startElementRaw(QString("part id=\"P%1\"").arg(partIndex + 1));
 
-        _trillStart.clear();
-        _trillStop.clear();
-        initInstrMap(instrMap, part->instruments(), _score);
+    _trillStart.clear();
+    _trillStop.clear();
+    initInstrMap(instrMap, part->instruments(), _score);
 
-        MeasureNumberStateHandler mnsh;
-        FigBassMap fbMap;                     // pending figured bass extends
+    MeasureNumberStateHandler mnsh;
+    FigBassMap fbMap;                     // pending figured bass extends
 
-        // set of spanners already stopped in this part
-        // required to prevent multiple spanner stops for the same spanner
-        QSet<const Spanner*> spannersStopped;
+    // set of spanners already stopped in this part
+    // required to prevent multiple spanner stops for the same spanner
+    QSet<const Spanner*> spannersStopped;
 
-        const auto& pages = _score->pages();
-        MeasurePrintContext mpc;
+    const auto& pages = _score->pages();
+    MeasurePrintContext mpc;
 
-        for (size_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex) {
-            const auto page = pages.at(pageIndex);
-            mpc.pageStart = true;
-            const auto& systems = page->systems();
+    for (size_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex) {
+        const auto page = pages.at(pageIndex);
+        mpc.pageStart = true;
+        const auto& systems = page->systems();
 
-            for (int systemIndex = 0; systemIndex < static_cast<int>(systems.size()); ++systemIndex) {
-                const auto system = systems.at(systemIndex);
-                mpc.systemStart = true;
+        for (int systemIndex = 0; systemIndex < static_cast<int>(systems.size()); ++systemIndex) {
+            const auto system = systems.at(systemIndex);
+            mpc.systemStart = true;
 
-                for (const auto mb : system->measures()) {
-                    if (!mb->isMeasure()) {
-                        continue;
-                    }
-                    const auto m = toMeasure(mb);
-
-                    if (m->isMMRest()) {
-                        // in case of a multimeasure rest (which is a single measure in MuseScore), write the measure range it replaces
-                        const auto m2 = m->mmRestLast()->nextMeasure();
-                        for (auto m1 = m->mmRestFirst(); m1 != m2; m1 = m1->nextMeasure()) {
-                            if (m1->isMeasure()) {
-                                writeMeasure(m1, static_cast<int>(partIndex), staffCount, mnsh, fbMap, mpc, spannersStopped);
-                                mpc.measureWritten(m1);
-                            }
+            for (const auto mb : system->measures()) {
+                if (!mb->isMeasure()) {
+                    continue;
+                }
+                const auto m = toMeasure(mb);
+
+                if (m->isMMRest()) {
+                    // in case of a multimeasure rest (which is a single measure in MuseScore), write the measure range it replaces
+                    const auto m2 = m->mmRestLast()->nextMeasure();
+                    for (auto m1 = m->mmRestFirst(); m1 != m2; m1 = m1->nextMeasure()) {
+                        if (m1->isMeasure()) {
+                            writeMeasure(m1, static_cast<int>(partIndex), staffCount, mnsh, fbMap, mpc, spannersStopped);
+                            mpc.measureWritten(m1);
                         }
-                    } else {
-                        // write the measure (or, if measure repeat, the "underlying" measure that it indicates for the musician to play)
-                        writeMeasure(m, static_cast<int>(partIndex), staffCount, mnsh, fbMap, mpc, spannersStopped);
-                        mpc.measureWritten(m);
                     }
+                } else {
+                    // write the measure (or, if measure repeat, the "underlying" measure that it indicates for the musician to play)
+                    writeMeasure(m, static_cast<int>(partIndex), staffCount, mnsh, fbMap, mpc, spannersStopped);
+                    mpc.measureWritten(m);
                 }
-                mpc.prevSystem = system;
             }
-            mpc.lastSystemPrevPage = mpc.prevSystem;
+            mpc.prevSystem = system;
+        }
+        mpc.lastSystemPrevPage = mpc.prevSystem;
+    }
+
+    _xml.endElement();
+}
+
+//---------------------------------------------------------
+//  canWritePartsConcurrently
+//---------------------------------------------------------
+
+static void checkTextIsUpToDate(void* data, EngravingItem* e)
+{
+    if (e->isTextBase()) {
+        const TextBase* text = toTextBase(e);
+        if (text->isTextInvalid() || text->isLayoutInvalid()) {
+            *static_cast<bool*>(data) = false;
         }
+    }
+}
 
+/**
+ Parts can only be written concurrently if exporting them does not modify the score.
+ Texts with invalid text or layout are cloned by xmlText() and plainText(), and cloning
+ adds the clone to the children of the (shared) parent, so in that case write serially.
+ */
+
+static bool canWritePartsConcurrently(Score* score)
+{
+    bool upToDate = true;
+    score->scanElements(&upToDate, checkTextIsUpToDate, true);
+    return upToDate;
+}
+
+//---------------------------------------------------------
+//  resolveSpannerElements
+//---------------------------------------------------------
+
+/**
+ The start and end elements of spanners are looked up and cached on first access,
+ do it before the parts are written concurrently.
+ */
+
+static void resolveSpannerElements(Score* score)
+{
+    for (auto it = score->spanner().cbegin(); it != score->spanner().cend(); ++it) {
+        Spanner* sp = it->second;
+        switch (sp->anchor()) {
+        case Spanner::Anchor::CHORD:
+            sp->startChord();
+            sp->endChord();
+            sp->startCR();
+            sp->endCR();
+            break;
+        case Spanner::Anchor::SEGMENT:
+            sp->startCR();
+            sp->endCR();
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//  hasPendingSpanners
+//---------------------------------------------------------
+
+/**
+ Return true if spanners have been started but not stopped yet,
+ that is if the next part depends on the state left by the written parts.
+ */
+
+bool ExportMusicXml::hasPendingSpanners() const
+{
+    for (int i = 0; i < MAX_NUMBER_LEVEL; ++i) {
+        if (brackets[i] || dashes[i] || hairpins[i] || ottavas[i] || trills[i]) {
+            return true;
+        }
+    }
+    return !sh.isEmpty() || !gh.isEmpty();
+}
+
+//---------------------------------------------------------
+//  writePartToBuffer
+//---------------------------------------------------------
+
+/**
+ Write part \a partIndex into a new buffer \a buf, continuing the state of this exporter.
+ On the first call the (unterminated) score-partwise start tag is written first,
+ which makes the part indented as in the complete document; it is not part of \a buf.
+ */
+
+void ExportMusicXml::writePartToBuffer(const size_t partIndex, const int staffCount, std::unique_ptr<mu::io::Buffer>& buf)
+{
+    auto partBuf = std::make_unique<mu::io::Buffer>();
+    partBuf->open(mu::io::IODevice::WriteOnly);
+
+    if (!buf) {
+        mu::io::Buffer startBuf;
+        startBuf.open(mu::io::IODevice::WriteOnly);
+        _xml.setDevice(&startBuf);
+        _xml.startElement("score-partwise");
+        _xml.flush();
+    } else {
+        _xml.flush();
+    }
+
+    _xml.setDevice(partBuf.get());
+    buf = std::move(partBuf);
+
+    writePart(partIndex, staffCount);
+    _xml.flush();
+}
+
+//---------------------------------------------------------
+//  writeParts
+//---------------------------------------------------------
+
+/**
+ Write all parts to \a dev.
+
+ The parts are written in order by one exporter, the spanners started in a part
+ can be stopped in a following part. If possible, every part is written concurrently
+ by its own exporter, starting with a fresh state. That is only the same as writing
+ it in order if no spanners are pending after the previous part; otherwise the part
+ is written again by the exporter of the previous part, continuing its state.
+ At most a few parts per thread are kept in memory at the same time.
+ */
+
+void ExportMusicXml::writeParts(mu::io::IODevice* dev)
+{
+    const auto& parts = _score->parts();
+
+    std::vector<int> staffCounts;
+    int staffCount = 0;
+    for (const Part* part : parts) {
+        staffCounts.push_back(staffCount);
         staffCount += static_cast<int>(part->nstaves());
-        _xml.endElement();
     }
+
+    // always write a keysig at tick = 0
+    // create it beforehand, as creating an item modifies its (shared) parent
+    std::unique_ptr<KeySig> defaultKeySig(Factory::createKeySig(_score->dummy()->segment()));
+    defaultKeySig->setKey(Key::C);
+    _defaultKeySig = defaultKeySig.get();
+
+    const size_t threadCount = TaskScheduler::instance()->threadPoolSize();
+    if (!_writePartsConcurrently || parts.size() < 2 || threadCount < 2 || !canWritePartsConcurrently(_score)) {
+        for (size_t partIndex = 0; partIndex < parts.size(); ++partIndex) {
+            writePart(partIndex, staffCounts.at(partIndex));
+        }
+        _defaultKeySig = nullptr;
+        return;
+    }
+
+    resolveSpannerElements(_score);
+
+    _xml.flush();
+
+    struct PartWriter {
+        std::unique_ptr<ExportMusicXml> exporter;
+        std::unique_ptr<mu::io::Buffer> buffer;
+    };
+
+    auto writeBuffer = [dev](const PartWriter& writer) {
+        const ByteArray& data = writer.buffer->data();
+        dev->write(data.constData(), data.size());
+    };
+
+    const size_t maxPendingParts = 2 * threadCount;
+    std::deque<std::future<std::shared_ptr<PartWriter> > > pendingParts;
+    std::shared_ptr<PartWriter> prevWriter;
+    size_t nextPart = 0;
+
+    for (size_t partIndex = 0; partIndex < parts.size(); ++partIndex) {
+        while (nextPart < parts.size() && pendingParts.size() < maxPendingParts) {
+            const int partStaffCount = staffCounts.at(nextPart);
+            pendingParts.push_back(TaskScheduler::instance()->submit([this, partIndex = nextPart, partStaffCount]() {
+                auto writer = std::make_shared<PartWriter>();
+                writer->exporter = std::make_unique<ExportMusicXml>(_score);
+                writer->exporter->div = div;
+                writer->exporter->_jumpElements = _jumpElements;
+                writer->exporter->_defaultKeySig = _defaultKeySig;
+                writer->exporter->writePartToBuffer(partIndex, partStaffCount, writer->buffer);
+                return writer;
+            }));
+            ++nextPart;
+        }
+
+        std::shared_ptr<PartWriter> writer = pendingParts.front().get();
+        pendingParts.pop_front();
+
+        if (prevWriter && prevWriter->exporter->hasPendingSpanners()) {
+            // the part written from a fresh state is not valid, write it again in order
+            prevWriter->exporter->writePartToBuffer(partIndex, staffCounts.at(partIndex), prevWriter->buffer);
+        } else {
+            prevWriter = writer;
+        }
+
+        writeBuffer(*prevWriter);
+    }
+
+    //! NOTE Wait for the remaining parts, they still use the score
+    for (auto& part : pendingParts) {
+        part.wait();
+    }
+
+    _defaultKeySig = nullptr;
 }
 
 //---------------------------------------------------------
@@ -7286,14 +7528,6 @@ void ExportMusicXml::write(mu::io::IODevice* dev)
 
     calcDivisions();
 
-    for (int i = 0; i < MAX_NUMBER_LEVEL; ++i) {
-        brackets[i] = nullptr;
-        dashes[i] = nullptr;
-        hairpins[i] = nullptr;
-        ottavas[i] = nullptr;
-        trills[i] = nullptr;
-    }
-
     _jumpElements = findJumpElements(_score);
 
     _xml.setDevice(dev);
@@ -7311,7 +7545,7 @@ void ExportMusicXml::write(mu::io::IODevice* dev)
     }
 
     partList(_xml, _score, instrMap);
-    writeParts();
+    writeParts(dev);
 
     _xml.endElement();
 
@@ -7332,16 +7566,22 @@ void ExportMusicXml::write(mu::io::IODevice* dev)
  Return false on error.
  */
 
-bool saveXml(Score* score, QIODevice* device)
+bool saveXml(Score* score, QIODevice* device, bool writePartsConcurrently)
 {
     mu::io::Buffer buf;
     buf.open(mu::io::IODevice::WriteOnly);
     ExportMusicXml em(score);
+    em.setWritePartsConcurrently(writePartsConcurrently);
     em.write(&buf);
     device->write(buf.data().toQByteArrayNoCopy());
     return true;
 }
 
+bool saveXml(Score* score, QIODevice* device)
+{
+    return saveXml(score, device, true);
+}
+
 bool saveXml(Score* score, const QString& name)
 {
     QFile f(name);
@@ -33,6 +33,7 @@ class Score;
 
 bool saveMxl(Score*, QIODevice*);
 bool saveXml(Score*, QIODevice*);
+bool saveXml(Score*, QIODevice*, bool writePartsConcurrently);
 bool saveXml(Score*, const QString&);
 }
 
@@ -57,7 +57,7 @@ static int musicXMLImportErrorDialog(QString text, QString detailedText)
 //   importMusicXMLfromBuffer
 //---------------------------------------------------------
 
-Err importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev)
+Err importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev, const std::function<Err()>& checkValidation)
 {
     //LOGD("importMusicXMLfromBuffer(score %p, name '%s', dev %p)",
     //       score, qPrintable(name), dev);
@@ -73,6 +73,13 @@ Err importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* d
     Err res = pass1.parse(dev);
     const auto pass1_errors = pass1.errors();
 
+    if (res == Err::NoError && checkValidation) {
+        res = checkValidation();
+        if (res != Err::NoError) {
+            return res;
+        }
+    }
+
     // pass 2
     MusicXMLParserPass2 pass2(score, pass1, &logger);
     if (res == Err::NoError) {
@@ -23,6 +23,8 @@
 #ifndef __IMPORTMXML_H__
 #define __IMPORTMXML_H__
 
+#include <functional>
+
 #include "engravingerrors.h"
 
 class QString;
@@ -31,7 +33,8 @@ class QIODevice;
 namespace mu::engraving {
 class Score;
 
-Err importMusicXMLfromBuffer(Score* score, const QString&, QIODevice* dev);
+//! NOTE checkValidation is called after the first pass, the import is stopped if it returns an error
+Err importMusicXMLfromBuffer(Score* score, const QString&, QIODevice* dev, const std::function<Err()>& checkValidation = nullptr);
 }
 
 #endif
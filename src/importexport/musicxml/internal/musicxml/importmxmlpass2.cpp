@@ -1614,6 +1614,8 @@ Err MusicXMLParserPass2::parse()
 
 void MusicXMLParserPass2::scorePartwise()
 {
+    initMeasureIndex();
+
     while (_e.readNextStartElement()) {
         if (_e.name() == "part") {
             part();
@@ -1802,21 +1804,35 @@ void MusicXMLParserPass2::part()
 }
 
 //---------------------------------------------------------
-//   findMeasure
+//   initMeasureIndex
 //---------------------------------------------------------
 
 /**
- In Score \a score find the measure starting at \a tick.
+ Index the measures created in pass 1 by start tick.
+ Measures are looked up once per part, so a linear search
+ would be quadratic in the number of measures for every part.
  */
 
-static Measure* findMeasure(Score* score, const Fraction& tick)
+void MusicXMLParserPass2::initMeasureIndex()
 {
-    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
-        if (m->tick() == tick) {
-            return m;
-        }
+    _measures.clear();
+    for (Measure* m = _score->firstMeasure(); m; m = m->nextMeasure()) {
+        _measures.emplace(m->tick(), m);
     }
-    return 0;
+}
+
+//---------------------------------------------------------
+//   findMeasure
+//---------------------------------------------------------
+
+/**
+ Find the measure starting at \a tick.
+ */
+
+Measure* MusicXMLParserPass2::findMeasure(const Fraction& tick) const
+{
+    auto it = _measures.find(tick);
+    return it != _measures.end() ? it->second : nullptr;
 }
 
 //---------------------------------------------------------
@@ -2038,7 +2054,7 @@ void MusicXMLParserPass2::measure(const QString& partId, const Fraction time)
 
     //LOGD("measure %d start", parsedMeasureNumber);
 
-    Measure* measure = findMeasure(_score, time);
+    Measure* measure = findMeasure(time);
     if (!measure) {
         _logger->logError(QString("measure at tick %1 not found!").arg(time.ticks()), &_e);
         skipLogCurrElem();
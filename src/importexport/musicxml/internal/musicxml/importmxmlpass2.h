@@ -24,6 +24,7 @@
 #define __IMPORTMXMLPASS2_H__
 
 #include <array>
+#include <map>
 
 #include "importmxmlpass1.h"
 #include "importxmlfirstpass.h"
@@ -301,6 +302,8 @@ private:
     void staffDetails(const QString& partId);
     void staffTuning(StringData* t);
     void skipLogCurrElem();
+    void initMeasureIndex();
+    Measure* findMeasure(const Fraction& tick) const;
 
     // multi-measure rest state handling
     void setMultiMeasureRestCount(int count);
@@ -314,6 +317,7 @@ private:
     MusicXMLParserPass1& _pass1;          // the pass1 results
     MxmlLogger* _logger;                  ///< Error logger
     QString _errors;                      ///< Errors to present to the user
+    std::map<Fraction, Measure*> _measures;  ///< Measures created in pass 1, by start tick
 
     // part specific data (TODO: move to part-specific class)
 
@@ -24,18 +24,25 @@
  MusicXML import.
  */
 
+#include <future>
+
 #include <QBuffer>
 #include <QDomDocument>
 #include <QMessageBox>
 #include <QXmlSchema>
 #include <QXmlSchemaValidator>
+#include <QXmlStreamReader>
 
 #include "importmxml.h"
 #include "musicxmlsupport.h"
 
 #include "translation.h"
 
-#include "global/deprecated/qzipreader_p.h"
+#include "serialization/zipreader.h"
+#include "concurrency/taskscheduler.h"
+#include "modularity/ioc.h"
+
+#include "importexport/musicxml/imusicxmlconfiguration.h"
 
 #include "engraving/types/types.h"
 
@@ -66,6 +73,53 @@ static_assert(int(DurationType::V_BREVE) == int(DurationType::V_LONG) + 1
               && int(DurationType::V_512TH) == int(DurationType::V_256TH) + 1
               && int(DurationType::V_1024TH) == int(DurationType::V_512TH) + 1);
 
+static std::shared_ptr<mu::iex::musicxml::IMusicXmlConfiguration> configuration()
+{
+    return mu::modularity::ioc()->resolve<mu::iex::musicxml::IMusicXmlConfiguration>("iex_musicxml");
+}
+
+using ValidationMode = mu::iex::musicxml::IMusicXmlConfiguration::MusicxmlImportValidationMode;
+
+static ValidationMode musicxmlImportValidationMode()
+{
+    auto conf = configuration();
+    return conf ? conf->musicxmlImportValidationMode() : ValidationMode::Schema;
+}
+
+//---------------------------------------------------------
+//   musicXmlSchemaData
+//    read once, empty on error
+//---------------------------------------------------------
+
+static const QByteArray& musicXmlSchemaData()
+{
+    static const QByteArray schemaBa = []() {
+        // read the MusicXML schema from the application resources
+        QFile schemaFile(":/schema/musicxml.xsd");
+        if (!schemaFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            LOGE("initMusicXmlSchema() could not open resource musicxml.xsd");
+            return QByteArray();
+        }
+
+        // copy the schema into a QByteArray and fixup xs:imports,
+        // using a path to the application resources instead of to www.musicxml.org
+        // to prevent downloading from the net
+        QByteArray ba;
+        QTextStream schemaStream(&schemaFile);
+        while (!schemaStream.atEnd()) {
+            QString line = schemaStream.readLine();
+            if (line.contains("xs:import")) {
+                line.replace("http://www.musicxml.org/xsd", "qrc:///schema");
+            }
+            ba += line.toUtf8();
+            ba += "\n";
+        }
+        return ba;
+    }();
+
+    return schemaBa;
+}
+
 //---------------------------------------------------------
 //   initMusicXmlSchema
 //    return false on error
@@ -73,27 +127,11 @@ static_assert(int(DurationType::V_BREVE) == int(DurationType::V_LONG) + 1
 
 static bool initMusicXmlSchema(QXmlSchema& schema)
 {
-    // read the MusicXML schema from the application resources
-    QFile schemaFile(":/schema/musicxml.xsd");
-    if (!schemaFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        LOGE("initMusicXmlSchema() could not open resource musicxml.xsd");
+    const QByteArray& schemaBa = musicXmlSchemaData();
+    if (schemaBa.isEmpty()) {
         return false;
     }
 
-    // copy the schema into a QByteArray and fixup xs:imports,
-    // using a path to the application resources instead of to www.musicxml.org
-    // to prevent downloading from the net
-    QByteArray schemaBa;
-    QTextStream schemaStream(&schemaFile);
-    while (!schemaStream.atEnd()) {
-        QString line = schemaStream.readLine();
-        if (line.contains("xs:import")) {
-            line.replace("http://www.musicxml.org/xsd", "qrc:///schema");
-        }
-        schemaBa += line.toUtf8();
-        schemaBa += "\n";
-    }
-
     // load and validate the schema
     schema.load(schemaBa);
     if (!schema.isValid()) {
@@ -104,6 +142,29 @@ static bool initMusicXmlSchema(QXmlSchema& schema)
     return true;
 }
 
+//---------------------------------------------------------
+//   musicXmlSchema
+//    compiled once per thread (QXmlSchema is reentrant, but not thread-safe),
+//    return nullptr on error
+//---------------------------------------------------------
+
+static const QXmlSchema* musicXmlSchema()
+{
+    thread_local std::unique_ptr<QXmlSchema> schema;
+    thread_local bool initialized = false;
+
+    if (!initialized) {
+        initialized = true;
+
+        auto newSchema = std::make_unique<QXmlSchema>();
+        if (initMusicXmlSchema(*newSchema)) {
+            schema = std::move(newSchema);
+        }
+    }
+
+    return schema.get();
+}
+
 //---------------------------------------------------------
 //   musicXMLValidationErrorDialog
 //---------------------------------------------------------
@@ -136,8 +197,9 @@ Extract rootfile from compressed MusicXML file \a qf, return true if OK and fals
 
 static bool extractRootfile(QFile* qf, QByteArray& data)
 {
-    MQZipReader f(qf->fileName());
-    data = f.fileData("META-INF/container.xml");
+    //! NOTE The archive is memory mapped, the entries are read in place
+    ZipReader f(qf->fileName());
+    data = f.fileDataView("META-INF/container.xml").toQByteArray();
 
     QDomDocument container;
     int line, column;
@@ -177,7 +239,7 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
     }
 
     // read the rootfile
-    data = f.fileData(rootfile);
+    data = f.fileDataView(rootfile.toStdString()).toQByteArray();
     return true;
 }
 
@@ -185,34 +247,77 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
 //   doValidate
 //---------------------------------------------------------
 
+struct ValidationResult {
+    Err err = Err::NoError;
+    bool valid = true;
+    QString errors;
+};
+
 /**
- Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ Validate MusicXML data from file \a name contained in \a data.
+ Doesn't use the GUI, so can be called in any thread.
  */
 
-static Err doValidate(const QString& name, QIODevice* dev)
+static ValidationResult doValidate(const QString& name, const QByteArray& data, ValidationMode mode)
 {
-    //QElapsedTimer t;
-    //t.start();
-
-    // initialize the schema
-    ValidatorMessageHandler messageHandler;
-    QXmlSchema schema;
-    schema.setMessageHandler(&messageHandler);
-    if (!initMusicXmlSchema(schema)) {
-        return Err::FileBadFormat;      // appropriate error message has been printed by initMusicXmlSchema
+    TRACEFUNC;
+
+    ValidationResult result;
+
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+
+    switch (mode) {
+    case ValidationMode::Schema: {
+        const QXmlSchema* schema = musicXmlSchema();
+        if (!schema) {
+            result.err = Err::FileBadFormat;      // appropriate error message has been printed by initMusicXmlSchema
+            return result;
+        }
+
+        ValidatorMessageHandler messageHandler;
+        QXmlSchemaValidator validator(*schema);
+        validator.setMessageHandler(&messageHandler);
+        result.valid = validator.validate(&buffer, QUrl::fromLocalFile(name));
+        result.errors = messageHandler.getErrors();
+    } break;
+    case ValidationMode::WellFormed: {
+        QXmlStreamReader reader(&buffer);
+        while (!reader.atEnd()) {
+            reader.readNext();
+        }
+
+        if (reader.hasError()) {
+            result.valid = false;
+            result.errors = errorStringWithLocation(static_cast<int>(reader.lineNumber()), static_cast<int>(reader.columnNumber()),
+                                                    reader.errorString());
+        }
+    } break;
+    case ValidationMode::No:
+        break;
     }
-    // validate the data
-    QXmlSchemaValidator validator(schema);
-    bool valid = validator.validate(dev, QUrl::fromLocalFile(name));
-    //LOGD("Validation time elapsed: %d ms", t.elapsed());
 
-    if (!valid) {
+    return result;
+}
+
+//---------------------------------------------------------
+//   checkValidationResult
+//---------------------------------------------------------
+
+static Err checkValidationResult(const QString& name, const ValidationResult& result)
+{
+    if (result.err != Err::NoError) {
+        return result.err;
+    }
+
+    if (!result.valid) {
         LOGD("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
         QString strErr = qtrc("iex_musicxml", "File '%1' is not a valid MusicXML file.").arg(name);
         if (MScore::noGui) {
             return Err::NoError;         // might as well try anyhow in converter mode
         }
-        if (musicXMLValidationErrorDialog(strErr, messageHandler.getErrors()) != QMessageBox::Yes) {
+        if (musicXMLValidationErrorDialog(strErr, result.errors) != QMessageBox::Yes) {
             return Err::UserAbort;
         }
     }
@@ -230,14 +335,31 @@ static Err doValidate(const QString& name, QIODevice* dev)
 
 static Err doValidateAndImport(Score* score, const QString& name, QIODevice* dev)
 {
-    // validate the file
-    Err res = doValidate(name, dev);
-    if (res != Err::NoError) {
-        return res;
+    const ValidationMode mode = musicxmlImportValidationMode();
+    if (mode == ValidationMode::No) {
+        return importMusicXMLfromBuffer(score, name, dev);
     }
 
+    //! NOTE The validation runs in a worker thread on a copy of the data, in parallel with the first pass of the import.
+    //! Its result is checked (and the user is asked what to do with an invalid file) before the second pass
+    dev->seek(0);
+    const QByteArray data = dev->readAll();
+    std::future<ValidationResult> validation = TaskScheduler::instance()->submit(doValidate, name, data, mode);
+
     // actually do the import
-    res = importMusicXMLfromBuffer(score, name, dev);
+    bool validationChecked = false;
+    Err res = importMusicXMLfromBuffer(score, name, dev, [&name, &validation, &validationChecked]() {
+        validationChecked = true;
+        return checkValidationResult(name, validation.get());
+    });
+
+    //! NOTE If the first pass failed, the validation errors explain the failure better than the import error
+    if (!validationChecked) {
+        Err validationRes = checkValidationResult(name, validation.get());
+        if (validationRes != Err::NoError) {
+            return validationRes;
+        }
+    }
     //LOGD("res %d", static_cast<int>(res));
     return res;
 }
@@ -30,6 +30,7 @@ static const std::string module_name("iex_musicxml");
 
 static const Settings::Key MUSICXML_IMPORT_BREAKS_KEY(module_name, "import/musicXML/importBreaks");
 static const Settings::Key MUSICXML_IMPORT_LAYOUT_KEY(module_name, "import/musicXML/importLayout");
+static const Settings::Key MUSICXML_IMPORT_VALIDATION_MODE_KEY(module_name, "import/musicXML/validationMode");
 static const Settings::Key MUSICXML_EXPORT_LAYOUT_KEY(module_name, "export/musicXML/exportLayout");
 static const Settings::Key MUSICXML_EXPORT_BREAKS_TYPE_KEY(module_name, "export/musicXML/exportBreaks");
 static const Settings::Key MUSICXML_EXPORT_INVISIBLE_ELEMENTS_KEY(module_name, "export/musicXML/exportInvisibleElements");
@@ -40,6 +41,7 @@ void MusicXmlConfiguration::init()
 {
     settings()->setDefaultValue(MUSICXML_IMPORT_BREAKS_KEY, Val(true));
     settings()->setDefaultValue(MUSICXML_IMPORT_LAYOUT_KEY, Val(true));
+    settings()->setDefaultValue(MUSICXML_IMPORT_VALIDATION_MODE_KEY, Val(MusicxmlImportValidationMode::Schema));
     settings()->setDefaultValue(MUSICXML_EXPORT_LAYOUT_KEY, Val(true));
     settings()->setDefaultValue(MUSICXML_EXPORT_BREAKS_TYPE_KEY, Val(MusicxmlExportBreaksType::All));
     settings()->setDefaultValue(MUSICXML_EXPORT_INVISIBLE_ELEMENTS_KEY, Val(false));
@@ -66,6 +68,16 @@ void MusicXmlConfiguration::setMusicxmlImportLayout(bool value)
     settings()->setSharedValue(MUSICXML_IMPORT_LAYOUT_KEY, Val(value));
 }
 
+MusicXmlConfiguration::MusicxmlImportValidationMode MusicXmlConfiguration::musicxmlImportValidationMode() const
+{
+    return settings()->value(MUSICXML_IMPORT_VALIDATION_MODE_KEY).toEnum<MusicxmlImportValidationMode>();
+}
+
+void MusicXmlConfiguration::setMusicxmlImportValidationMode(MusicxmlImportValidationMode mode)
+{
+    settings()->setSharedValue(MUSICXML_IMPORT_VALIDATION_MODE_KEY, Val(mode));
+}
+
 bool MusicXmlConfiguration::musicxmlExportLayout() const
 {
     return settings()->value(MUSICXML_EXPORT_LAYOUT_KEY).toBool();
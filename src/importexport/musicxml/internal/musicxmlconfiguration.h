@@ -36,6 +36,9 @@ public:
     bool musicxmlImportLayout() const override;
     void setMusicxmlImportLayout(bool value) override;
 
+    MusicxmlImportValidationMode musicxmlImportValidationMode() const override;
+    void setMusicxmlImportValidationMode(MusicxmlImportValidationMode mode) override;
+
     bool musicxmlExportLayout() const override;
     void setMusicxmlExportLayout(bool value) override;
 
@@ -22,7 +22,10 @@
 
 #include <gtest/gtest.h>
 
+#include <QBuffer>
+
 #include "engraving/engravingerrors.h"
+#include "engraving/compat/scoreaccess.h"
 #include "engraving/libmscore/masterscore.h"
 
 #include "settings.h"
@@ -53,6 +56,7 @@ static const std::string PREF_EXPORT_MUSICXML_EXPORTBREAKS("export/musicXML/expo
 static const std::string PREF_IMPORT_MUSICXML_IMPORTBREAKS("import/musicXML/importBreaks");
 static const std::string PREF_EXPORT_MUSICXML_EXPORTLAYOUT("export/musicXML/exportLayout");
 static const std::string PREF_EXPORT_MUSICXML_EXPORTINVISIBLE("export/musicXML/exportInvisibleElements");
+static const Settings::Key PREF_IMPORT_MUSICXML_VALIDATIONMODE("iex_musicxml", "import/musicXML/validationMode");
 
 //---------------------------------------------------------
 //   TestMxmlIO
@@ -937,3 +941,46 @@ TEST_F(Musicxml_Tests, words1) {
 TEST_F(Musicxml_Tests, words2) {
     mxmlIoTest("testWords2");
 }
+
+TEST_F(Musicxml_Tests, importFailsInFirstPass) {
+    //! NOTE Neither well formed nor valid, and the first pass of the import fails on it
+    String path = ScoreRW::rootPath() + u"/" + XML_IO_DATA_DIR + u"testNotPartwise.xml";
+
+    using ValidationMode = IMusicXmlConfiguration::MusicxmlImportValidationMode;
+    for (ValidationMode mode : { ValidationMode::Schema, ValidationMode::WellFormed, ValidationMode::No }) {
+        settings()->setSharedValue(PREF_IMPORT_MUSICXML_VALIDATIONMODE, Val(mode));
+
+        MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+        EXPECT_EQ(mu::engraving::importMusicXml(score, path.toQString()), engraving::Err::FileBadFormat);
+        delete score;
+    }
+
+    settings()->setSharedValue(PREF_IMPORT_MUSICXML_VALIDATIONMODE, Val(ValidationMode::Schema));
+}
+
+TEST_F(Musicxml_Tests, exportCrossPartSpannersConcurrently) {
+    //! [GIVEN] A score with a slur and a hairpin that start in the first part and stop in the second one
+    MScore::debugMode = true;
+    setValue(PREF_EXPORT_MUSICXML_EXPORTLAYOUT, Val(false));
+
+    MasterScore* score = readScore(XML_IO_DATA_DIR + u"testCrossPartSpanners.mscx");
+    ASSERT_TRUE(score);
+    fixupScore(score);
+    score->doLayout();
+
+    //! DO Export it with the parts written in order and concurrently
+    QBuffer serial;
+    serial.open(QIODevice::WriteOnly);
+    EXPECT_TRUE(saveXml(score, &serial, false));
+
+    QBuffer concurrent;
+    concurrent.open(QIODevice::WriteOnly);
+    EXPECT_TRUE(saveXml(score, &concurrent, true));
+
+    //! CHECK The spanners are stopped in the second part and both exports are identical
+    EXPECT_TRUE(serial.data().contains("<slur type=\"stop\""));
+    EXPECT_TRUE(serial.data().contains("<wedge type=\"stop\""));
+    EXPECT_EQ(serial.data(), concurrent.data());
+
+    delete score;
+}
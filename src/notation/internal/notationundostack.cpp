@@ -23,6 +23,7 @@
 #include "notationundostack.h"
 
 #include "log.h"
+#include "editlatencyprobe.h"
 
 #include "libmscore/masterscore.h"
 #include "libmscore/undo.h"
@@ -101,6 +102,8 @@ void NotationUndoStack::prepareChanges()
         return;
     }
 
+    EditLatencyProbe::instance()->beginEdit();
+
     score()->startCmd();
 }
 
@@ -116,6 +119,8 @@ void NotationUndoStack::rollbackChanges()
 
     score()->endCmd(true);
     masterScore()->setSaved(isStackClean());
+
+    EditLatencyProbe::instance()->endEdit(true);
 }
 
 void NotationUndoStack::commitChanges()
@@ -132,6 +137,8 @@ void NotationUndoStack::commitChanges()
     masterScore()->setSaved(isStackClean());
 
     notifyAboutStateChanged();
+
+    EditLatencyProbe::instance()->endEdit(false);
 }
 
 void NotationUndoStack::lock()
@@ -31,6 +31,7 @@ class MsczReaderMock : public project::IMscMetaReader
 {
 public:
     MOCK_METHOD(RetVal<project::ProjectMeta>, readMeta, (const io::path_t& filePath), (const, override));
+    MOCK_METHOD(RetVal<project::ProjectMeta>, readMeta, (const io::path_t& filePath, ByteArray& thumbnailData), (const, override));
 };
 }
 
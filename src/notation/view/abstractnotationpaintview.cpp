@@ -24,6 +24,7 @@
 #include <QPainter>
 
 #include "actions/actiontypes.h"
+#include "editlatencyprobe.h"
 
 #include "log.h"
 
@@ -494,6 +495,9 @@ void AbstractNotationPaintView::paint(QPainter* qp)
 {
     TRACEFUNC;
 
+    //! NOTE Finishes the measurement of the edit that caused this repaint
+    EDIT_LATENCY_REPAINT(isMainView());
+
     mu::draw::Painter mup(qp, objectName().toStdString());
     mu::draw::Painter* painter = &mup;
 
@@ -27,6 +27,7 @@
 #include "modularity/imoduleexport.h"
 #include "io/path.h"
 #include "types/retval.h"
+#include "types/bytearray.h"
 #include "projecttypes.h"
 
 namespace mu::project {
@@ -38,6 +39,10 @@ public:
     virtual ~IMscMetaReader() = default;
 
     virtual RetVal<ProjectMeta> readMeta(const io::path_t& filePath) const = 0;
+
+    //! NOTE The thumbnail is not decoded (QPixmap can be used only in the main thread),
+    //! the PNG data is returned as is, so this can be called from any thread
+    virtual RetVal<ProjectMeta> readMeta(const io::path_t& filePath, ByteArray& thumbnailData) const = 0;
 };
 }
 
@@ -37,6 +37,23 @@ using namespace mu::framework;
 using namespace mu::engraving;
 
 mu::RetVal<ProjectMeta> MscMetaReader::readMeta(const io::path_t& filePath) const
+{
+    ByteArray thumbnailData;
+    RetVal<ProjectMeta> meta = readMeta(filePath, thumbnailData);
+    if (!meta.ret) {
+        return meta;
+    }
+
+    if (thumbnailData.empty()) {
+        LOGD() << "Can't find thumbnail";
+    } else {
+        meta.val.thumbnail.loadFromData(thumbnailData.toQByteArrayNoCopy(), "PNG");
+    }
+
+    return meta;
+}
+
+mu::RetVal<ProjectMeta> MscMetaReader::readMeta(const io::path_t& filePath, ByteArray& thumbnailData) const
 {
     RetVal<ProjectMeta> meta;
 
@@ -63,13 +80,8 @@ mu::RetVal<ProjectMeta> MscMetaReader::readMeta(const io::path_t& filePath) cons
     framework::XmlReader xmlReader(scoreData.toQByteArray());
     doReadMeta(xmlReader, meta.val);
 
-    // Read thumbnail
-    ByteArray thumbnailData = msczReader.readThumbnailFile();
-    if (thumbnailData.empty()) {
-        LOGD() << "Can't find thumbnail";
-    } else {
-        meta.val.thumbnail.loadFromData(thumbnailData.toQByteArray(), "PNG");
-    }
+    // Read thumbnail, it is decoded by the caller
+    thumbnailData = msczReader.readThumbnailFile();
 
     meta.val.filePath = filePath;
 
@@ -196,7 +208,10 @@ MscMetaReader::RawMeta MscMetaReader::doReadRawMeta(framework::XmlReader& xmlRea
             }
         } else if (tag == "Part") {
             meta.partsCount++;
-            xmlReader.skipCurrentElement();
+            QString trackName = readPartTrackName(xmlReader);
+            if (!trackName.isEmpty()) {
+                meta.instruments << trackName;
+            }
         } else {
             xmlReader.skipCurrentElement();
         }
@@ -266,6 +281,7 @@ void MscMetaReader::doReadMeta(framework::XmlReader& xmlReader, ProjectMeta& met
     meta.translator = simplified(rawMeta.translator);
     meta.arranger = simplified(rawMeta.arranger);
     meta.partsCount = rawMeta.partsCount;
+    meta.instruments = rawMeta.instruments;
     meta.creationDate = QDate::fromString(rawMeta.creationDate, "yyyy-MM-dd");
 }
 
@@ -327,6 +343,20 @@ QString MscMetaReader::readText(mu::framework::XmlReader& xmlReader) const
     return formatFromXml(str);
 }
 
+QString MscMetaReader::readPartTrackName(mu::framework::XmlReader& xmlReader) const
+{
+    QString trackName;
+    while (xmlReader.readNextStartElement()) {
+        if (xmlReader.tagName() == "trackName") {
+            trackName = simplified(xmlReader.readString());
+        } else {
+            xmlReader.skipCurrentElement();
+        }
+    }
+
+    return trackName;
+}
+
 QString MscMetaReader::readMetaTagText(mu::framework::XmlReader& xmlReader) const
 {
     return QString::fromStdString(xmlReader.readString());
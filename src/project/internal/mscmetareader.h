@@ -37,7 +37,8 @@ class MscMetaReader : public IMscMetaReader
     INJECT(project, io::IFileSystem, fileSystem)
 
 public:
-    RetVal<ProjectMeta> readMeta(const io::path_t& filePath) const;
+    RetVal<ProjectMeta> readMeta(const io::path_t& filePath) const override;
+    RetVal<ProjectMeta> readMeta(const io::path_t& filePath, ByteArray& thumbnailData) const override;
 
 private:
 
@@ -65,6 +66,7 @@ private:
         QString creationDate;
 
         size_t partsCount = 0;
+        QStringList instruments;
     };
 
     void doReadMeta(framework::XmlReader& xmlReader, ProjectMeta& meta) const;
@@ -78,6 +80,7 @@ private:
     std::string cutXmlTags(const std::string& str) const;
 
     QString readText(framework::XmlReader& xmlReader) const;
+    QString readPartTrackName(framework::XmlReader& xmlReader) const;
     QString readMetaTagText(framework::XmlReader& xmlReader) const;
 };
 }
@@ -42,6 +42,7 @@
 #include "libmscore/undo.h"
 
 #include "defer.h"
+#include "memoryaccounting.h"
 #include "log.h"
 
 using namespace mu;
@@ -137,6 +138,7 @@ void NotationProject::setupProject()
 mu::Ret NotationProject::load(const io::path_t& path, const io::path_t& stylePath, bool forceMode, const std::string& format)
 {
     TRACEFUNC;
+    MEMORY_TAG_SCOPE(Import);
 
     LOGD() << "try load: " << path;
 
@@ -664,6 +664,11 @@ io::path_t ProjectConfiguration::projectBackupPath(const io::path_t& projectPath
     return projectDir + "/.mscbackup/." + projectName + "~";
 }
 
+io::path_t ProjectConfiguration::projectMetaIndexPath() const
+{
+    return globalConfiguration()->userAppDataPath() + "/project_meta_index";
+}
+
 bool ProjectConfiguration::showCloudIsNotAvailableWarning() const
 {
     return settings()->value(SHOW_CLOUD_IS_NOT_AVAILABLE_WARNING).toBool();
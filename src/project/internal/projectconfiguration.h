@@ -133,6 +133,8 @@ public:
 
     io::path_t projectBackupPath(const io::path_t& projectPath) const override;
 
+    io::path_t projectMetaIndexPath() const override;
+
     bool showCloudIsNotAvailableWarning() const override;
     void setShowCloudIsNotAvailableWarning(bool show) override;
 
@@ -0,0 +1,417 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "projectmetaindex.h"
+
+#include <set>
+
+#include <QCryptographicHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "async/async.h"
+#include "concurrency/taskscheduler.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::project;
+
+static constexpr int INDEX_VERSION = 1;
+
+static QJsonObject metaToJson(const ProjectMeta& meta)
+{
+    QJsonObject obj;
+    obj["title"] = meta.title;
+    obj["subtitle"] = meta.subtitle;
+    obj["composer"] = meta.composer;
+    obj["lyricist"] = meta.lyricist;
+    obj["copyright"] = meta.copyright;
+    obj["translator"] = meta.translator;
+    obj["arranger"] = meta.arranger;
+    obj["partsCount"] = static_cast<int>(meta.partsCount);
+    obj["instruments"] = QJsonArray::fromStringList(meta.instruments);
+    obj["creationDate"] = meta.creationDate.toString(Qt::ISODate);
+    return obj;
+}
+
+static ProjectMeta metaFromJson(const QJsonObject& obj)
+{
+    ProjectMeta meta;
+    meta.title = obj["title"].toString();
+    meta.subtitle = obj["subtitle"].toString();
+    meta.composer = obj["composer"].toString();
+    meta.lyricist = obj["lyricist"].toString();
+    meta.copyright = obj["copyright"].toString();
+    meta.translator = obj["translator"].toString();
+    meta.arranger = obj["arranger"].toString();
+    meta.partsCount = static_cast<size_t>(obj["partsCount"].toInt());
+    for (const QJsonValue& val : obj["instruments"].toArray()) {
+        meta.instruments << val.toString();
+    }
+    meta.creationDate = QDate::fromString(obj["creationDate"].toString(), Qt::ISODate);
+    return meta;
+}
+
+void ProjectMetaIndex::init()
+{
+    m_mainThreadId = std::this_thread::get_id();
+
+    //! NOTE The services are used from the scan threads, so they are resolved here, on the main thread
+    configuration();
+    mscMetaReader();
+    fileSystem();
+
+    fileSystem()->makePath(configuration()->projectMetaIndexPath() + "/thumbnails");
+    load();
+}
+
+void ProjectMetaIndex::deinit()
+{
+    m_aborted = true;
+
+    //! NOTE The scan tasks use the index, and the file being indexed must get into the saved index
+    {
+        std::unique_lock lock(m_runningScansMutex);
+        m_runningScansFinished.wait(lock, [this]() { return m_runningScans == 0; });
+    }
+
+    save();
+}
+
+RetVal<ProjectMeta> ProjectMetaIndex::meta(const io::path_t& filePath) const
+{
+    RetVal<ProjectMeta> rv = indexFile(filePath);
+    if (!rv.ret) {
+        return rv;
+    }
+
+    bool hasThumbnail = false;
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(filePath.toStdString());
+        hasThumbnail = it != m_entries.end() && it->second.hasThumbnail;
+    }
+
+    loadThumbnail(rv.val, hasThumbnail);
+    return rv;
+}
+
+RetVal<ProjectMeta> ProjectMetaIndex::indexFile(const io::path_t& filePath) const
+{
+    RetVal<uint64_t> size = fileSystem()->fileSize(filePath);
+    if (!size.ret) {
+        return RetVal<ProjectMeta>(size.ret);
+    }
+
+    DateTime lastModified = fileSystem()->lastModified(filePath);
+    std::string key = filePath.toStdString();
+
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end() && it->second.size == size.val && it->second.lastModified == lastModified) {
+            return RetVal<ProjectMeta>::make_ok(it->second.meta);
+        }
+    }
+
+    ByteArray thumbnailData;
+    RetVal<ProjectMeta> rv = mscMetaReader()->readMeta(filePath, thumbnailData);
+    if (!rv.ret) {
+        return rv;
+    }
+
+    bool hadThumbnail = false;
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(key);
+        hadThumbnail = it != m_entries.end() && it->second.hasThumbnail;
+    }
+
+    if (!thumbnailData.empty()) {
+        fileSystem()->writeFile(thumbnailPath(filePath), thumbnailData);
+    } else if (hadThumbnail) {
+        fileSystem()->remove(thumbnailPath(filePath));
+    }
+
+    Entry entry;
+    entry.lastModified = lastModified;
+    entry.size = size.val;
+    entry.meta = rv.val;
+    entry.hasThumbnail = !thumbnailData.empty();
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_entries[key] = std::move(entry);
+    }
+
+    m_changed = true;
+
+    return rv;
+}
+
+ProjectMetaList ProjectMetaIndex::metaList(const io::path_t& dirPath) const
+{
+    std::string prefix = dirPath.toStdString();
+    if (!prefix.empty() && prefix.back() != '/') {
+        prefix += '/';
+    }
+
+    std::vector<std::pair<ProjectMeta, bool> > found;
+    {
+        std::lock_guard lock(m_mutex);
+        for (auto it = m_entries.lower_bound(prefix); it != m_entries.end(); ++it) {
+            if (it->first.compare(0, prefix.size(), prefix) != 0) {
+                break;
+            }
+            found.push_back({ it->second.meta, it->second.hasThumbnail });
+        }
+    }
+
+    ProjectMetaList result;
+    result.reserve(static_cast<int>(found.size()));
+    for (auto& [meta, hasThumbnail] : found) {
+        loadThumbnail(meta, hasThumbnail);
+        result.push_back(std::move(meta));
+    }
+
+    return result;
+}
+
+ProjectMetaList ProjectMetaIndex::find(const QString& text) const
+{
+    auto matches = [&text](const ProjectMeta& meta) {
+        return meta.title.contains(text, Qt::CaseInsensitive)
+               || meta.subtitle.contains(text, Qt::CaseInsensitive)
+               || meta.composer.contains(text, Qt::CaseInsensitive)
+               || meta.lyricist.contains(text, Qt::CaseInsensitive)
+               || meta.arranger.contains(text, Qt::CaseInsensitive)
+               || meta.instruments.contains(text, Qt::CaseInsensitive);
+    };
+
+    std::vector<std::pair<ProjectMeta, bool> > found;
+    {
+        std::lock_guard lock(m_mutex);
+        for (const auto& [path, entry] : m_entries) {
+            if (matches(entry.meta)) {
+                found.push_back({ entry.meta, entry.hasThumbnail });
+            }
+        }
+    }
+
+    ProjectMetaList result;
+    result.reserve(static_cast<int>(found.size()));
+    for (auto& [meta, hasThumbnail] : found) {
+        loadThumbnail(meta, hasThumbnail);
+        result.push_back(std::move(meta));
+    }
+
+    return result;
+}
+
+void ProjectMetaIndex::scan(const io::paths_t& dirPaths)
+{
+    if (m_aborted) {
+        return;
+    }
+
+    for (const io::path_t& dirPath : dirPaths) {
+        m_scansInProgress++;
+        {
+            std::lock_guard lock(m_runningScansMutex);
+            m_runningScans++;
+        }
+
+        TaskScheduler::instance()->push([this, dirPath]() {
+            if (!m_aborted) {
+                scanDir(dirPath);
+            }
+
+            async::Async::call(this, [this]() {
+                m_scansInProgress--;
+                if (m_changed) {
+                    save();
+                    m_indexChanged.notify();
+                }
+            }, m_mainThreadId);
+
+            //! NOTE Notified under the lock, as the index can be destroyed right after the wait in deinit()
+            std::lock_guard lock(m_runningScansMutex);
+            m_runningScans--;
+            m_runningScansFinished.notify_all();
+        });
+    }
+}
+
+void ProjectMetaIndex::scanDir(const io::path_t& dirPath)
+{
+    TRACEFUNC;
+
+    RetVal<io::paths_t> files = fileSystem()->scanFiles(dirPath, { "*.mscz", "*.mscx" });
+    if (!files.ret) {
+        LOGE() << "failed scan dir: " << dirPath << ", err: " << files.ret.toString();
+        return;
+    }
+
+    std::set<std::string> existing;
+    for (const io::path_t& file : files.val) {
+        if (m_aborted) {
+            return;
+        }
+
+        existing.insert(file.toStdString());
+
+        RetVal<ProjectMeta> rv = indexFile(file);
+        if (!rv.ret) {
+            LOGW() << "failed index file: " << file << ", err: " << rv.ret.toString();
+        }
+    }
+
+    //! NOTE Remove the entries of deleted files together with their thumbnails
+    std::string prefix = dirPath.toStdString() + "/";
+    std::vector<io::path_t> removedThumbnails;
+    {
+        std::lock_guard lock(m_mutex);
+        for (auto it = m_entries.lower_bound(prefix); it != m_entries.end();) {
+            if (it->first.compare(0, prefix.size(), prefix) != 0) {
+                break;
+            }
+
+            if (existing.find(it->first) == existing.end()) {
+                if (it->second.hasThumbnail) {
+                    removedThumbnails.push_back(thumbnailPath(io::path_t(it->first)));
+                }
+                it = m_entries.erase(it);
+                m_changed = true;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for (const io::path_t& path : removedThumbnails) {
+        fileSystem()->remove(path);
+    }
+}
+
+bool ProjectMetaIndex::isScanning() const
+{
+    return m_scansInProgress > 0;
+}
+
+async::Notification ProjectMetaIndex::indexChanged() const
+{
+    return m_indexChanged;
+}
+
+void ProjectMetaIndex::loadThumbnail(ProjectMeta& meta, bool hasThumbnail) const
+{
+    if (!hasThumbnail) {
+        return;
+    }
+
+    RetVal<ByteArray> data = fileSystem()->readFile(thumbnailPath(meta.filePath));
+    if (data.ret) {
+        meta.thumbnail.loadFromData(data.val.toQByteArrayNoCopy(), "PNG");
+    }
+}
+
+io::path_t ProjectMetaIndex::indexFilePath() const
+{
+    return configuration()->projectMetaIndexPath() + "/index.json";
+}
+
+io::path_t ProjectMetaIndex::thumbnailPath(const io::path_t& filePath) const
+{
+    QByteArray hash = QCryptographicHash::hash(filePath.toQString().toUtf8(), QCryptographicHash::Md5).toHex();
+    return configuration()->projectMetaIndexPath() + "/thumbnails/" + hash.constData() + ".png";
+}
+
+void ProjectMetaIndex::load()
+{
+    TRACEFUNC;
+
+    io::path_t path = indexFilePath();
+    if (!fileSystem()->exists(path)) {
+        return;
+    }
+
+    RetVal<ByteArray> data = fileSystem()->readFile(path);
+    if (!data.ret) {
+        LOGE() << "failed read index: " << path << ", err: " << data.ret.toString();
+        return;
+    }
+
+    QJsonObject root = QJsonDocument::fromJson(data.val.toQByteArrayNoCopy()).object();
+    if (root["version"].toInt() != INDEX_VERSION) {
+        return;
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_entries.clear();
+    for (const QJsonValue& val : root["entries"].toArray()) {
+        QJsonObject obj = val.toObject();
+
+        Entry entry;
+        entry.lastModified = DateTime::fromStringISOFormat(obj["lastModified"].toString());
+        entry.size = static_cast<uint64_t>(obj["size"].toDouble());
+        entry.meta = metaFromJson(obj["meta"].toObject());
+        entry.meta.filePath = obj["path"].toString();
+        entry.hasThumbnail = obj["hasThumbnail"].toBool();
+
+        m_entries[entry.meta.filePath.toStdString()] = std::move(entry);
+    }
+}
+
+void ProjectMetaIndex::save()
+{
+    if (!m_changed) {
+        return;
+    }
+
+    TRACEFUNC;
+
+    QJsonArray entries;
+    {
+        std::lock_guard lock(m_mutex);
+        for (const auto& [path, entry] : m_entries) {
+            QJsonObject obj;
+            obj["path"] = QString::fromStdString(path);
+            obj["lastModified"] = entry.lastModified.toString().toQString();
+            obj["size"] = static_cast<double>(entry.size);
+            obj["hasThumbnail"] = entry.hasThumbnail;
+            obj["meta"] = metaToJson(entry.meta);
+            entries.append(obj);
+        }
+        m_changed = false;
+    }
+
+    QJsonObject root;
+    root["version"] = INDEX_VERSION;
+    root["entries"] = entries;
+
+    QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Compact);
+    Ret ret = fileSystem()->writeFile(indexFilePath(), ByteArray::fromQByteArrayNoCopy(json));
+    if (!ret) {
+        LOGE() << "failed write index, err: " << ret.toString();
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_PROJECT_PROJECTMETAINDEX_H
+#define MU_PROJECT_PROJECTMETAINDEX_H
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "iprojectmetaindex.h"
+
+#include "modularity/ioc.h"
+#include "async/asyncable.h"
+#include "io/ifilesystem.h"
+#include "iprojectconfiguration.h"
+#include "imscmetareader.h"
+
+namespace mu::project {
+class ProjectMetaIndex : public IProjectMetaIndex, public async::Asyncable
+{
+    INJECT(project, IProjectConfiguration, configuration)
+    INJECT(project, IMscMetaReader, mscMetaReader)
+    INJECT(project, io::IFileSystem, fileSystem)
+
+public:
+    void init();
+    void deinit();
+
+    RetVal<ProjectMeta> meta(const io::path_t& filePath) const override;
+
+    ProjectMetaList metaList(const io::path_t& dirPath) const override;
+    ProjectMetaList find(const QString& text) const override;
+
+    void scan(const io::paths_t& dirPaths) override;
+    bool isScanning() const override;
+    async::Notification indexChanged() const override;
+
+private:
+
+    struct Entry {
+        DateTime lastModified;
+        uint64_t size = 0;
+        ProjectMeta meta; // without thumbnail
+        bool hasThumbnail = false;
+    };
+
+    //! NOTE Can be called from any thread
+    RetVal<ProjectMeta> indexFile(const io::path_t& filePath) const;
+    void scanDir(const io::path_t& dirPath);
+
+    void loadThumbnail(ProjectMeta& meta, bool hasThumbnail) const;
+    io::path_t indexFilePath() const;
+    io::path_t thumbnailPath(const io::path_t& filePath) const;
+
+    void load();
+    void save();
+
+    mutable std::mutex m_mutex;
+    mutable std::map<std::string, Entry> m_entries;
+    mutable std::atomic<bool> m_changed = false;
+
+    std::atomic<int> m_scansInProgress = 0; // until the result is applied on the main thread
+    std::atomic<bool> m_aborted = false;
+
+    std::mutex m_runningScansMutex;
+    std::condition_variable m_runningScansFinished;
+    int m_runningScans = 0; // until the scan task is finished
+    std::thread::id m_mainThreadId;
+    async::Notification m_indexChanged;
+};
+}
+
+#endif // MU_PROJECT_PROJECTMETAINDEX_H
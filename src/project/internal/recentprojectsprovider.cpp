@@ -45,7 +45,7 @@ ProjectMetaList RecentProjectsProvider::recentProjectList() const
         for (const io::path_t& path : paths) {
             ProjectMeta meta;
             if (engraving::isMuseScoreFile(io::suffix(path))) {
-                RetVal<ProjectMeta> rv = mscMetaReader()->readMeta(path);
+                RetVal<ProjectMeta> rv = metaIndex()->meta(path);
                 if (!rv.ret) {
                     LOGE() << "failed read meta, path: " << path;
                     continue;
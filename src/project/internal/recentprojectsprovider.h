@@ -26,13 +26,13 @@
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
 #include "iprojectconfiguration.h"
-#include "imscmetareader.h"
+#include "iprojectmetaindex.h"
 
 namespace mu::project {
 class RecentProjectsProvider : public IRecentProjectsProvider, public async::Asyncable
 {
     INJECT(project, IProjectConfiguration, configuration)
-    INJECT(project, IMscMetaReader, mscMetaReader)
+    INJECT(project, IProjectMetaIndex, metaIndex)
 
 public:
     void init();
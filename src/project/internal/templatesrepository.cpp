@@ -96,7 +96,7 @@ Templates TemplatesRepository::readTemplates(const io::paths_t& files, const QSt
 
     for (const io::path_t& file : files) {
         io::path_t path = dirPath.empty() ? file : dirPath + "/" + file;
-        RetVal<ProjectMeta> meta = mscReader()->readMeta(path);
+        RetVal<ProjectMeta> meta = metaIndex()->meta(path);
         if (!meta.ret) {
             LOGE() << QString("failed read template %1: %2")
                 .arg(path.toQString())
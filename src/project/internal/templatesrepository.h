@@ -27,14 +27,14 @@
 
 #include "itemplatesrepository.h"
 #include "project/iprojectconfiguration.h"
-#include "project/imscmetareader.h"
+#include "project/iprojectmetaindex.h"
 #include "io/ifilesystem.h"
 
 namespace mu::project {
 class TemplatesRepository : public ITemplatesRepository
 {
     INJECT(project, IProjectConfiguration, configuration)
-    INJECT(project, IMscMetaReader, mscReader)
+    INJECT(project, IProjectMetaIndex, metaIndex)
     INJECT(project, io::IFileSystem, fileSystem)
 
 public:
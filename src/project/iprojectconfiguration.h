@@ -132,6 +132,8 @@ public:
 
     virtual io::path_t projectBackupPath(const io::path_t& projectPath) const = 0;
 
+    virtual io::path_t projectMetaIndexPath() const = 0;
+
     virtual bool showCloudIsNotAvailableWarning() const = 0;
     virtual void setShowCloudIsNotAvailableWarning(bool show) = 0;
 };
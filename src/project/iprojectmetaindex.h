@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_PROJECT_IPROJECTMETAINDEX_H
+#define MU_PROJECT_IPROJECTMETAINDEX_H
+
+#include "modularity/imoduleexport.h"
+#include "io/path.h"
+#include "types/retval.h"
+#include "async/notification.h"
+#include "projecttypes.h"
+
+namespace mu::project {
+//! NOTE Persistent index of projects meta (tags, parts, instruments and thumbnail),
+//! keyed by the file path, modification time and size,
+//! so lists of projects can be shown without opening every file
+class IProjectMetaIndex : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IProjectMetaIndex)
+
+public:
+    virtual ~IProjectMetaIndex() = default;
+
+    //! NOTE Returns the indexed meta if the file was not changed since it was indexed,
+    //! otherwise reads the file and updates the index
+    virtual RetVal<ProjectMeta> meta(const io::path_t& filePath) const = 0;
+
+    //! NOTE Only indexed projects are returned, files are not read
+    virtual ProjectMetaList metaList(const io::path_t& dirPath) const = 0;
+    virtual ProjectMetaList find(const QString& text) const = 0;
+
+    //! NOTE Indexes new and changed projects in the dirs (and subdirs) in the background
+    virtual void scan(const io::paths_t& dirPaths) = 0;
+    virtual bool isScanning() const = 0;
+    virtual async::Notification indexChanged() const = 0;
+};
+}
+
+#endif // MU_PROJECT_IPROJECTMETAINDEX_H
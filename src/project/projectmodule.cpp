@@ -33,6 +33,7 @@
 #include "internal/exportprojectscenario.h"
 #include "internal/recentprojectsprovider.h"
 #include "internal/mscmetareader.h"
+#include "internal/projectmetaindex.h"
 #include "internal/templatesrepository.h"
 #include "internal/projectmigrator.h"
 #include "internal/projectautosaver.h"
@@ -70,6 +71,7 @@ static std::shared_ptr<ProjectConfiguration> s_configuration = std::make_shared<
 static std::shared_ptr<ProjectActionsController> s_actionsController = std::make_shared<ProjectActionsController>();
 static std::shared_ptr<RecentProjectsProvider> s_recentProjectsProvider = std::make_shared<RecentProjectsProvider>();
 static std::shared_ptr<ProjectAutoSaver> s_projectAutoSaver = std::make_shared<ProjectAutoSaver>();
+static std::shared_ptr<ProjectMetaIndex> s_projectMetaIndex = std::make_shared<ProjectMetaIndex>();
 
 static void project_init_qrc()
 {
@@ -90,6 +92,7 @@ void ProjectModule::registerExports()
     ioc()->registerExport<IExportProjectScenario>(moduleName(), new ExportProjectScenario());
     ioc()->registerExport<IRecentProjectsProvider>(moduleName(), s_recentProjectsProvider);
     ioc()->registerExport<IMscMetaReader>(moduleName(), new MscMetaReader());
+    ioc()->registerExport<IProjectMetaIndex>(moduleName(), s_projectMetaIndex);
     ioc()->registerExport<ITemplatesRepository>(moduleName(), new TemplatesRepository());
     ioc()->registerExport<IProjectMigrator>(moduleName(), new ProjectMigrator());
     ioc()->registerExport<IProjectAutoSaver>(moduleName(), s_projectAutoSaver);
@@ -170,7 +173,16 @@ void ProjectModule::onInit(const framework::IApplication::RunMode& mode)
     }
 
     s_configuration->init();
+    s_projectMetaIndex->init();
     s_actionsController->init();
     s_recentProjectsProvider->init();
     s_projectAutoSaver->init();
+
+    //! NOTE Keep the templates indexed, so the templates list is shown without reading every template
+    s_projectMetaIndex->scan(s_configuration->availableTemplateDirs());
+}
+
+void ProjectModule::onDeinit()
+{
+    s_projectMetaIndex->deinit();
 }
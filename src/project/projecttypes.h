@@ -25,6 +25,7 @@
 #include <variant>
 
 #include <QString>
+#include <QStringList>
 #include <QUrl>
 
 #include "io/path.h"
@@ -152,6 +153,7 @@ struct ProjectMeta
     QString translator;
     QString arranger;
     size_t partsCount = 0;
+    QStringList instruments;
     QPixmap thumbnail;
     QDate creationDate;
 
@@ -179,6 +181,7 @@ struct ProjectMeta
         equal &= translator == other.translator;
         equal &= arranger == other.arranger;
         equal &= partsCount == other.partsCount;
+        equal &= instruments == other.instruments;
         equal &= creationDate == other.creationDate;
         equal &= source == other.source;
         equal &= platform == other.platform;
@@ -0,0 +1,338 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2022 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <QCoreApplication>
+
+#include "project/internal/projectmetaindex.h"
+
+#include "mocks/projectconfigurationmock.h"
+#include "mocks/mscmetareadermock.h"
+#include "global/tests/mocks/filesystemmock.h"
+
+#include "async/processevents.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::project;
+using namespace mu::io;
+
+static const io::path_t INDEX_DIR("/index");
+static const io::path_t SCORES_DIR("/scores");
+
+//! NOTE Keeps the files in memory, the index can be used from the scan threads
+class Project_ProjectMetaIndexTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_configuration = std::make_shared<NiceMock<ProjectConfigurationMock> >();
+        m_fileSystem = std::make_shared<NiceMock<FileSystemMock> >();
+        m_metaReader = std::make_shared<NiceMock<MscMetaReaderMock> >();
+
+        ON_CALL(*m_configuration, projectMetaIndexPath()).WillByDefault(Return(INDEX_DIR));
+
+        ON_CALL(*m_fileSystem, exists(_)).WillByDefault(Invoke([this](const io::path_t& path) {
+            std::lock_guard lock(m_mutex);
+            return Ret(m_files.find(path.toStdString()) != m_files.end());
+        }));
+
+        ON_CALL(*m_fileSystem, fileSize(_)).WillByDefault(Invoke([this](const io::path_t& path) {
+            std::lock_guard lock(m_mutex);
+            auto it = m_files.find(path.toStdString());
+            if (it == m_files.end()) {
+                return RetVal<uint64_t>(make_ret(Ret::Code::UnknownError));
+            }
+            return RetVal<uint64_t>::make_ok(static_cast<uint64_t>(it->second.data.size()));
+        }));
+
+        ON_CALL(*m_fileSystem, lastModified(_)).WillByDefault(Invoke([this](const io::path_t& path) {
+            std::lock_guard lock(m_mutex);
+            auto it = m_files.find(path.toStdString());
+            return it != m_files.end() ? it->second.lastModified : DateTime();
+        }));
+
+        ON_CALL(*m_fileSystem, readFile(_)).WillByDefault(Invoke([this](const io::path_t& path) {
+            std::lock_guard lock(m_mutex);
+            auto it = m_files.find(path.toStdString());
+            if (it == m_files.end()) {
+                return RetVal<ByteArray>(make_ret(Ret::Code::UnknownError));
+            }
+            return RetVal<ByteArray>::make_ok(it->second.data);
+        }));
+
+        ON_CALL(*m_fileSystem, writeFile(_, _)).WillByDefault(Invoke([this](const io::path_t& path, const ByteArray& data) {
+            writeFile(path, data, DateTime::currentDateTime());
+            return make_ok();
+        }));
+
+        ON_CALL(*m_fileSystem, remove(_)).WillByDefault(Invoke([this](const io::path_t& path) {
+            std::lock_guard lock(m_mutex);
+            m_files.erase(path.toStdString());
+            return make_ok();
+        }));
+
+        ON_CALL(*m_fileSystem, scanFiles(_, _, _)).WillByDefault(Invoke([this](const io::path_t& dir, const std::vector<std::string>&,
+                                                                               ScanMode) {
+            std::lock_guard lock(m_mutex);
+            std::string prefix = dir.toStdString() + "/";
+            io::paths_t result;
+            for (const auto& [path, file] : m_files) {
+                if (path.compare(0, prefix.size(), prefix) == 0) {
+                    result.push_back(path);
+                }
+            }
+            return RetVal<io::paths_t>::make_ok(result);
+        }));
+
+        ON_CALL(*m_metaReader, readMeta(_, _)).WillByDefault(Invoke([this](const io::path_t& path, ByteArray& thumbnailData) {
+            ++m_readCount;
+
+            ProjectMeta meta;
+            meta.filePath = path;
+            {
+                std::lock_guard lock(m_mutex);
+                const ByteArray& data = m_files[path.toStdString()].data;
+                meta.title = QString::fromUtf8(data.constChar(), static_cast<int>(data.size()));
+            }
+            thumbnailData = ByteArray("PNG");
+            return RetVal<ProjectMeta>::make_ok(meta);
+        }));
+    }
+
+    std::shared_ptr<ProjectMetaIndex> makeIndex()
+    {
+        auto index = std::make_shared<ProjectMetaIndex>();
+        index->setconfiguration(m_configuration);
+        index->setfileSystem(m_fileSystem);
+        index->setmscMetaReader(m_metaReader);
+        index->init();
+        return index;
+    }
+
+    void writeFile(const io::path_t& path, const ByteArray& data, const DateTime& lastModified)
+    {
+        std::lock_guard lock(m_mutex);
+        m_files[path.toStdString()] = { data, lastModified };
+    }
+
+    void writeScore(const std::string& name, const std::string& title, int minute = 0)
+    {
+        writeFile(SCORES_DIR + "/" + name.c_str(), ByteArray(title.c_str()), DateTime(Date(2022, 1, 1), Time(12, minute, 0)));
+    }
+
+    bool fileExists(const io::path_t& path)
+    {
+        std::lock_guard lock(m_mutex);
+        return m_files.find(path.toStdString()) != m_files.end();
+    }
+
+    size_t thumbnailCount()
+    {
+        std::lock_guard lock(m_mutex);
+        std::string prefix = (INDEX_DIR + "/thumbnails/").toStdString();
+        size_t count = 0;
+        for (const auto& [path, file] : m_files) {
+            if (path.compare(0, prefix.size(), prefix) == 0) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    void scanAndWait(ProjectMetaIndex& index)
+    {
+        index.scan({ SCORES_DIR });
+
+        auto start = std::chrono::steady_clock::now();
+        while (index.isScanning() && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+            async::processEvents();
+            QCoreApplication::processEvents();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_FALSE(index.isScanning());
+    }
+
+    struct File {
+        ByteArray data;
+        DateTime lastModified;
+    };
+
+    std::shared_ptr<ProjectConfigurationMock> m_configuration;
+    std::shared_ptr<FileSystemMock> m_fileSystem;
+    std::shared_ptr<MscMetaReaderMock> m_metaReader;
+
+    std::mutex m_mutex;
+    std::map<std::string, File> m_files;
+    std::atomic<int> m_readCount = 0;
+};
+
+TEST_F(Project_ProjectMetaIndexTest, MetaIsCached)
+{
+    //! [GIVEN] Score that was not indexed yet
+    writeScore("a.mscz", "A");
+    std::shared_ptr<ProjectMetaIndex> index = makeIndex();
+
+    //! [WHEN] Request its meta
+    RetVal<ProjectMeta> meta = index->meta(SCORES_DIR + "/a.mscz");
+
+    //! [THEN] The meta is read from the file
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title, "A");
+    EXPECT_EQ(m_readCount.load(), 1);
+
+    //! [WHEN] Request it again
+    meta = index->meta(SCORES_DIR + "/a.mscz");
+
+    //! [THEN] The cached meta is returned, the file is not read again
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title, "A");
+    EXPECT_EQ(m_readCount.load(), 1);
+
+    //! [WHEN] Request the meta of a file which doesn't exist
+    meta = index->meta(SCORES_DIR + "/missing.mscz");
+
+    //! [THEN] An error is returned
+    EXPECT_FALSE(meta.ret);
+}
+
+TEST_F(Project_ProjectMetaIndexTest, StaleEntryIsReread)
+{
+    //! [GIVEN] Indexed score
+    writeScore("a.mscz", "A");
+    std::shared_ptr<ProjectMetaIndex> index = makeIndex();
+    ASSERT_TRUE(index->meta(SCORES_DIR + "/a.mscz").ret);
+    ASSERT_EQ(m_readCount.load(), 1);
+
+    //! [WHEN] The score is modified, the size stays the same
+    writeScore("a.mscz", "B", 1);
+
+    //! [THEN] The meta is read again
+    RetVal<ProjectMeta> meta = index->meta(SCORES_DIR + "/a.mscz");
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title, "B");
+    EXPECT_EQ(m_readCount.load(), 2);
+}
+
+TEST_F(Project_ProjectMetaIndexTest, DeletedFilesArePruned)
+{
+    //! [GIVEN] Indexed directory with two scores
+    writeScore("a.mscz", "A");
+    writeScore("b.mscz", "B");
+    std::shared_ptr<ProjectMetaIndex> index = makeIndex();
+    scanAndWait(*index);
+
+    ASSERT_EQ(index->metaList(SCORES_DIR).size(), 2);
+    ASSERT_EQ(thumbnailCount(), 2);
+
+    //! [WHEN] One score is deleted and the directory is scanned again
+    {
+        std::lock_guard lock(m_mutex);
+        m_files.erase((SCORES_DIR + "/b.mscz").toStdString());
+    }
+    scanAndWait(*index);
+
+    //! [THEN] Its entry and its thumbnail are removed
+    ProjectMetaList list = index->metaList(SCORES_DIR);
+    ASSERT_EQ(list.size(), 1);
+    EXPECT_EQ(list.front().title, "A");
+    EXPECT_EQ(thumbnailCount(), 1);
+    EXPECT_TRUE(index->find("B").isEmpty());
+}
+
+TEST_F(Project_ProjectMetaIndexTest, IndexIsPersistent)
+{
+    //! [GIVEN] Indexed directory
+    writeScore("a.mscz", "A");
+    writeScore("b.mscz", "B");
+    {
+        std::shared_ptr<ProjectMetaIndex> index = makeIndex();
+        scanAndWait(*index);
+        index->deinit();
+    }
+    ASSERT_EQ(m_readCount.load(), 2);
+    ASSERT_TRUE(fileExists(INDEX_DIR + "/index.json"));
+
+    //! [WHEN] The index is loaded again
+    std::shared_ptr<ProjectMetaIndex> index = makeIndex();
+
+    //! [THEN] The entries are available without reading the scores
+    ProjectMetaList list = index->metaList(SCORES_DIR);
+    ASSERT_EQ(list.size(), 2);
+    EXPECT_EQ(index->find("A").size(), 1);
+
+    RetVal<ProjectMeta> meta = index->meta(SCORES_DIR + "/b.mscz");
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title, "B");
+    EXPECT_EQ(m_readCount.load(), 2);
+}
+
+TEST_F(Project_ProjectMetaIndexTest, DeinitWaitsForRunningScan)
+{
+    //! [GIVEN] Reading a score takes some time
+    writeScore("a.mscz", "A");
+    writeScore("b.mscz", "B");
+
+    std::atomic<bool> readStarted = false;
+    ON_CALL(*m_metaReader, readMeta(_, _)).WillByDefault(Invoke([this, &readStarted](const io::path_t& path, ByteArray&) {
+        ++m_readCount;
+        readStarted = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        ProjectMeta meta;
+        meta.filePath = path;
+        meta.title = path.toQString();
+        return RetVal<ProjectMeta>::make_ok(meta);
+    }));
+
+    {
+        std::shared_ptr<ProjectMetaIndex> index = makeIndex();
+        index->scan({ SCORES_DIR });
+
+        auto start = std::chrono::steady_clock::now();
+        while (!readStarted && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_TRUE(readStarted);
+
+        //! [WHEN] The index is deinited while the first score is being read
+        index->deinit();
+    }
+
+    //! [THEN] The scan was aborted after the score being read
+    EXPECT_EQ(m_readCount.load(), 1);
+
+    //! [THEN] And this score got into the saved index
+    std::shared_ptr<ProjectMetaIndex> index = makeIndex();
+    EXPECT_EQ(index->metaList(SCORES_DIR).size(), 1);
+}
@@ -24,8 +24,8 @@
 
 #include "project/internal/templatesrepository.h"
 
-#include "notation/tests/mocks/msczreadermock.h"
 #include "mocks/projectconfigurationmock.h"
+#include "mocks/projectmetaindexmock.h"
 #include "global/tests/mocks/filesystemmock.h"
 
 #include <QJsonDocument>
@@ -36,7 +36,6 @@ using ::testing::Return;
 
 using namespace mu;
 using namespace mu::project;
-using namespace mu::notation;
 using namespace mu::io;
 
 class Project_TemplatesRepositoryTest : public ::testing::Test
@@ -45,12 +44,12 @@ protected:
     void SetUp() override
     {
         m_repository = std::make_shared<TemplatesRepository>();
-        m_msczReader = std::make_shared<MsczReaderMock>();
+        m_metaIndex = std::make_shared<ProjectMetaIndexMock>();
         m_fileSystem = std::make_shared<FileSystemMock>();
         m_configuration = std::make_shared<ProjectConfigurationMock>();
 
         m_repository->setconfiguration(m_configuration);
-        m_repository->setmscReader(m_msczReader);
+        m_repository->setmetaIndex(m_metaIndex);
         m_repository->setfileSystem(m_fileSystem);
     }
 
@@ -84,7 +83,7 @@ protected:
 
     std::shared_ptr<TemplatesRepository> m_repository;
     std::shared_ptr<ProjectConfigurationMock> m_configuration;
-    std::shared_ptr<MsczReaderMock> m_msczReader;
+    std::shared_ptr<ProjectMetaIndexMock> m_metaIndex;
     std::shared_ptr<FileSystemMock> m_fileSystem;
 };
 
@@ -175,7 +174,7 @@ TEST_F(Project_TemplatesRepositoryTest, Templates)
     }
 
     for (const Template& templ : expectedTemplates) {
-        ON_CALL(*m_msczReader, readMeta(templ.meta.filePath))
+        ON_CALL(*m_metaIndex, meta(templ.meta.filePath))
         .WillByDefault(Return(RetVal<ProjectMeta>::make_ok(templ.meta)));
     }
 
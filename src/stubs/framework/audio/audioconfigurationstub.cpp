@@ -114,6 +114,29 @@ async::Channel<io::paths_t> AudioConfigurationStub::soundFontDirectoriesChanged(
     return async::Channel<io::paths_t>();
 }
 
+int AudioConfigurationStub::synthPolyphonyBudget() const
+{
+    return 0;
+}
+
+void AudioConfigurationStub::setSynthPolyphonyBudget(int)
+{
+}
+
+int AudioConfigurationStub::synthRenderThreadsPerTrack() const
+{
+    return 1;
+}
+
+void AudioConfigurationStub::setSynthRenderThreadsPerTrack(int)
+{
+}
+
+async::Notification AudioConfigurationStub::synthRenderingSettingsChanged() const
+{
+    return async::Notification();
+}
+
 // synthesizers
 const synth::SynthesizerState& AudioConfigurationStub::synthesizerState() const
 {
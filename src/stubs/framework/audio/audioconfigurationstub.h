@@ -55,6 +55,12 @@ public:
     void setUserSoundFontDirectories(const io::paths_t& paths) override;
     async::Channel<io::paths_t> soundFontDirectoriesChanged() const override;
 
+    int synthPolyphonyBudget() const override;
+    void setSynthPolyphonyBudget(int voices) override;
+    int synthRenderThreadsPerTrack() const override;
+    void setSynthRenderThreadsPerTrack(int threads) override;
+    async::Notification synthRenderingSettingsChanged() const override;
+
     const synth::SynthesizerState& synthesizerState() const override;
     Ret saveSynthesizerState(const synth::SynthesizerState& state) override;
     async::Notification synthesizerStateChanged() const override;
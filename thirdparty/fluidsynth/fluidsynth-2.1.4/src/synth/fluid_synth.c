@@ -3269,6 +3269,39 @@ fluid_synth_update_polyphony_LOCAL(fluid_synth_t *synth, int new_polyphony)
     return FLUID_OK;
 }
 
+/**
+ * Set the number of voice slots that new notes may use, without turning off
+ * the playing voices and without allocating memory (MuseScore patch).
+ * @param synth FluidSynth instance
+ * @param polyphony Wanted polyphony, at most the polyphony the synth was created with
+ * @return The applied polyphony, which stays above the last slot with a playing voice
+ *
+ * Unlike fluid_synth_set_polyphony(), this is safe to call while rendering:
+ * the voices and the mixer keep the size they were created with.
+ */
+int
+fluid_synth_limit_polyphony(fluid_synth_t *synth, int polyphony)
+{
+    int i;
+    fluid_return_val_if_fail(synth != NULL, FLUID_FAILED);
+    fluid_synth_api_enter(synth);
+
+    polyphony = (polyphony < 1) ? 1 : (polyphony > synth->nvoice) ? synth->nvoice : polyphony;
+
+    for(i = synth->polyphony - 1; i >= polyphony; i--)
+    {
+        if(fluid_voice_is_playing(synth->voice[i]))
+        {
+            polyphony = i + 1;
+            break;
+        }
+    }
+
+    synth->polyphony = polyphony;
+
+    FLUID_API_RETURN(polyphony);
+}
+
 /**
  * Get current synthesizer polyphony (max number of voices).
  * @param synth FluidSynth instance
@@ -4378,6 +4411,11 @@ fluid_synth_free_voice_by_kill_LOCAL(fluid_synth_t *synth)
               fluid_voice_get_id(voice), best_voice_index, fluid_voice_get_channel(voice), fluid_voice_get_key(voice));
     fluid_voice_off(voice);
 
+    /* The killed rvoice is finished as the overflow rvoice of the reused voice,
+     * which doesn't stop the voice, so it is stopped here. Otherwise it stays
+     * in the active voice count and keeps its sample referenced */
+    fluid_voice_stop(voice);
+
     return voice;
 }
 